@@ -9,13 +9,17 @@
  * does it submit to any jurisdiction.
  */
 
+#include <pybind11/numpy.h>
 #include <pybind11/pybind11.h>
 #include <pybind11/stl.h>
 #include <cstdlib>
 #include <string>
+#include <vector>
 
 #include "eckit/runtime/Main.h"
 
+#include "atlas/field/Field.h"
+
 #include "nwp_emulator_core.h"
 
 namespace py = pybind11;
@@ -27,6 +31,26 @@ namespace py = pybind11;
 
 namespace nwp_emulator {
 
+namespace {
+
+// Read-only NumPy array over emulator memory (buffer shared, not copied). The base of the array is a capsule holding
+// the field owning the memory, so the array stays valid after the core is finalised or set up again.
+template <typename T>
+py::array readOnlyArray(const NWPArrayView<T>& view) {
+    std::vector<py::ssize_t> shape{static_cast<py::ssize_t>(view.size)};
+    std::vector<py::ssize_t> strides{static_cast<py::ssize_t>(view.stride * sizeof(T))};
+    if (view.components > 1) {
+        shape.push_back(static_cast<py::ssize_t>(view.components));
+        strides.push_back(static_cast<py::ssize_t>(view.componentStride * sizeof(T)));
+    }
+    py::capsule owner(new atlas::Field(view.field), [](void* field) { delete static_cast<atlas::Field*>(field); });
+    py::array array(py::dtype::of<T>(), shape, strides, view.data, owner);
+    array.attr("setflags")(py::arg("write") = false);
+    return array;
+}
+
+}  // namespace
+
 PYBIND11_MODULE(NWP_EMULATOR_BINDINGS_MODULE_NAME, m) {
     m.doc() = "Native pybind11 bindings for the NWP emulator core (thin layer — no business logic).";
 
@@ -119,6 +143,20 @@ PYBIND11_MODULE(NWP_EMULATOR_BINDINGS_MODULE_NAME, m) {
         .def("current_step",              &NWPEmulatorCore::currentStep)
         .def("available_field_keys",      &NWPEmulatorCore::availableFieldKeys)
         .def("get_field_overlay_snapshot",&NWPEmulatorCore::getFieldOverlaySnapshot, py::arg("field_key"))
+        // Zero-copy views: the arrays share the rank-local emulator memory and keep the fields holding it alive.
+        .def("get_field_values_view", [](const NWPEmulatorCore& core, const std::string& fieldKey) {
+            return readOnlyArray(core.getFieldValuesView(fieldKey));
+        }, py::arg("field_key"))
+        .def("get_field_values_views", [](const NWPEmulatorCore& core, const std::vector<std::string>& fieldKeys) {
+            py::list views;
+            for (const auto& fieldKey : fieldKeys) {
+                views.append(readOnlyArray(core.getFieldValuesView(fieldKey)));
+            }
+            return views;
+        }, py::arg("field_keys"))
+        .def("get_lonlat_view", [](const NWPEmulatorCore& core) {
+            return readOnlyArray(core.getLonLatView());
+        })
         .def("execute",                   &NWPEmulatorCore::execute,                 py::arg("options"));
 }
 
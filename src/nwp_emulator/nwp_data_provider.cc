@@ -210,16 +210,10 @@ std::vector<std::string> NWPDataProvider::getFieldKeys() const {
     return keys;
 }
 
-bool NWPDataProvider::extractFieldOverlay(const std::string& fieldKey,
-                                          std::vector<double>& lon,
-                                          std::vector<double>& lat,
-                                          std::vector<double>& values,
-                                          std::string& error) const {
-    lon.clear();
-    lat.clear();
-    values.clear();
-    error.clear();
-
+bool NWPDataProvider::findFieldLevel(const std::string& fieldKey,
+                                     atlas::Field& field,
+                                     int& levelIndex,
+                                     std::string& error) const {
     std::stringstream ss(fieldKey);
     std::string shortName;
     std::string levtype;
@@ -244,7 +238,6 @@ bool NWPDataProvider::extractFieldOverlay(const std::string& fieldKey,
         return false;
     }
 
-    atlas::Field field;
     try {
         field = modelFieldSet_.field(shortName);
     } catch (const std::exception&) {
@@ -252,7 +245,6 @@ bool NWPDataProvider::extractFieldOverlay(const std::string& fieldKey,
         return false;
     }
 
-    int levelIndex = 0;
     try {
         levelIndex = findLevelIndex(field, levtype, level);
     } catch (const std::exception& exc) {
@@ -264,6 +256,24 @@ bool NWPDataProvider::extractFieldOverlay(const std::string& fieldKey,
         error = "requested field level index out of range";
         return false;
     }
+    return true;
+}
+
+bool NWPDataProvider::extractFieldOverlay(const std::string& fieldKey,
+                                          std::vector<double>& lon,
+                                          std::vector<double>& lat,
+                                          std::vector<double>& values,
+                                          std::string& error) const {
+    lon.clear();
+    lat.clear();
+    values.clear();
+    error.clear();
+
+    atlas::Field field;
+    int levelIndex = 0;
+    if (!findFieldLevel(fieldKey, field, levelIndex, error)) {
+        return false;
+    }
 
     const atlas::Field lonlatField = fs_.lonlat();
     auto lonlatView = atlas::array::make_view<double, 2>(lonlatField);
@@ -282,4 +292,23 @@ bool NWPDataProvider::extractFieldOverlay(const std::string& fieldKey,
 
     return true;
 }
+
+bool NWPDataProvider::findFieldOverlayValues(const std::string& fieldKey,
+                                             atlas::Field& field,
+                                             const FIELD_TYPE_REAL*& values,
+                                             size_t& size,
+                                             size_t& stride,
+                                             std::string& error) const {
+    error.clear();
+
+    int levelIndex = 0;
+    if (!findFieldLevel(fieldKey, field, levelIndex, error)) {
+        return false;
+    }
+
+    values = field.data<FIELD_TYPE_REAL>() + static_cast<size_t>(levelIndex) * field.stride(1);
+    size   = static_cast<size_t>(field.shape(0));
+    stride = static_cast<size_t>(field.stride(0));
+    return true;
+}
 }  // namespace nwp_emulator
\ No newline at end of file
@@ -106,6 +106,18 @@ private:
      */
     int findLevelIndex(atlas::Field& field, const std::string& levtype, const std::string& level) const;
 
+    /**
+     * @brief Finds the model field and the level index of a field key.
+     *
+     * @param fieldKey The key in `shortName,levtype,level` format.
+     * @param field The model field holding the key.
+     * @param levelIndex The index of the second shape of the field holding the key.
+     * @param error The reason of the failure, if any.
+     *
+     * @return true if the key has been found, false otherwise.
+     */
+    bool findFieldLevel(const std::string& fieldKey, atlas::Field& field, int& levelIndex, std::string& error) const;
+
 public:
     /**
      * @brief Constructs a NWPDataProvider object.
@@ -154,6 +166,27 @@ public:
                              std::vector<double>& values,
                              std::string& error) const;
 
+    /**
+     * @brief Locate the rank-local values of a field key in the model fieldset, without copying them.
+     *
+     * The values stay in place and change with each step, they are valid as long as the provider, or as a copy of the
+     * field handle.
+     *
+     * @param field Field holding the values.
+     * @param values First value of the level.
+     * @param size Number of rank-local points.
+     * @param stride Distance between the values of two consecutive points, in elements.
+     */
+    bool findFieldOverlayValues(const std::string& fieldKey,
+                                atlas::Field& field,
+                                const FIELD_TYPE_REAL*& values,
+                                size_t& size,
+                                size_t& stride,
+                                std::string& error) const;
+
+    /// Rank-local (lon, lat) coordinates in degrees, one row per point, held by the function space
+    atlas::Field lonlat() const { return fs_.lonlat(); }
+
     size_t rank() const { return rank_; }
     size_t root() const { return root_; }
     size_t nprocs() const { return nprocs_; }
@@ -19,7 +19,7 @@
 
 #include "atlas/field/Field.h"
 
-#include "plume/Manager.h"
+#include "plume/Session.h"
 
 #include "nwp_emulator_core.h"
 
@@ -105,10 +105,9 @@ bool NWPEmulatorCore::setupPlumeProvider() {
         return true;
     }
 
-    if (plume::Manager::isConfigured()) {
+    if (plumeSession_) {
         eckit::Log::error() << "NWPEmulatorCore: setupPlumeProvider() called more than once. "
-                               "Only one Plume run is supported per process: the Plume Manager "
-                               "is a process-level singleton and cannot be reconfigured." << std::endl;
+                               "The Plume session of an emulator core cannot be reconfigured." << std::endl;
         return false;
     }
 
@@ -147,7 +146,7 @@ bool NWPEmulatorCore::runStep() {
 
 void NWPEmulatorCore::finalizePlume() {
     if (plumeInitialised_) {
-        plume::Manager::teardown();
+        plumeSession_->teardown();
         plumeInitialised_ = false;
     }
 }
@@ -202,8 +201,39 @@ NWPFieldOverlaySnapshot NWPEmulatorCore::getFieldOverlaySnapshot(const std::stri
     return snapshot;
 }
 
+NWPArrayView<FIELD_TYPE_REAL> NWPEmulatorCore::getFieldValuesView(const std::string& fieldKey) const {
+    if (!dataProvider_) {
+        throw std::runtime_error("Data provider must be initialized before field export");
+    }
+
+    NWPArrayView<FIELD_TYPE_REAL> view;
+    std::string error;
+    if (!dataProvider_->findFieldOverlayValues(fieldKey, view.field, view.data, view.size, view.stride, error)) {
+        throw std::runtime_error("Field overlay export failed for " + fieldKey + ": " + error);
+    }
+    return view;
+}
+
+NWPArrayView<double> NWPEmulatorCore::getLonLatView() const {
+    if (!dataProvider_) {
+        throw std::runtime_error("Data provider must be initialized before field export");
+    }
+
+    // held by the function space, the coordinates do not change during the run
+    atlas::Field lonlat = dataProvider_->lonlat();
+    NWPArrayView<double> view;
+    view.field           = lonlat;
+    view.data            = lonlat.data<double>();
+    view.size            = static_cast<size_t>(lonlat.shape(0));
+    view.stride          = static_cast<size_t>(lonlat.stride(0));
+    view.components      = 2;
+    view.componentStride = static_cast<size_t>(lonlat.stride(1));
+    return view;
+}
+
 bool NWPEmulatorCore::setupPlume(NWPDataProvider& dataProvider) {
-    plume::Manager::configure(eckit::YAMLConfiguration(eckit::PathName(plumeConfigPath_)));
+    plumeSession_ = std::make_unique<plume::Session>();
+    plumeSession_->configure(eckit::YAMLConfiguration(eckit::PathName(plumeConfigPath_)));
 
     const size_t modelLevels = dataProvider.getLevels();
     if (modelLevels > static_cast<size_t>(std::numeric_limits<int>::max())) {
@@ -229,7 +259,7 @@ bool NWPEmulatorCore::setupPlume(NWPDataProvider& dataProvider) {
     for (const auto& field: fields) {
         offers.offer<atlas::Field>(field.name(), "on-request", field.name());
     }
-    plume::Manager::negotiate(offers);
+    plumeSession_->negotiate(offers);
 
     // Scalar parameters are initialised once before the first plugin step.
     plumeData_.createParam("NSTEP", 0);
@@ -239,13 +269,13 @@ bool NWPEmulatorCore::setupPlume(NWPDataProvider& dataProvider) {
 
     // Only bind fields that plugins explicitly requested during negotiation.
     for (auto& field: fields) {
-        if (plume::Manager::isParamRequested(field.name())) {
+        if (plumeSession_->isParamRequested(field.name())) {
             plumeData_.provideParam(field.name(), &field);
             plumeUpdatingParams_.push_back(field.name());
         }
     }
 
-    plume::Manager::feedPlugins(plumeData_);
+    plumeSession_->feedPlugins(plumeData_);
     return true;
 }
 
@@ -256,7 +286,7 @@ void NWPEmulatorCore::runPlume(int step) {
     plumeData_.updateParam("WSTEP", std::ceil(step * plumeData_.getParam<double>("TSTEP")));
     plumeData_.setUpdated(plumeUpdatingParams_);
 
-    plume::Manager::run();
+    plumeSession_->run();
 }
 
 }  // namespace nwp_emulator
@@ -14,6 +14,9 @@
 #include <string>
 #include <vector>
 
+#include "atlas/field/Field.h"
+
+#include "plume/Session.h"
 #include "plume/data/ModelData.h"
 
 #include "nwp_data_provider.h"
@@ -69,6 +72,24 @@ struct NWPFieldOverlaySnapshot {
     size_t nprocs = 1;
 };
 
+/**
+ * @struct NWPArrayView
+ * @brief Read-only view of rank-local emulator memory, e.g. the values of a field level, taken without copy.
+ *
+ * The view holds `size` points, `stride` elements apart, each of `components` values `componentStride` elements
+ * apart (2 for lon/lat coordinates). It follows the emulator memory: values change with each step. The view holds the
+ * field owning the memory, so copies of the view stay valid after the core is finalised or set up again.
+ */
+template <typename T>
+struct NWPArrayView {
+    atlas::Field field;
+    const T* data = nullptr;
+    size_t size = 0;
+    size_t stride = 1;
+    size_t components = 1;
+    size_t componentStride = 1;
+};
+
 /**
  * @class NWPEmulatorCore
  * @brief Reusable emulator backend independent from the AtlasTool CLI wrapper.
@@ -112,6 +133,10 @@ public:
     /**
      * @brief Configure Plume and negotiate field registration.
      *
+     * Each core drives its own Plume session, so several cores can run in the same process.
+     *
+     * @note May only be called once per instance; a second call is rejected.
+     *
      * @return true when Plume setup completed or was skipped.
      */
     bool setupPlumeProvider();
@@ -156,6 +181,18 @@ public:
      */
     NWPFieldOverlaySnapshot getFieldOverlaySnapshot(const std::string& fieldKey) const;
 
+    /**
+     * @brief View the rank-local values of a field at the current step, without copying them.
+     *
+     * Unlike getFieldOverlaySnapshot, values keep the precision of the emulator fields.
+     */
+    NWPArrayView<FIELD_TYPE_REAL> getFieldValuesView(const std::string& fieldKey) const;
+
+    /**
+     * @brief View the rank-local (lon, lat) coordinates in degrees, in the order of the field values, without copy.
+     */
+    NWPArrayView<double> getLonLatView() const;
+
 private:
     /**
      * @brief Configure Plume and register all requested fields and scalar params.
@@ -185,6 +222,9 @@ private:
     /// Shared param store passed to Plume across all steps of a single run.
     plume::data::ModelData plumeData_;
     std::vector<std::string> plumeUpdatingParams_;
+
+    /// Plume session of this core, declared after plumeData_ so its plugins are destroyed first.
+    std::unique_ptr<plume::Session> plumeSession_;
 };
 
 }  // namespace nwp_emulator
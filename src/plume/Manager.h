@@ -24,6 +24,7 @@
 #include "plume/ManagerConfig.h"
 #include "plume/Plugin.h"
 #include "plume/PluginDecision.h"
+#include "plume/Session.h"
 #include "plume/data/ParameterCatalogue.h"
 #include "plume/data/ModelData.h"
 
@@ -37,6 +38,8 @@ struct ManagerTestAccess; // forward declaration
 /**
  * @brief Manages the loading and running of plugins
  * 
+ * Static facade over the default Session, use a Session directly to run several independent
+ * Plume instances in the same process.
  */
 class Manager : public eckit::system::LibraryManager {
 
@@ -110,33 +113,20 @@ public:
 
     static bool isConfigured();
 
-private:
-
     /**
-     * @brief Load a plugin from a shared library
+     * @brief the session driven by this facade
      * 
-     * @param lib 
-     * @param name 
-     * @return Plugin& 
+     * @return Session& 
      */
-    static Plugin& loadPlugin(const std::string& lib, const std::string& name);
+    static Session& session();
 
-    /**
-     * @brief Check data before feeding plugins
-     * 
-     * @param data 
-     */
-    static void checkData(const data::ModelData& data);
+private:
 
     /**
      * @brief Reset the manager configuration, this method is only intended for use within tests.
      */
     static void reset();
 
-    static std::optional<ManagerConfig> managerConfig_;
-
-    static bool isConfigured_;
-
     friend struct test::ManagerTestAccess;
 
 };
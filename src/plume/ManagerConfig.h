@@ -11,13 +11,18 @@
 
 #pragma once
 
+#include <algorithm>
+#include <array>
+
 #include "Configurable.h"
 
 #include "eckit/config/LocalConfiguration.h"
 #include "eckit/config/YAMLConfiguration.h"
 #include "eckit/exception/Exceptions.h"
 
+#include "MemoryBudget.h"
 #include "PluginConfig.h"
+#include "ThreadAffinity.h"
 
 namespace plume {
 
@@ -26,10 +31,10 @@ class ManagerConfig final : public CheckedConfigurable {
 public:
 
 ManagerConfig() : 
-    CheckedConfigurable{eckit::YAMLConfiguration(std::string("{\"plugins\":[]}")), {"plugins"}, {"verbose"}} {}
+    CheckedConfigurable{eckit::YAMLConfiguration(std::string("{\"plugins\":[]}")), {"plugins"}, {"verbose", "comm", "threads", "profiling", "memory"}} {}
 
 ManagerConfig(const eckit::Configuration& config) : 
-    CheckedConfigurable{config, {"plugins"}, {"verbose"}} {
+    CheckedConfigurable{config, {"plugins"}, {"verbose", "comm", "threads", "profiling", "memory"}} {
 
     // plugins must be a list
     if (!this->config().isSubConfigurationList("plugins")) {
@@ -45,6 +50,50 @@ ManagerConfig(const eckit::Configuration& config) :
         }
     }
 
+    // check communicator name (if any)
+    if (this->config().has("comm") && this->config().getString("comm").empty()) {
+        throw eckit::BadValue("ManagerConfig: comm must be the name of a communicator", Here());
+    }
+
+    // check threads configuration (if any): placement, and size and use of the session thread pool
+    if (this->config().has("threads")) {
+        if (!this->config().isSubConfiguration("threads")) {
+            throw eckit::BadValue("ManagerConfig: threads must be a configuration", Here());
+        }
+        auto threads = this->config().getSubConfiguration("threads");
+        for (const auto& key : threads.keys()) {
+            if (std::find(threadsKeys_.begin(), threadsKeys_.end(), key) == threadsKeys_.end()) {
+                throw eckit::BadValue("ManagerConfig: invalid threads key " + key, Here());
+            }
+        }
+        if (threads.has("count") && threads.getInt("count") < 0) {
+            throw eckit::BadValue("ManagerConfig: invalid thread count " + std::to_string(threads.getInt("count")),
+                                  Here());
+        }
+        if (!ThreadAffinity::isValid(threads)) {
+            eckit::Log::error() << "Threads configuration NOT valid:" << threads << std::endl;
+            throw eckit::BadValue("ManagerConfig: threads configuration is not valid", Here());
+        }
+    }
+
+    // check memory budget configuration (if any)
+    if (this->config().has("memory") && (!this->config().isSubConfiguration("memory") ||
+                                          !MemoryBudget::isValid(this->config().getSubConfiguration("memory")))) {
+        throw eckit::BadValue("ManagerConfig: memory configuration is not valid", Here());
+    }
+
+    // check profiling configuration (if any)
+    if (this->config().has("profiling")) {
+        if (!this->config().isSubConfiguration("profiling")) {
+            throw eckit::BadValue("ManagerConfig: profiling must be a configuration", Here());
+        }
+        for (const auto& key : this->config().getSubConfiguration("profiling").keys()) {
+            if (std::find(profilingKeys_.begin(), profilingKeys_.end(), key) == profilingKeys_.end()) {
+                throw eckit::BadValue("ManagerConfig: invalid profiling key " + key, Here());
+            }
+        }
+    }
+
 }
 
 
@@ -66,6 +115,125 @@ std::vector<PluginConfig> plugins() const {
     return pluginConfigs;
 }
 
+
+/**
+ * @brief name of the eckit communicator of the session (empty for the default communicator)
+ * 
+ * @return std::string
+ */
+std::string commName() const {
+    if (has("comm")) {
+        return config().getString("comm");
+    }
+    return "";
+}
+
+
+/**
+ * @brief get the placement of Plume threads (inherit if not configured)
+ * 
+ * @return ThreadAffinity
+ */
+ThreadAffinity threadAffinity() const {
+    if (has("threads")) {
+        return ThreadAffinity(config().getSubConfiguration("threads"));
+    }
+    return ThreadAffinity();
+}
+
+
+/**
+ * @brief get the number of worker threads of the session thread pool (0 if not configured)
+ * 
+ * @return size_t
+ */
+size_t threadCount() const {
+    if (has("threads")) {
+        return config().getSubConfiguration("threads").getUnsigned("count", 0);
+    }
+    return 0;
+}
+
+
+/**
+ * @brief whether to profile the parameters read by each plugin (false if not configured)
+ * 
+ * @return bool
+ */
+bool profileAccess() const {
+    if (has("profiling")) {
+        return config().getSubConfiguration("profiling").getBool("access", false);
+    }
+    return false;
+}
+
+
+/**
+ * @brief path of the Chrome trace of the lifecycle (empty if not configured)
+ * 
+ * @return std::string
+ */
+std::string tracePath() const {
+    if (has("profiling")) {
+        return config().getSubConfiguration("profiling").getString("trace", "");
+    }
+    return "";
+}
+
+
+/**
+ * @brief whether the overhead metrics are exported (by a MetricsWriter)
+ * 
+ * @return bool
+ */
+bool exportMetrics() const {
+    return has("profiling") && config().getSubConfiguration("profiling").has("metrics");
+}
+
+
+/**
+ * @brief configuration of the metrics export (empty if not configured)
+ * 
+ * @return eckit::LocalConfiguration
+ */
+eckit::LocalConfiguration metricsConfig() const {
+    if (exportMetrics()) {
+        return config().getSubConfiguration("profiling").getSubConfiguration("metrics");
+    }
+    return eckit::LocalConfiguration();
+}
+
+
+/**
+ * @brief the memory budget of Plume on each rank (no budget if not configured)
+ * 
+ * @return MemoryBudget
+ */
+MemoryBudget memoryBudget() const {
+    if (has("memory")) {
+        return MemoryBudget(config().getSubConfiguration("memory"));
+    }
+    return MemoryBudget();
+}
+
+
+/**
+ * @brief whether plugin update callbacks can run concurrently on the session thread pool (false if not configured)
+ * 
+ * @return bool
+ */
+bool parallelCallbacks() const {
+    if (has("threads")) {
+        return config().getSubConfiguration("threads").getBool("parallel-callbacks", false);
+    }
+    return false;
+}
+
+private:
+
+    static constexpr std::array<const char*, 3> profilingKeys_{"access", "trace", "metrics"};
+    static constexpr std::array<const char*, 5> threadsKeys_{"affinity", "cpuset", "numa-first-touch", "count",
+                                                             "parallel-callbacks"};
 };
 
 }  // namespace plume
\ No newline at end of file
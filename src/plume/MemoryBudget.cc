@@ -0,0 +1,280 @@
+/*
+ * (C) Copyright 2025- ECMWF.
+ *
+ * This software is licensed under the terms of the Apache Licence Version 2.0
+ * which can be obtained at http://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * In applying this licence, ECMWF does not waive the privileges and immunities
+ * granted to it by virtue of its status as an intergovernmental organisation nor
+ * does it submit to any jurisdiction.
+ */
+#include <algorithm>
+#include <array>
+#include <cctype>
+#include <iomanip>
+#include <sstream>
+
+#include "eckit/exception/Exceptions.h"
+#include "eckit/log/Log.h"
+
+#include "plume/MemoryBudget.h"
+#include "plume/data/FieldProvider.h"
+
+
+namespace plume {
+
+namespace {
+
+using namespace field_provider;
+
+// e.g. 1.5 GiB
+std::string humanBytes(std::size_t bytes) {
+    static const std::array<const char*, 5> units{"B", "KiB", "MiB", "GiB", "TiB"};
+    double value     = static_cast<double>(bytes);
+    std::size_t unit = 0;
+    while (value >= 1024. && unit + 1 < units.size()) {
+        value /= 1024.;
+        ++unit;
+    }
+    std::ostringstream out;
+    out << std::fixed << std::setprecision(unit == 0 ? 0 : 1) << value << " " << units[unit];
+    return out.str();
+}
+
+// size of a copy of a field in another precision, given as "float" or "double" (same size if not given or unknown)
+std::size_t convertedBytes(std::size_t bytes, std::size_t elementSize, const std::string& precision) {
+    std::size_t targetSize = data::ParameterDefinition::elementSize(precision);
+    if (elementSize == 0 || targetSize == 0) {
+        return bytes;
+    }
+    return bytes / elementSize * targetSize;
+}
+
+bool isHistory(const data::ParameterDefinition& param) {
+    return param.strategy() == UpdateStrategyTraits<FieldHistory>::name;
+}
+
+// zonal means have one row per latitude of the grid, not known from the offers
+bool isZonalMean(const data::ParameterDefinition& param) {
+    return param.strategy() == UpdateStrategyTraits<GlobalStatistic>::name && param.level() == "zonal-mean";
+}
+
+}  // namespace
+
+
+MemoryBudget::MemoryBudget(const eckit::Configuration& config) {
+    if (!isValid(config)) {
+        throw eckit::BadValue("MemoryBudget: memory configuration is not valid", Here());
+    }
+    if (config.has("budget")) {
+        budget_ = config.isString("budget") ? parseBytes(config.getString("budget")) : config.getUnsigned("budget");
+    }
+    reject_ = config.getString("policy", "warn") == "reject";
+}
+
+
+bool MemoryBudget::isValid(const eckit::Configuration& config) {
+    for (const auto& key : config.keys()) {
+        if (key != "budget" && key != "policy") {
+            eckit::Log::error() << "MemoryBudget: invalid key " << key << std::endl;
+            return false;
+        }
+    }
+    if (config.has("budget") && config.isString("budget")) {
+        try {
+            parseBytes(config.getString("budget"));
+        }
+        catch (const eckit::BadValue& e) {
+            eckit::Log::error() << e.what() << std::endl;
+            return false;
+        }
+    }
+    std::string policy = config.getString("policy", "warn");
+    return policy == "warn" || policy == "reject";
+}
+
+
+MemoryBudget::Estimate MemoryBudget::estimate(const std::string& plugin, const Protocol& offers,
+                                              const PluginDecision& decision, std::size_t workingSet) const {
+    Estimate estimate;
+    estimate.plugin     = plugin;
+    estimate.workingSet = workingSet;
+
+    for (const auto& param : decision.offeredParams()) {
+        // offered params are provided by the model
+        if (param.strategy().empty() || offers.isParamOffered(param.id()) || counted_.count(param.id())) {
+            continue;
+        }
+        auto sourceId = data::ParamId::find(param.sourceParam());
+        if (!offers.isParamOffered(sourceId) || offers.offers().getParam(sourceId).bytes() == 0 ||
+            isZonalMean(param)) {
+            estimate.unknown.push_back(param.name());
+            continue;
+        }
+        const auto& source = offers.offers().getParam(sourceId);
+        (isHistory(param) ? estimate.snapshots : estimate.derived) += derivedBytes(param, source);
+    }
+    return estimate;
+}
+
+
+MemoryBudget::Estimate MemoryBudget::largest(const Estimate& estimate, const eckit::mpi::Comm& comm) {
+    std::array<std::size_t, 3> sizes{estimate.derived, estimate.snapshots, estimate.workingSet};
+    comm.allReduceInPlace(sizes.data(), sizes.size(), eckit::mpi::max());
+
+    Estimate largest   = estimate;
+    largest.derived    = sizes[0];
+    largest.snapshots  = sizes[1];
+    largest.workingSet = sizes[2];
+    return largest;
+}
+
+
+bool MemoryBudget::admit(const Estimate& estimate, const PluginDecision& decision) {
+    estimates_.push_back(estimate);
+
+    bool exceeds = budget_ > 0 && total_ + estimate.total() > budget_;
+    if (exceeds) {
+        eckit::Log::warning() << "Plugin " << estimate.plugin << " needs " << humanBytes(estimate.total())
+                              << " per rank, exceeding the Plume memory budget of " << humanBytes(budget_) << " ("
+                              << humanBytes(total_) << " already projected)" << (reject_ ? ", rejected" : "")
+                              << std::endl;
+        if (reject_) {
+            return false;
+        }
+    }
+
+    estimates_.back().admitted = true;
+    total_ += estimate.total();
+    for (const auto& param : decision.offeredParams()) {
+        if (!param.strategy().empty()) {
+            counted_.insert(param.id());
+        }
+    }
+    return true;
+}
+
+
+std::size_t MemoryBudget::derivedBytes(const data::ParameterDefinition& param,
+                                       const data::ParameterDefinition& source) {
+    const std::size_t bytes  = source.bytes();
+    const std::string& level = param.level();
+
+    // a horizontal slice
+    if (param.strategy() == UpdateStrategyTraits<WindAtHeight>::name) {
+        return bytes / source.levels();
+    }
+    if (param.strategy() == UpdateStrategyTraits<LevelView>::name) {
+        return 0;
+    }
+    if (param.strategy() == UpdateStrategyTraits<LevelCopy>::name) {
+        try {
+            return bytes / source.levels() * parseLevels(level).size();
+        }
+        catch (const eckit::BadValue&) {
+            return bytes;
+        }
+    }
+
+    // in double precision, whatever the precision of the source: a value per level (zonal means are not known), per
+    // station and level, or per point and level with the halo copies (of the owned points at least) of the sources
+    if (param.strategy() == UpdateStrategyTraits<GlobalStatistic>::name) {
+        return param.level() == "zonal-mean" ? 0 : source.levels() * sizeof(double);
+    }
+    if (param.strategy() == UpdateStrategyTraits<StationValues>::name) {
+        const auto nstations = static_cast<std::size_t>(std::count(level.begin(), level.end(), ',')) + 1;
+        return nstations * source.levels() * sizeof(double);
+    }
+    if (param.strategy() == UpdateStrategyTraits<StencilDerivative>::name) {
+        return 2 * convertedBytes(bytes, source.elementSize(), "double");
+    }
+    if (param.strategy() == UpdateStrategyTraits<WindDerivative>::name) {
+        return 3 * convertedBytes(bytes, source.elementSize(), "double");
+    }
+
+    // a row of 5 doubles per point and level, allocated once
+    if (param.strategy() == UpdateStrategyTraits<ThresholdExceedance>::name ||
+        param.strategy() == UpdateStrategyTraits<LocalThresholdExceedance>::name) {
+        return ThresholdExceedance::Columns * convertedBytes(bytes, source.elementSize(), "double");
+    }
+
+    // "float", "double", "level-major" or "float+level-major"
+    if (param.strategy() == UpdateStrategyTraits<Representation>::name ||
+        param.strategy() == UpdateStrategyTraits<PrecisionRepresentation>::name) {
+        return convertedBytes(bytes, source.elementSize(), level.substr(0, level.find('+')));
+    }
+
+    // "K" or "K/float"
+    if (isHistory(param)) {
+        auto slash        = level.find('/');
+        std::size_t depth = 0;
+        for (char c : level.substr(0, slash)) {
+            if (!std::isdigit(static_cast<unsigned char>(c))) {
+                break;
+            }
+            depth = 10 * depth + static_cast<std::size_t>(c - '0');
+        }
+        std::string precision = slash == std::string::npos ? "" : level.substr(slash + 1);
+        return depth * convertedBytes(bytes, source.elementSize(), precision);
+    }
+
+    // a copy of the source at most (area subsets, derivatives, layouts)
+    return bytes;
+}
+
+
+std::size_t MemoryBudget::parseBytes(const std::string& bytes) {
+    std::size_t pos = 0;
+    double value    = -1.;
+    try {
+        value = std::stod(bytes, &pos);
+    }
+    catch (const std::exception&) {
+        pos = 0;
+    }
+    std::string suffix = bytes.substr(pos);
+    if (suffix == "B") {
+        suffix.clear();
+    }
+    std::size_t scale = 1;
+    if (!suffix.empty()) {
+        const std::string units = "KMGT";
+        auto unit               = units.find(static_cast<char>(std::toupper(static_cast<unsigned char>(suffix[0]))));
+        std::string rest        = suffix.substr(1);
+        if (unit == std::string::npos || !(rest.empty() || rest == "B" || rest == "iB")) {
+            pos = 0;
+        }
+        else {
+            scale = std::size_t{1} << (10 * (unit + 1));
+        }
+    }
+    if (pos == 0 || value < 0.) {
+        throw eckit::BadValue("Invalid number of bytes '" + bytes + "' (expected e.g. 1024, 512M or 2G)", Here());
+    }
+    return static_cast<std::size_t>(value * static_cast<double>(scale));
+}
+
+
+void MemoryBudget::report(std::ostream& out) const {
+    out << "--- Plume projected memory per rank";
+    if (budget_ > 0) {
+        out << " (budget " << humanBytes(budget_) << ", " << (reject_ ? "reject" : "warn") << ")";
+    }
+    out << ":" << std::endl;
+    for (const auto& estimate : estimates_) {
+        out << "  " << estimate.plugin << (estimate.admitted ? "" : " [REJECTED]") << ": "
+            << humanBytes(estimate.derived) << " derived, " << humanBytes(estimate.snapshots) << " snapshots, "
+            << humanBytes(estimate.workingSet) << " working set, " << humanBytes(estimate.total()) << " in total";
+        if (!estimate.unknown.empty()) {
+            out << " (unknown size of";
+            for (const auto& name : estimate.unknown) {
+                out << " " << name;
+            }
+            out << ")";
+        }
+        out << std::endl;
+    }
+    out << "  total: " << humanBytes(total_) << std::endl;
+}
+
+}  // namespace plume
@@ -0,0 +1,129 @@
+/*
+ * (C) Copyright 2025- ECMWF.
+ *
+ * This software is licensed under the terms of the Apache Licence Version 2.0
+ * which can be obtained at http://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * In applying this licence, ECMWF does not waive the privileges and immunities
+ * granted to it by virtue of its status as an intergovernmental organisation nor
+ * does it submit to any jurisdiction.
+ */
+#pragma once
+
+#include <cstddef>
+#include <ostream>
+#include <string>
+#include <unordered_set>
+#include <vector>
+
+#include "eckit/config/Configuration.h"
+#include "eckit/mpi/Comm.h"
+
+#include "plume/PluginDecision.h"
+#include "plume/Protocol.h"
+#include "plume/data/ParameterCatalogue.h"
+
+
+namespace plume {
+
+/**
+ * @brief Projected memory of Plume on each rank, per plugin, checked against an optional budget at negotiation
+ *
+ * The projection is made from the local sizes of the offered fields (see ParameterDefinition::bytes). A plugin adds:
+ * - the derived params it requires that no plugin admitted before requires (they are shared),
+ * - the snapshots of the field histories among them,
+ * - the working set it declares (see Protocol::requireWorkingSet).
+ *
+ * The offered fields are owned by the model and not counted. Derived params whose source has no size, and zonal means,
+ * are counted as unknown. Statistics, station values, derivatives and exceedances (5 values per point and level) are
+ * computed in double precision whatever the precision of their source.
+ *
+ * Sizes are local, so ranks may project differently: in a session, each plugin is admitted on the largest estimate of
+ * the ranks (see `largest`), so that all the ranks activate the same plugins (a plugin active on some ranks only would
+ * wait forever in its collectives).
+ *
+ * Configured under the `memory` key of the manager configuration:
+ * @code{.yaml}
+ * memory:
+ *   budget: 2G        # bytes per rank, with an optional K, M, G or T suffix (powers of 1024)
+ *   policy: reject    # reject the plugins exceeding the budget, or warn (default)
+ * @endcode
+ */
+class MemoryBudget {
+public:
+    /// Memory a plugin adds to the projection, in bytes
+    struct Estimate {
+        std::string plugin;
+        std::size_t derived    = 0;
+        std::size_t snapshots  = 0;
+        std::size_t workingSet = 0;
+        std::vector<std::string> unknown;  ///< derived params whose source has no size
+        bool admitted = false;
+
+        std::size_t total() const { return derived + snapshots + workingSet; }
+    };
+
+    /// No budget, the projection is only reported
+    MemoryBudget() = default;
+
+    explicit MemoryBudget(const eckit::Configuration& config);
+
+    static bool isValid(const eckit::Configuration& config);
+
+    /**
+     * @brief Memory a plugin would add to the projection
+     *
+     * @param plugin name of the plugin
+     * @param offers offers of the model, with the sizes of the fields
+     * @param decision params offered to the plugin
+     * @param workingSet working set declared by the plugin
+     */
+    Estimate estimate(const std::string& plugin, const Protocol& offers, const PluginDecision& decision,
+                      std::size_t workingSet) const;
+
+    /**
+     * @brief Largest estimate of the ranks, per component (collective)
+     *
+     * Admitting the largest estimates in the same order on all the ranks takes the same decisions on all of them.
+     */
+    static Estimate largest(const Estimate& estimate, const eckit::mpi::Comm& comm);
+
+    /**
+     * @brief Whether a plugin can be activated, adding its estimate to the projection if so
+     *
+     * A plugin exceeding the budget is rejected with the `reject` policy, and admitted with a warning otherwise.
+     */
+    bool admit(const Estimate& estimate, const PluginDecision& decision);
+
+    /// Size of a derived param from the size of its source (0 if not allocated by Plume or if unknown)
+    static std::size_t derivedBytes(const data::ParameterDefinition& param, const data::ParameterDefinition& source);
+
+    /// Parses a number of bytes with an optional K, M, G or T suffix, e.g. "512M"
+    static std::size_t parseBytes(const std::string& bytes);
+
+    /// Budget in bytes (0 if none)
+    std::size_t budget() const { return budget_; }
+
+    bool rejects() const { return reject_; }
+
+    /// Projected memory of the admitted plugins in bytes
+    std::size_t total() const { return total_; }
+
+    /// Estimates of the plugins evaluated so far (admitted or not)
+    const std::vector<Estimate>& estimates() const { return estimates_; }
+
+    /// Breakdown of the projection per plugin
+    void report(std::ostream& out) const;
+
+private:
+    std::size_t budget_ = 0;
+    bool reject_        = false;
+
+    std::size_t total_ = 0;
+    std::vector<Estimate> estimates_;
+
+    // derived params counted so far
+    std::unordered_set<data::ParamId> counted_;
+};
+
+}  // namespace plume
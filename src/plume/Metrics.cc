@@ -0,0 +1,463 @@
+/*
+ * (C) Copyright 2025- ECMWF.
+ *
+ * This software is licensed under the terms of the Apache Licence Version 2.0
+ * which can be obtained at http://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * In applying this licence, ECMWF does not waive the privileges and immunities
+ * granted to it by virtue of its status as an intergovernmental organisation nor
+ * does it submit to any jurisdiction.
+ */
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iomanip>
+#include <sstream>
+
+#include "eckit/exception/Exceptions.h"
+#include "eckit/filesystem/PathName.h"
+#include "eckit/log/Log.h"
+
+#include "plume/Metrics.h"
+#include "plume/Tracer.h"
+
+
+namespace plume {
+
+namespace {
+
+struct Family {
+    const char* name;
+    const char* help;
+    bool histogram;
+    const char* label;  // key of the label, empty if none
+};
+
+const std::array<Family, 4>& families() {
+    static const std::array<Family, 4> all{{
+        {Metrics::pluginRunSeconds, "Run time of the plugincores", true, "plugin"},
+        {Metrics::strategyUpdateSeconds, "Update time of the derived parameters, per update strategy", true,
+         "strategy"},
+        {Metrics::bytesCopied, "Bytes copied by Plume (derived parameters, subsets, halo and station buffers)", false,
+         ""},
+        {Metrics::stepsSkipped, "Steps not run by idle plugins", false, "plugin"},
+    }};
+    return all;
+}
+
+const Family& family(const std::string& name) {
+    for (const auto& f : families()) {
+        if (name == f.name) {
+            return f;
+        }
+    }
+    throw eckit::BadParameter("Metrics: unknown family " + name, Here());
+}
+
+
+std::string escape(const std::string& text) {
+    std::string escaped;
+    for (char c : text) {
+        if (c == '"' || c == '\\') {
+            escaped += '\\';
+        }
+        escaped += (static_cast<unsigned char>(c) < 0x20) ? ' ' : c;
+    }
+    return escaped;
+}
+
+std::string format(double value) {
+    std::ostringstream out;
+    out << std::setprecision(17) << value;
+    return out.str();
+}
+
+std::string series(const Metrics::Sample& sample) {
+    std::string key = sample.name;
+    for (const auto& [k, v] : sample.labels) {
+        key += '\n' + k + '=' + v;
+    }
+    return key;
+}
+
+}  // namespace
+
+
+//----------------------------------------------------------------------------------------------------------------------
+
+void Metrics::Histogram::observe(double seconds) {
+    for (std::size_t i = 0; i < buckets.size(); ++i) {
+        if (seconds <= buckets[i]) {
+            counts_[i].fetch_add(1, std::memory_order_relaxed);
+            break;
+        }
+    }
+    count_.fetch_add(1, std::memory_order_relaxed);
+    double sum = sum_.load(std::memory_order_relaxed);
+    while (!sum_.compare_exchange_weak(sum, sum + seconds, std::memory_order_relaxed)) {
+    }
+}
+
+
+std::uint64_t Metrics::Histogram::cumulative(std::size_t i) const {
+    ASSERT(i < buckets.size());
+    std::uint64_t total = 0;
+    for (std::size_t j = 0; j <= i; ++j) {
+        total += counts_[j].load(std::memory_order_relaxed);
+    }
+    return total;
+}
+
+
+void Metrics::Histogram::reset() {
+    for (auto& count : counts_) {
+        count.store(0, std::memory_order_relaxed);
+    }
+    count_.store(0, std::memory_order_relaxed);
+    sum_.store(0., std::memory_order_relaxed);
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+
+Metrics& Metrics::instance() {
+    static Metrics metrics;
+    return metrics;
+}
+
+
+void Metrics::disable() {
+    int users = users_.load(std::memory_order_relaxed);
+    while (users > 0 && !users_.compare_exchange_weak(users, users - 1, std::memory_order_relaxed)) {
+    }
+}
+
+
+Metrics::Counter& Metrics::counter(const std::string& family, const std::string& label) {
+    ASSERT_MSG(!plume::family(family).histogram, "Metrics: " + family + " is a histogram");
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto& counter = counters_[{family, label}];
+    if (!counter) {
+        counter = std::make_unique<Counter>();
+    }
+    return *counter;
+}
+
+
+Metrics::Histogram& Metrics::histogram(const std::string& family, const std::string& label) {
+    ASSERT_MSG(plume::family(family).histogram, "Metrics: " + family + " is a counter");
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto& histogram = histograms_[{family, label}];
+    if (!histogram) {
+        histogram = std::make_unique<Histogram>();
+    }
+    return *histogram;
+}
+
+
+Metrics::Histogram& Metrics::histogram(const std::string& family, const std::type_info& type) {
+    auto& histogram = this->histogram(family, std::string(type.name()));
+    std::lock_guard<std::mutex> lock(mutex_);
+    typeLabels_[{family, type.name()}] = true;
+    return histogram;
+}
+
+
+void Metrics::addBytesCopied(std::uint64_t bytes) {
+    if (enabled()) {
+        static Counter& copied = counter(bytesCopied);
+        copied.add(bytes);
+    }
+}
+
+
+std::vector<Metrics::Sample> Metrics::samples() const {
+    std::vector<Sample> samples;
+    std::lock_guard<std::mutex> lock(mutex_);
+    for (const auto& f : families()) {
+        auto labels = [&](const std::string& label) {
+            std::vector<std::pair<std::string, std::string>> labels;
+            if (*f.label) {
+                bool typeLabel = typeLabels_.count({f.name, label}) > 0;
+                labels.emplace_back(f.label, typeLabel ? Tracer::demangle(label.c_str()) : label);
+            }
+            return labels;
+        };
+
+        if (!f.histogram) {
+            for (auto it = counters_.lower_bound({f.name, ""}); it != counters_.end() && it->first.first == f.name;
+                 ++it) {
+                samples.push_back({f.name, labels(it->first.second), static_cast<double>(it->second->value())});
+            }
+            continue;
+        }
+
+        for (auto it = histograms_.lower_bound({f.name, ""}); it != histograms_.end() && it->first.first == f.name;
+             ++it) {
+            const auto& histogram = *it->second;
+            auto base             = labels(it->first.second);
+            for (std::size_t i = 0; i < buckets.size(); ++i) {
+                auto bucket = base;
+                bucket.emplace_back("le", format(buckets[i]));
+                samples.push_back({std::string(f.name) + "_bucket", bucket, static_cast<double>(histogram.cumulative(i))});
+            }
+            auto inf = base;
+            inf.emplace_back("le", "+Inf");
+            samples.push_back({std::string(f.name) + "_bucket", inf, static_cast<double>(histogram.count())});
+            samples.push_back({std::string(f.name) + "_sum", base, histogram.sum()});
+            samples.push_back({std::string(f.name) + "_count", base, static_cast<double>(histogram.count())});
+        }
+    }
+    return samples;
+}
+
+
+std::string Metrics::prometheus(const std::vector<Sample>& samples, const std::string& extraLabel,
+                                const std::string& extraValue) {
+    std::ostringstream out;
+    for (const auto& f : families()) {
+        bool header = false;
+        for (const auto& sample : samples) {
+            if (sample.name.compare(0, std::strlen(f.name), f.name) != 0) {
+                continue;
+            }
+            if (!header) {
+                out << "# HELP " << f.name << ' ' << f.help << '\n';
+                out << "# TYPE " << f.name << ' ' << (f.histogram ? "histogram" : "counter") << '\n';
+                header = true;
+            }
+            out << sample.name;
+            const char* separator = "{";
+            if (!extraLabel.empty()) {
+                out << separator << extraLabel << "=\"" << escape(extraValue) << '"';
+                separator = ",";
+            }
+            for (const auto& [key, value] : sample.labels) {
+                out << separator << key << "=\"" << escape(value) << '"';
+                separator = ",";
+            }
+            out << (*separator == ',' ? "} " : " ") << format(sample.value) << '\n';
+        }
+    }
+    return out.str();
+}
+
+
+std::string Metrics::jsonLine(const std::vector<Sample>& samples, const std::string& rank) {
+    using namespace std::chrono;
+    std::ostringstream out;
+    out << R"({"time":)" << format(duration<double>(system_clock::now().time_since_epoch()).count())
+        << R"(,"rank":")" << rank << R"(","samples":[)";
+    const char* separator = "";
+    for (const auto& sample : samples) {
+        out << separator << R"({"name":")" << sample.name << R"(","labels":{)";
+        const char* labelSeparator = "";
+        for (const auto& [key, value] : sample.labels) {
+            out << labelSeparator << '"' << key << R"(":")" << escape(value) << '"';
+            labelSeparator = ",";
+        }
+        out << R"(},"value":)" << format(sample.value) << '}';
+        separator = ",";
+    }
+    out << "]}\n";
+    return out.str();
+}
+
+
+std::vector<Metrics::Sample> Metrics::aggregate(const std::vector<Sample>& samples, const eckit::mpi::Comm& comm,
+                                                std::size_t root) {
+    // samples as lines of "name\nkey=value...\tvalue", gathered on the root
+    std::string local;
+    for (const auto& sample : samples) {
+        local += series(sample) + '\t' + format(sample.value) + '\0';
+    }
+
+    std::vector<int> sizes(comm.size());
+    comm.gather(static_cast<int>(local.size()), sizes, root);
+    std::vector<int> displs(comm.size(), 0);
+    for (std::size_t r = 1; r < sizes.size(); ++r) {
+        displs[r] = displs[r - 1] + sizes[r - 1];
+    }
+    std::string all(comm.rank() == root ? displs.back() + sizes.back() : 0, '\0');
+    comm.gatherv(local.begin(), local.end(), all.begin(), all.end(), sizes, displs, root);
+
+    if (comm.rank() != root) {
+        return {};
+    }
+
+    // sums per series, in the order of first appearance (the family order of each rank)
+    std::vector<Sample> sums;
+    std::map<std::string, std::size_t> index;
+    std::size_t begin = 0;
+    while (begin < all.size()) {
+        std::size_t end = all.find('\0', begin);
+        std::string line(all, begin, end - begin);
+        begin = end + 1;
+
+        std::size_t tab = line.rfind('\t');
+        std::string key = line.substr(0, tab);
+        double value    = std::stod(line.substr(tab + 1));
+
+        auto [it, inserted] = index.emplace(key, sums.size());
+        if (!inserted) {
+            sums[it->second].value += value;
+            continue;
+        }
+        std::istringstream fields(key);
+        Sample sample{"", {}, value};
+        std::getline(fields, sample.name);
+        for (std::string label; std::getline(fields, label);) {
+            std::size_t equal = label.find('=');
+            sample.labels.emplace_back(label.substr(0, equal), label.substr(equal + 1));
+        }
+        sums.push_back(std::move(sample));
+    }
+
+    // families back together
+    std::stable_sort(sums.begin(), sums.end(), [](const Sample& a, const Sample& b) {
+        auto rank = [](const Sample& s) {
+            const auto& all = families();
+            for (std::size_t i = 0; i < all.size(); ++i) {
+                if (s.name.compare(0, std::strlen(all[i].name), all[i].name) == 0) {
+                    return i;
+                }
+            }
+            return all.size();
+        };
+        return rank(a) < rank(b);
+    });
+    return sums;
+}
+
+
+void Metrics::reset() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    for (auto& [key, counter] : counters_) {
+        counter->reset();
+    }
+    for (auto& [key, histogram] : histograms_) {
+        histogram->reset();
+    }
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+
+MetricsWriter::MetricsWriter(const eckit::LocalConfiguration& config, std::size_t rank, std::size_t session) :
+    directory_{config.getString("directory", "")},
+    period_{static_cast<long>(1000. * config.getDouble("period", 10.))},
+    aggregate_{config.getBool("aggregate", false)},
+    rank_{rank},
+    prefix_{"plume_" + std::to_string(session) + "_"} {
+
+    if (directory_.empty()) {
+        throw eckit::BadValue("MetricsWriter: profiling.metrics.directory is required", Here());
+    }
+    if (period_.count() <= 0) {
+        throw eckit::BadValue("MetricsWriter: profiling.metrics.period must be positive", Here());
+    }
+    if (config.has("formats")) {
+        auto formats = config.getStringVector("formats");
+        for (const auto& format : formats) {
+            if (format != "prometheus" && format != "json") {
+                throw eckit::BadValue("MetricsWriter: invalid format " + format + " (prometheus or json)", Here());
+            }
+        }
+        prometheus_ = std::find(formats.begin(), formats.end(), "prometheus") != formats.end();
+        json_       = std::find(formats.begin(), formats.end(), "json") != formats.end();
+    }
+
+    eckit::PathName(directory_).mkdir();
+    Metrics::instance().enable();
+    enabled_ = true;
+    thread_  = std::thread([this] { loop(); });
+}
+
+
+MetricsWriter::~MetricsWriter() {
+    stop();
+}
+
+
+void MetricsWriter::stop() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stopping_ = true;
+    }
+    if (enabled_) {
+        // the metrics stay enabled for the other writers
+        Metrics::instance().disable();
+        enabled_ = false;
+    }
+    wakeup_.notify_all();
+    if (thread_.joinable()) {
+        thread_.join();
+    }
+}
+
+
+void MetricsWriter::loop() {
+    std::unique_lock<std::mutex> lock(mutex_);
+    while (!wakeup_.wait_for(lock, period_, [this] { return stopping_; })) {
+        lock.unlock();
+        try {
+            write();
+        }
+        catch (const std::exception& e) {
+            // a full disk must not stop the model
+            eckit::Log::warning() << "Plume metrics not written: " << e.what() << std::endl;
+        }
+        lock.lock();
+    }
+}
+
+
+void MetricsWriter::write() {
+    writeFiles(Metrics::instance().samples(), std::to_string(rank_), std::to_string(rank_));
+}
+
+
+void MetricsWriter::finish(const eckit::mpi::Comm& comm) {
+    stop();
+    auto samples = Metrics::instance().samples();
+    writeFiles(samples, std::to_string(rank_), std::to_string(rank_));
+    if (aggregate_) {
+        auto sums = Metrics::aggregate(samples, comm);
+        if (comm.rank() == 0) {
+            writeFiles(sums, "all", "all");
+        }
+    }
+}
+
+
+void MetricsWriter::writeFiles(const std::vector<Metrics::Sample>& samples, const std::string& suffix,
+                               const std::string& rank) {
+    std::lock_guard<std::mutex> lock(writeMutex_);
+    const std::string base = directory_ + "/" + prefix_ + suffix;
+
+    if (prometheus_) {
+        // textfile collectors read complete files only
+        const std::string file = base + ".prom";
+        const std::string tmp  = file + ".tmp";
+        {
+            std::ofstream out(tmp);
+            if (!out) {
+                throw eckit::CantOpenFile(tmp, Here());
+            }
+            out << Metrics::prometheus(samples, "rank", rank);
+        }
+        if (std::rename(tmp.c_str(), file.c_str()) != 0) {
+            throw eckit::WriteError("MetricsWriter: cannot replace " + file, Here());
+        }
+    }
+
+    if (json_) {
+        const std::string file = base + ".jsonl";
+        std::ofstream out(file, std::ios::app);
+        if (!out) {
+            throw eckit::CantOpenFile(file, Here());
+        }
+        out << Metrics::jsonLine(samples, rank);
+    }
+}
+
+}  // namespace plume
@@ -0,0 +1,225 @@
+/*
+ * (C) Copyright 2025- ECMWF.
+ *
+ * This software is licensed under the terms of the Apache Licence Version 2.0
+ * which can be obtained at http://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * In applying this licence, ECMWF does not waive the privileges and immunities
+ * granted to it by virtue of its status as an intergovernmental organisation nor
+ * does it submit to any jurisdiction.
+ */
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <typeinfo>
+#include <vector>
+
+#include "eckit/config/LocalConfiguration.h"
+#include "eckit/memory/NonCopyable.h"
+#include "eckit/mpi/Comm.h"
+
+
+namespace plume {
+
+/**
+ * @brief Counters and histograms of the Plume overhead, exported by a MetricsWriter
+ *
+ * Metrics belong to a fixed set of families, each with at most one label (e.g. the plugin name). Values are atomic,
+ * metrics are created on first use and never destroyed (references can be kept). Nothing is recorded while disabled.
+ * The values are those of the process: sessions exporting metrics enable them together, and export the same values.
+ */
+class Metrics : private eckit::NonCopyable {
+
+public:
+
+    /// Families
+    static constexpr const char* pluginRunSeconds      = "plume_plugin_run_seconds";
+    static constexpr const char* strategyUpdateSeconds = "plume_strategy_update_seconds";
+    static constexpr const char* bytesCopied           = "plume_bytes_copied_total";
+    static constexpr const char* stepsSkipped          = "plume_steps_skipped_total";
+
+    /// Upper bounds of the histogram buckets, in seconds
+    static constexpr std::array<double, 7> buckets{1e-5, 1e-4, 1e-3, 1e-2, 1e-1, 1., 10.};
+
+    class Counter : private eckit::NonCopyable {
+    public:
+        void add(std::uint64_t n = 1) { value_.fetch_add(n, std::memory_order_relaxed); }
+        std::uint64_t value() const { return value_.load(std::memory_order_relaxed); }
+        void reset() { value_.store(0, std::memory_order_relaxed); }
+
+    private:
+        std::atomic<std::uint64_t> value_{0};
+    };
+
+    class Histogram : private eckit::NonCopyable {
+    public:
+        void observe(double seconds);
+        std::uint64_t count() const { return count_.load(std::memory_order_relaxed); }
+        double sum() const { return sum_.load(std::memory_order_relaxed); }
+        /// Observations up to the upper bound of bucket i (cumulative)
+        std::uint64_t cumulative(std::size_t i) const;
+        void reset();
+
+    private:
+        std::array<std::atomic<std::uint64_t>, buckets.size()> counts_{};
+        std::atomic<std::uint64_t> count_{0};
+        std::atomic<double> sum_{0.};
+    };
+
+    /// A value of the exposition, e.g. plume_plugin_run_seconds_bucket{plugin="x",le="0.01"}
+    struct Sample {
+        std::string name;
+        std::vector<std::pair<std::string, std::string>> labels;
+        double value;
+    };
+
+    static Metrics& instance();
+
+    /// Enables the metrics for one more user (e.g. the writer of a session), they stay enabled until all disable.
+    void enable() { users_.fetch_add(1, std::memory_order_relaxed); }
+
+    /// Releases an enable (no effect when disabled).
+    void disable();
+
+    bool enabled() const { return users_.load(std::memory_order_relaxed) > 0; }
+
+    /// Counter of a family (with the value of its label, if any), created on first use.
+    Counter& counter(const std::string& family, const std::string& label = std::string());
+
+    /// Histogram of a family, created on first use. Labels given as a type_info are demangled when exported.
+    Histogram& histogram(const std::string& family, const std::string& label = std::string());
+
+    Histogram& histogram(const std::string& family, const std::type_info& type);
+
+    /// Counts bytes copied by Plume (if enabled), see the bytesCopied family.
+    void addBytesCopied(std::uint64_t bytes);
+
+    /// Current values, ordered by family then series.
+    std::vector<Sample> samples() const;
+
+    /// Prometheus text exposition of samples, with an extra label on each sample (e.g. the rank).
+    static std::string prometheus(const std::vector<Sample>& samples, const std::string& extraLabel = std::string(),
+                                  const std::string& extraValue = std::string());
+
+    /// One JSON line of samples, tagged with the time and the rank (or "all").
+    static std::string jsonLine(const std::vector<Sample>& samples, const std::string& rank);
+
+    /// Sums of the samples of all the ranks, on the root (collective).
+    static std::vector<Sample> aggregate(const std::vector<Sample>& samples, const eckit::mpi::Comm& comm,
+                                         std::size_t root = 0);
+
+    /// Resets the values (the metrics are kept).
+    void reset();
+
+    /**
+     * @brief Observes the time from its construction to its destruction in a histogram (if metrics are enabled)
+     */
+    class Timer : private eckit::NonCopyable {
+    public:
+        Timer(const char* family, const std::string& label) :
+            histogram_{Metrics::instance().enabled() ? &Metrics::instance().histogram(family, label) : nullptr} {
+            start();
+        }
+
+        Timer(const char* family, const std::type_info& type) :
+            histogram_{Metrics::instance().enabled() ? &Metrics::instance().histogram(family, type) : nullptr} {
+            start();
+        }
+
+        ~Timer() {
+            if (histogram_) {
+                histogram_->observe(std::chrono::duration<double>(std::chrono::steady_clock::now() - begin_).count());
+            }
+        }
+
+    private:
+        void start() {
+            if (histogram_) {
+                begin_ = std::chrono::steady_clock::now();
+            }
+        }
+
+        Histogram* histogram_;
+        std::chrono::steady_clock::time_point begin_;
+    };
+
+private:
+
+    Metrics() = default;
+
+    std::atomic<int> users_{0};
+
+    mutable std::mutex mutex_;  // guards the maps (not the values)
+    std::map<std::pair<std::string, std::string>, std::unique_ptr<Counter>> counters_;
+    std::map<std::pair<std::string, std::string>, std::unique_ptr<Histogram>> histograms_;
+    std::map<std::pair<std::string, std::string>, bool> typeLabels_;
+};
+
+
+/**
+ * @brief Background thread writing the metrics of this rank under a directory
+ *
+ * Configured by `profiling.metrics` in the manager configuration:
+ *  - directory: where files are written (required)
+ *  - period: seconds between writes (default 10)
+ *  - formats: "prometheus" (plume_<session>_<rank>.prom, replaced atomically for textfile collectors) and/or "json"
+ *    (plume_<session>_<rank>.jsonl, one line appended per write), both by default
+ *  - aggregate: also write the sums over the ranks at the end of the run (plume_<session>_all.prom / .jsonl)
+ *
+ * Files are named after the session (its id) so that the writers of several sessions do not overwrite each other.
+ * The metrics are enabled for the lifetime of the writer.
+ *
+ * The writer thread never communicates, the aggregation (collective) is done by `finish`.
+ */
+class MetricsWriter : private eckit::NonCopyable {
+
+public:
+
+    MetricsWriter(const eckit::LocalConfiguration& config, std::size_t rank, std::size_t session = 0);
+
+    /// Stops the thread without a final write
+    ~MetricsWriter();
+
+    /// Writes the metrics of this rank now.
+    void write();
+
+    /// Stops the thread, writes the final metrics of this rank then, if configured, the sums over the ranks (collective).
+    void finish(const eckit::mpi::Comm& comm = eckit::mpi::comm());
+
+    const std::string& directory() const { return directory_; }
+
+private:
+
+    void loop();
+
+    void stop();
+
+    void writeFiles(const std::vector<Metrics::Sample>& samples, const std::string& suffix, const std::string& rank);
+
+    std::string directory_;
+    std::chrono::milliseconds period_;
+    bool prometheus_ = true;
+    bool json_       = true;
+    bool aggregate_  = false;
+    std::size_t rank_;
+    std::string prefix_;  // of the files, with the session
+    bool enabled_ = false;
+
+    std::mutex mutex_;
+    std::mutex writeMutex_;  // serialises the writes of the thread and of the caller
+    std::condition_variable wakeup_;
+    bool stopping_ = false;
+    std::thread thread_;
+};
+
+}  // namespace plume
@@ -20,8 +20,8 @@ namespace plume {
 
 bool Negotiator::isParamOffered(const Protocol& offers, const data::ParameterDefinition& param) {
     eckit::Log::info() << " - Considering Parameter: " << param.name() << std::endl;
-    if (!offers.isParamOffered(param.name())) {
-        if (offers.isParamOffered(param.sourceParam())) {
+    if (!offers.isParamOffered(param.id())) {
+        if (offers.isParamOffered(data::ParamId::find(param.sourceParam()))) {
             // it is a derived param whose source is offered
             for (const auto& dependency : param.dependencies()) {
                 if (!offers.isParamOffered(dependency)) {
@@ -24,7 +24,7 @@ class PluginConfig : public CheckedConfigurable {
 public:
 
     PluginConfig(const eckit::Configuration& config) : 
-        CheckedConfigurable{config, {"name", "lib"}, {"parameters", "core-config"}} {
+        CheckedConfigurable{config, {"name", "lib"}, {"parameters", "core-config", "skip-empty-regions"}} {
             if (!hasValidParameterFormat(config)) {
                 throw eckit::BadValue("PluginConfig: parameters must be a list of configurations", Here());
             }
@@ -38,7 +38,7 @@ public:
      * @return false 
      */
     static bool isValid(const eckit::Configuration& config) {
-        return CheckedConfigurable::isValid(config, {"name", "lib"}, {"parameters", "core-config"}) && hasValidParameterFormat(config);
+        return CheckedConfigurable::isValid(config, {"name", "lib"}, {"parameters", "core-config", "skip-empty-regions"}) && hasValidParameterFormat(config);
     }
 
     /**
@@ -81,6 +81,18 @@ public:
         return config().getSubConfiguration("core-config");
     }
 
+    /**
+     * @brief whether the plugincore is not run on partitions where all its regional (area) parameters have no points
+     * 
+     * @note Only for plugincores that do not communicate across partitions during run
+     * 
+     * @return true 
+     * @return false 
+     */
+    bool skipEmptyRegions() const {
+        return config().getBool("skip-empty-regions", false);
+    }
+
 private:
 
     static bool hasValidParameterFormat(const eckit::Configuration& config) {
@@ -25,6 +25,7 @@ std::string PluginCore::name() const {
 // grab the data that it needs
 void PluginCore::grabData(const data::ModelData& data) {
     modelData_ = data;
+    affinity_  = ThreadAffinity::current();
 };
 
 
@@ -33,6 +34,106 @@ data::ModelData& PluginCore::modelData() {
 }
 
 
+bool PluginCore::pinThread() const {
+    return affinity_.pinCurrentThread();
+}
+
+
+void PluginCore::onUpdate(const std::vector<std::string>& params, UpdateCallback callback) {
+    ASSERT_MSG(!params.empty(), "PluginCore: update callback needs at least one parameter");
+    ASSERT_MSG(callback, "PluginCore: update callback is empty");
+
+    UpdateSubscription subscription{params, {}, std::move(callback)};
+    for (const auto& param : params) {
+        if (!modelData_.hasParameter(param)) {
+            throw eckit::BadParameter("PluginCore: cannot subscribe to parameter '" + param +
+                                          "', not found in the plugincore data",
+                                      Here());
+        }
+        // only updates happening from now on trigger the callback
+        subscription.generations.push_back(modelData_.generation(param));
+    }
+    subscriptions_.push_back(std::move(subscription));
+}
+
+
+size_t PluginCore::dispatchUpdates() {
+    size_t invoked = 0;
+    for (auto& subscription : subscriptions_) {
+        bool updated = false;
+        for (size_t i = 0; i < subscription.params.size(); ++i) {
+            auto generation = modelData_.generation(subscription.params[i]);
+            if (generation != subscription.generations[i]) {
+                subscription.generations[i] = generation;
+                updated                     = true;
+            }
+        }
+        if (updated) {
+            subscription.callback();
+            ++invoked;
+        }
+    }
+    return invoked;
+}
+
+
+// ---------------------------------------------------------
+IncrementalPluginCore::IncrementalPluginCore(const eckit::Configuration& config, std::size_t period) :
+    PluginCore(config), period_{period} {
+    ASSERT_MSG(period_ > 0, "IncrementalPluginCore: the period must be at least one step");
+}
+
+
+void IncrementalPluginCore::run() {
+
+    // a new cycle on due steps (the previous one has completed on the last step of its period)
+    const std::size_t phase = step_++ % period_;
+    if (phase == 0) {
+        chunks_ = startCycle();
+        done_   = 0;
+    }
+    if (done_ >= chunks_) {
+        return;
+    }
+
+    // spread the remaining chunks evenly over the remaining steps, the last step finishes the cycle
+    const std::size_t stepsLeft = period_ - phase;
+    budget_                     = Budget::max();
+    if (stepsLeft > 1) {
+        const std::size_t share = (chunks_ - done_ + stepsLeft - 1) / stepsLeft;
+        budget_ = std::chrono::duration_cast<Budget>(std::chrono::duration<double>(secondsPerChunk_ * share));
+    }
+
+    const std::size_t before = done_;
+    sliceStart_              = std::chrono::steady_clock::now();
+    done_                    = runIncremental(budget_);
+    const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - sliceStart_;
+
+    if (done_ <= before || done_ > chunks_) {
+        throw eckit::SeriousBug("IncrementalPluginCore: runIncremental must process at least one chunk, and at most "
+                                "the chunks of the cycle",
+                                Here());
+    }
+    if (stepsLeft == 1 && done_ != chunks_) {
+        throw eckit::SeriousBug("IncrementalPluginCore: the cycle must complete on the last step of its period", Here());
+    }
+
+    // moving average of the time per chunk
+    const double measured = elapsed.count() / static_cast<double>(done_ - before);
+    secondsPerChunk_      = secondsPerChunk_ > 0. ? 0.5 * (secondsPerChunk_ + measured) : measured;
+}
+
+
+double IncrementalPluginCore::progress() const {
+    return chunks_ > 0 ? static_cast<double>(done_) / static_cast<double>(chunks_) : 1.;
+}
+
+
+bool IncrementalPluginCore::withinBudget() const {
+    return budget_ == Budget::max() || std::chrono::steady_clock::now() - sliceStart_ < budget_;
+}
+
+
 // ---------------------------------------------------------
 PluginCoreFactory::PluginCoreFactory() {}
 
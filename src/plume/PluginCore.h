@@ -10,13 +10,18 @@
  */
 #pragma once
 
+#include <chrono>
+#include <cstdint>
+#include <functional>
 #include <iostream>
 #include <map>
 #include <string>
+#include <vector>
 
 #include "eckit/config/Configuration.h"
 #include "eckit/exception/Exceptions.h"
 
+#include "plume/ThreadAffinity.h"
 #include "plume/data/ModelData.h"
 
 
@@ -88,13 +93,137 @@ public:
      */
     virtual void run() = 0;
 
+    /**
+     * @brief Invoke the update callbacks whose parameters have been updated since their last invocation
+     * (called by the manager after run)
+     * 
+     * @return number of callbacks invoked
+     */
+    size_t dispatchUpdates();
+
+    bool hasUpdateCallbacks() const { return !subscriptions_.empty(); }
+
 protected:
 
+    using UpdateCallback = std::function<void()>;
+
+    /**
+     * @brief Subscribe a callback to updates of some parameters (typically from setup).
+     * The callback is invoked once per run in which at least one of the parameters has been updated.
+     * 
+     * @param params names of the parameters (as in the model data grabbed by this plugincore)
+     * @param callback
+     */
+    void onUpdate(const std::vector<std::string>& params, UpdateCallback callback);
+
     data::ModelData& modelData();
 
+    /**
+     * @brief Pin the calling thread to the cores configured for Plume threads.
+     * Plugincores spawning their own threads should call this from each of them.
+     * 
+     * @return true if the thread affinity has been changed
+     */
+    bool pinThread() const;
+
 private:
 
     data::ModelData modelData_;
+
+    // placement of the session that fed this plugincore
+    ThreadAffinity affinity_;
+
+    // parameters subscribed to and generations seen at the last invocation of the callback
+    struct UpdateSubscription {
+        std::vector<std::string> params;
+        std::vector<std::uint64_t> generations;
+        UpdateCallback callback;
+    };
+
+    std::vector<UpdateSubscription> subscriptions_;
+};
+
+
+/**
+ * @brief A plugincore whose work (e.g. a large product) is due every `period` steps,
+ * and is spread in chunks (e.g. latitude bands) over the steps of the period
+ * 
+ * On each due step a new cycle starts (`startCycle`), then each run gives the plugincore
+ * a time slice to process some chunks (`runIncremental`). Slices are sized from the time
+ * per chunk measured so far, so that the remaining chunks are spread evenly over the
+ * remaining steps. The last step of a period has no time limit, so that the cycle always
+ * completes before the next due step.
+ * 
+ */
+class IncrementalPluginCore : public PluginCore {
+
+public:
+
+    using Budget = std::chrono::nanoseconds;
+
+    /**
+     * @brief Construct a new IncrementalPluginCore object
+     * 
+     * @param config 
+     * @param period number of steps between two cycles (1: the whole cycle runs on each step)
+     */
+    IncrementalPluginCore(const eckit::Configuration& config, std::size_t period);
+
+    std::size_t period() const { return period_; }
+
+    /**
+     * @brief Schedules the chunks of the current cycle (do not override, see runIncremental)
+     * 
+     */
+    void run() final;
+
+    /**
+     * @brief Fraction of the chunks of the current cycle processed so far
+     * 
+     * @return double in [0, 1]
+     */
+    double progress() const;
+
+protected:
+
+    /**
+     * @brief Starts a new cycle of work (e.g. takes a snapshot of its data)
+     * 
+     * @return number of chunks of the cycle
+     */
+    virtual std::size_t startCycle() = 0;
+
+    /**
+     * @brief Processes chunks of the current cycle within a time slice
+     * 
+     * At least one chunk must be processed per call, and further chunks only while `withinBudget()`.
+     * 
+     * @param budget time slice of this step (unlimited on the last step of the period)
+     * @return number of chunks of the cycle processed so far
+     */
+    virtual std::size_t runIncremental(Budget budget) = 0;
+
+    /**
+     * @brief whether the time slice of the current `runIncremental` call has time left
+     * 
+     */
+    bool withinBudget() const;
+
+private:
+
+    std::size_t period_;
+
+    // steps run, chunks of the current cycle and chunks processed
+    std::size_t step_   = 0;
+    std::size_t chunks_ = 0;
+    std::size_t done_   = 0;
+
+    // measured time per chunk (moving average, zero until measured)
+    double secondsPerChunk_ = 0.;
+
+    // time slice of the current call
+    std::chrono::steady_clock::time_point sliceStart_;
+    Budget budget_{0};
 };
 
 
@@ -8,7 +8,10 @@
  * granted to it by virtue of its status as an intergovernmental organisation nor
  * does it submit to any jurisdiction.
  */
+#include "plume/Metrics.h"
 #include "plume/PluginHandler.h"
+#include "plume/Probes.h"
+#include "plume/Tracer.h"
 
 namespace plume {
 
@@ -46,16 +49,48 @@ void PluginHandler::grabData(const data::ModelData& data) {
 
 
 void PluginHandler::setup() {
+    Tracer::Scope trace("plugin", "setup", pluginRef_.name());
     plugincorePtr_->setup();
 }
 
 
 void PluginHandler::run() {
+    Tracer::Scope trace("plugin", "run", pluginRef_.name());
+    Metrics::Timer timer(Metrics::pluginRunSeconds, pluginRef_.name());
+    PLUME_PROBE(run__begin, pluginRef_.name().c_str(), Tracer::currentStep());
     plugincorePtr_->run();
+    PLUME_PROBE(run__end, pluginRef_.name().c_str(), Tracer::currentStep());
+}
+
+
+size_t PluginHandler::dispatchUpdates() {
+    Tracer::Scope trace("plugin", "updates", pluginRef_.name());
+    return plugincorePtr_->dispatchUpdates();
+}
+
+
+bool PluginHandler::hasUpdateCallbacks() const {
+    return plugincorePtr_->hasUpdateCallbacks();
+}
+
+
+bool PluginHandler::skipsEmptyRegions() const {
+    return config_.skipEmptyRegions();
+}
+
+
+void PluginHandler::setIdle(bool idle) {
+    idle_ = idle;
+}
+
+
+bool PluginHandler::isIdle() const {
+    return idle_;
 }
 
 
 void PluginHandler::teardown() {
+    Tracer::Scope trace("plugin", "teardown", pluginRef_.name());
     plugincorePtr_->teardown();
 }
 
@@ -88,6 +88,34 @@ public:
      */
     void run();
 
+    /**
+     * @brief invoke the plugincore update callbacks whose parameters have been updated
+     * 
+     * @return number of callbacks invoked
+     */
+    size_t dispatchUpdates();
+
+    /**
+     * @brief whether the plugincore subscribed to parameter updates
+     * 
+     */
+    bool hasUpdateCallbacks() const;
+
+    /**
+     * @brief whether the plugincore is not run on partitions without points in its regions (see PluginConfig)
+     * 
+     */
+    bool skipsEmptyRegions() const;
+
+    /**
+     * @brief an idle plugincore is set up and torn down, but not run
+     * 
+     * @param idle 
+     */
+    void setIdle(bool idle);
+
+    bool isIdle() const;
+
     /**
      * @brief teardown the plugincore
      * 
@@ -113,6 +141,9 @@ private:
 
     // offered parameters
     PluginDecision decision_;
+
+    // nothing to do on this partition
+    bool idle_ = false;
 };
 
 }  // namespace plume
\ No newline at end of file
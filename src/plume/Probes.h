@@ -0,0 +1,36 @@
+/*
+ * (C) Copyright 2025- ECMWF.
+ *
+ * This software is licensed under the terms of the Apache Licence Version 2.0
+ * which can be obtained at http://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * In applying this licence, ECMWF does not waive the privileges and immunities
+ * granted to it by virtue of its status as an intergovernmental organisation nor
+ * does it submit to any jurisdiction.
+ */
+#pragma once
+
+#include "plume/plume_config.h"
+
+/**
+ * User-space static probes (USDT) of the provider `plume`, for perf and bpftrace on running jobs.
+ *
+ * Built with ENABLE_USDT (when sys/sdt.h is found), a probe is a single NOP until a tracer attaches to it, so they
+ * are kept in production builds. Otherwise probes and their arguments compile to nothing. Probes are listed with
+ * e.g. `bpftrace -l 'usdt:/path/to/libplume_plugin.so:plume:*'`:
+ *
+ *  - plume:commit (step, number of params)              on ModelData::setUpdated
+ *  - plume:strategy__begin, plume:strategy__end (type)  around update strategies (mangled type name)
+ *  - plume:run__begin, plume:run__end (plugin, step)    around the run of a plugincore
+ *  - plume:negotiate (plugin, accepted)                 on each negotiation decision
+ *
+ * String arguments are char pointers, steps are the session steps (the model step of the params for commits).
+ */
+#if PLUME_HAVE_USDT
+#include <sys/sdt.h>
+#define PLUME_PROBE(name, ...) STAP_PROBEV(plume, name, __VA_ARGS__)
+#else
+#define PLUME_PROBE(name, ...) \
+    do {                       \
+    } while (0)
+#endif
@@ -29,6 +29,7 @@ Protocol::Protocol(const eckit::Configuration& config) {
     setParamsFromConfig(config);
     requestedPlumeVersion_ = config.getString("requestedPlumeVersion", "0.0.0");
     requestedAtlasVersion_ = config.getString("requestedAtlasVersion", "0.0.0");
+    requiredWorkingSet_    = config.getUnsigned("requiredWorkingSet", 0);
     offeredPlumeVersion_   = config.getString("offeredPlumeVersion", plume_VERSION);
     offeredAtlasVersion_   = config.getString("offeredAtlasVersion", atlas::library::version());
 }
@@ -46,10 +47,18 @@ void Protocol::requireAtlasVersion(const std::string& version) {
     requestedAtlasVersion_ = version;
 }
 
+void Protocol::requireWorkingSet(std::size_t bytes) {
+    requiredWorkingSet_ = bytes;
+}
+
 std::set<std::string> Protocol::requiredParamNames() const {
     return requiredParams_.getParamNames();
 }
 
+std::size_t Protocol::requiredWorkingSet() const {
+    return requiredWorkingSet_;
+}
+
 const std::string& Protocol::requiredPlumeVersion() const {
     return requestedPlumeVersion_;
 }
@@ -62,6 +71,10 @@ bool Protocol::isParamRequired(const std::string& name) const {
     return requiredParams_.hasParam(name);
 }
 
+bool Protocol::isParamRequired(data::ParamId id) const {
+    return requiredParams_.hasParam(id);
+}
+
 const data::ParameterCatalogue& Protocol::requires() const {
     return requiredParams_;
 }
@@ -75,6 +88,19 @@ void Protocol::offerAtlasVersion(const std::string& version) {
     offeredAtlasVersion_ = version;
 }
 
+void Protocol::offerFieldSet(const atlas::FieldSet& fields, const std::string& avail, const std::string& comment) {
+    for (atlas::idx_t i = 0; i < fields.size(); ++i) {
+        const atlas::Field& field = fields[i];
+        std::vector<long> shape(field.shape().begin(), field.shape().end());
+        offer<atlas::Field>(field.name(), avail, comment, shape, field.datatype().str());
+    }
+}
+
+void Protocol::offerArray(const std::string& name, const std::string& avail, const std::string& comment,
+                          const data::ArrayView& view) {
+    offer<data::ArrayView>(name, avail, comment, view.shape(), view.datatype());
+}
+
 std::set<std::string> Protocol::offeredParamNames() const {
     return offeredParams_.getParamNames();
 }
@@ -90,6 +116,10 @@ bool Protocol::isParamOffered(const std::string& name) const {
     return offeredParams_.hasParam(name);
 }
 
+bool Protocol::isParamOffered(data::ParamId id) const {
+    return offeredParams_.hasParam(id);
+}
+
 const data::ParameterCatalogue& Protocol::offers() const {
     return offeredParams_;
 }
@@ -97,7 +127,7 @@ const data::ParameterCatalogue& Protocol::offers() const {
 
 
 void Protocol::insertParam(const data::ParameterDefinition& param, data::ParameterCatalogue& catalogue) {
-    if (!catalogue.hasParam(param.name())) {
+    if (!catalogue.hasParam(param.id())) {
         catalogue.insertParam(param);
     }
     else {
@@ -16,6 +16,9 @@
 #include <vector>
 
 #include "eckit/config/Configuration.h"
+
+#include "atlas/field/FieldSet.h"
+
 #include "plume/data/ParameterCatalogue.h"
 #include "plume/data/ParameterType.h"
 
@@ -35,6 +38,7 @@ private:
     std::string requestedPlumeVersion_;
     std::string requestedAtlasVersion_;
     data::ParameterCatalogue requiredParams_;
+    std::size_t requiredWorkingSet_ = 0;
 
     std::string offeredPlumeVersion_;
     std::string offeredAtlasVersion_;
@@ -78,11 +82,18 @@ public:
         insertParam(data::ParameterDefinition(name, data::deduceType<T>(), options), requiredParams_);
     }
 
+    /**
+     * @brief Lets plugins declare the memory they allocate on each rank (bytes), on top of the params they require.
+     */
+    void requireWorkingSet(std::size_t bytes);
+
     std::set<std::string> requiredParamNames() const;
+    std::size_t requiredWorkingSet() const;
     const std::string& requiredPlumeVersion() const;
     const std::string& requiredAtlasVersion() const;
 
     bool isParamRequired(const std::string& name) const;
+    bool isParamRequired(data::ParamId id) const;
     const data::ParameterCatalogue& requires() const;
 
 
@@ -95,11 +106,34 @@ public:
         insertParam(data::ParameterDefinition(name, data::deduceType<T>(), avail, comment), offeredParams_);
     }
 
+    /**
+     * @brief Offers a field of a given local shape and datatype (e.g. "real64"), to project the memory of the params
+     * derived from it.
+     */
+    template <typename T>
+    void offer(const std::string& name, const std::string& avail, const std::string& comment,
+               const std::vector<long>& shape, const std::string& datatype) {
+        insertParam(data::ParameterDefinition(name, data::deduceType<T>(), avail, comment, shape, datatype),
+                    offeredParams_);
+    }
+
+    /**
+     * @brief Offers all the fields of a field set (named as the fields), with their local shape and datatype.
+     */
+    void offerFieldSet(const atlas::FieldSet& fields, const std::string& avail, const std::string& comment);
+
+    /**
+     * @brief Offers a strided array of the model (type ARRAY), with the shape and datatype of its view.
+     */
+    void offerArray(const std::string& name, const std::string& avail, const std::string& comment,
+                    const data::ArrayView& view);
+
     std::set<std::string> offeredParamNames() const;
     const std::string& offeredPlumeVersion() const;
     const std::string& offeredAtlasVersion() const;
 
     bool isParamOffered(const std::string& name) const;
+    bool isParamOffered(data::ParamId id) const;
     const data::ParameterCatalogue& offers() const;
 };
 
@@ -0,0 +1,488 @@
+/*
+ * (C) Copyright 2025- ECMWF.
+ *
+ * This software is licensed under the terms of the Apache Licence Version 2.0
+ * which can be obtained at http://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * In applying this licence, ECMWF does not waive the privileges and immunities
+ * granted to it by virtue of its status as an intergovernmental organisation nor
+ * does it submit to any jurisdiction.
+ */
+#include <algorithm>
+#include <atomic>
+#include <cstdlib>
+#include <memory>
+#include <vector>
+
+#include "eckit/exception/Exceptions.h"
+#include "eckit/log/Log.h"
+#include "eckit/mpi/Comm.h"
+#include "eckit/system/LibraryManager.h"
+
+#include "plume/Negotiator.h"
+#include "plume/PluginConfig.h"
+#include "plume/PluginCore.h"
+#include "plume/PluginHandler.h"
+#include "plume/Probes.h"
+#include "plume/Session.h"
+#include "plume/Tracer.h"
+#include "plume/data/DataChecker.h"
+#include "plume/data/FieldProvider.h"
+
+
+namespace plume {
+
+namespace {
+
+// whether a plugin requested regional subsets, none of which has points on this partition
+bool hasOnlyEmptyRegions(const PluginHandler& pluginHandler, const data::ModelData& data) {
+    bool regional = false;
+    for (const auto& param : pluginHandler.getRequiredParams()) {
+        if (param.strategy() != field_provider::UpdateStrategyTraits<field_provider::AreaSubset>::name) {
+            continue;
+        }
+        regional = true;
+        if (data.getParam<atlas::Field>(param.name()).shape(0) > 0) {
+            return false;
+        }
+    }
+    return regional;
+}
+
+}  // namespace
+
+/**
+ * @brief Plugins activated by a session
+ *
+ */
+class PluginRegistry {
+
+public:
+
+    void setActive(Plugin& plugin, const PluginConfig& pconfig, const PluginDecision& decision) {
+
+        std::string name = plugin.plugincoreName();
+
+        // create a plugin handler
+        PluginHandler pluginHandle(plugin, pconfig, decision);
+
+        // instantiate the plugincore (the plugin handler takes ownership of it)
+        pluginHandle.activate(
+            std::unique_ptr<PluginCore>(plume::PluginCoreFactory::instance().build(name, pconfig.coreConfig())));
+
+        // plugin added to the active plugin list
+        pluginHandlers_.push_back(std::move(pluginHandle));
+        activeParams_.reset();
+    }
+
+    // get the active Plugins
+    std::vector<PluginHandler>& getActivePlugins() { return pluginHandlers_; }
+
+    const std::vector<PluginHandler>& getActivePlugins() const { return pluginHandlers_; }
+
+    // Parameters requested by all active plugins collectively (computed once after the activations)
+    const std::unordered_set<std::string>& getActiveParams(bool derived = true) const {
+        if (!activeParams_) {
+            activeParams_.emplace();
+            for (const auto& pluginHandle : pluginHandlers_) {
+                for (const auto& name : pluginHandle.getRequiredParamNames(true)) {
+                    activeParams_->all.insert(name);
+                    activeParams_->ids.insert(data::ParamId(name));
+                }
+                auto sources = pluginHandle.getRequiredParamNames(false);
+                activeParams_->sources.insert(sources.begin(), sources.end());
+            }
+        }
+        return derived ? activeParams_->all : activeParams_->sources;
+    }
+
+    bool isParamRequested(const std::string& name) const {
+        getActiveParams();
+        return activeParams_->ids.count(data::ParamId::find(name)) > 0;
+    }
+
+    data::ParameterCatalogue getActiveDataCatalogue(bool derived = true) const {
+        return dataCatalogue_.filter(getActiveParams(derived));
+    }
+
+    void setDataCatalogue(const data::ParameterCatalogue& dataCatalogue) { dataCatalogue_ = dataCatalogue; }
+
+    const data::ParameterCatalogue& getDataCatalogue() const { return dataCatalogue_; }
+
+private:
+    // List of active plugins
+    std::vector<PluginHandler> pluginHandlers_;
+
+    // stores a copy of the data catalogue that
+    // resulted in the activated plugins
+    data::ParameterCatalogue dataCatalogue_;
+
+    struct ActiveParams {
+        std::unordered_set<std::string> all;      // including derived params
+        std::unordered_set<std::string> sources;  // without derived params
+        std::unordered_set<data::ParamId> ids;    // of all
+    };
+    mutable std::optional<ActiveParams> activeParams_;
+};
+// -------------------------------------------------------------------
+
+
+namespace {
+
+// sessions of the process, in order of creation
+std::atomic<std::size_t> sessions_{0};
+
+}  // namespace
+
+
+Session::Session() :
+    id_{sessions_++}, registry_{std::make_unique<PluginRegistry>()}, tracer_{std::make_shared<Tracer>()} {}
+
+Session::~Session() = default;
+
+
+Session& Session::defaultSession() {
+    static Session session;
+    return session;
+}
+
+
+void Session::configure(const eckit::Configuration& config) {
+    if (!managerConfig_) {
+        ManagerConfig managerConfig(config);
+
+        // communicator of the collectives of the session
+        commName_ = managerConfig.commName();
+        if (!commName_.empty() && !eckit::mpi::hasComm(commName_.c_str())) {
+            throw eckit::BadValue("Session: unknown communicator " + commName_, Here());
+        }
+
+        // placement and pool of the threads created by this session (and its plugins)
+        affinity_          = managerConfig.threadAffinity();
+        threadPool_        = std::make_shared<ThreadPool>(managerConfig.threadCount(), affinity_);
+        parallelCallbacks_ = managerConfig.parallelCallbacks();
+        eckit::Log::info() << "Plume threads: " << affinity_ << ", pool size: " << threadPool_->size()
+                           << std::endl;
+
+        // timeline of the lifecycle (the configuration takes precedence over the environment)
+        std::string tracePath = managerConfig.tracePath();
+        if (tracePath.empty()) {
+            const char* env = std::getenv(Tracer::environment);
+            tracePath       = env ? env : "";
+        }
+        if (!tracePath.empty()) {
+            tracer_->enable(tracePath);
+            eckit::Log::info() << "Plume trace enabled, written to " << tracePath << " at teardown" << std::endl;
+        }
+
+        if (managerConfig.exportMetrics()) {
+            metricsWriter_ = std::make_unique<MetricsWriter>(managerConfig.metricsConfig(), comm().rank(), id_);
+            eckit::Log::info() << "Plume metrics written to " << metricsWriter_->directory() << std::endl;
+        }
+
+        managerConfig_ = std::move(managerConfig);
+    }
+}
+
+
+// load a plugin from a shared library
+Plugin& Session::loadPlugin(const std::string& lib, const std::string& name) {
+    Tracer::Scope trace("session", "load", name);
+
+    void* libHandle = eckit::system::LibraryManager::loadLibrary(lib);
+    if (!libHandle) {
+        throw eckit::BadValue("Loading library " + lib + " failed!", Here());
+    }
+
+    eckit::Log::info() << "Loading Library: " << lib << " containing Plugin: " << name << std::endl;
+
+    // here we are loading a Plume plugin
+    Plugin& plugin = dynamic_cast<Plugin&>(eckit::system::LibraryManager::loadPlugin(name));
+
+    return plugin;
+}
+
+
+// Negotiate with all candidate plugins
+void Session::negotiate(const Protocol& offers) {
+
+    // before negotiation, make sure the session has been configured
+    ASSERT_MSG(isConfigured(), "Plume manager needs to be configured first!");
+    Tracer::Install install(tracer_.get());
+    Tracer::Scope trace("session", "negotiate");
+
+    auto pnames = offers.offeredParamNames();
+    std::vector<std::string> names(pnames.begin(), pnames.end());
+    eckit::Log::info() << "Plume config: " << *managerConfig_ << ", offers: " << names << std::endl;
+
+    // Negotiate with each plugin
+    Negotiator negotiator;
+    memoryBudget_ = managerConfig_->memoryBudget();
+
+    // Load all selected plugins as per configuration
+    for (const auto& pconfig : managerConfig_.value().plugins()) {
+
+        auto name = pconfig.name();
+        auto lib  = pconfig.lib();
+
+        eckit::Log::info() << std::endl << " <== Evaluating Plugin: " << name << " from Library: " << lib << std::endl;
+
+        // Load the plugin
+        Plugin& plugin = loadPlugin(lib, name);
+
+        // check what each plugin requires
+        Protocol requires = plugin.negotiate();
+
+        // Check plugin parameters requested through configuration (if any)
+        auto config_params = pconfig.parameters();
+        if (config_params.size() > 0) {
+            eckit::Log::info() << "Parameters from Config: " << config_params << std::endl;
+        }
+        else {
+            eckit::Log::info() << "No additional parameters found in Config." << std::endl;
+        }
+
+        // negotiator handles the negotiation
+        PluginDecision decision = negotiator.negotiate(offers, requires, config_params);
+        eckit::Log::info() << decision << std::endl;
+        PLUME_PROBE(negotiate, name.c_str(), static_cast<int>(decision.accepted()));
+
+        // If the plugin is accepted (and fits in the memory budget of all the ranks), set it as active
+        if (decision.accepted()) {
+            auto estimate = memoryBudget_.estimate(name, offers, decision, requires.requiredWorkingSet());
+            if (memoryBudget_.admit(MemoryBudget::largest(estimate, comm()), decision)) {
+                registry_->setActive(plugin, pconfig, decision);
+            }
+        }
+    }
+
+    memoryBudget_.report(eckit::Log::info());
+
+    registry_->setDataCatalogue(offers.offers());
+
+    // the active params are fixed from now on
+    registry_->getActiveParams();
+}
+
+
+// Let each plugin take its own share of data (pointers)
+void Session::feedPlugins(data::ModelData& data) {
+
+    ThreadAffinity::Scope scope(affinity_);
+    Tracer::Install install(tracer_.get());
+    Tracer::Scope trace("session", "feed");
+
+    // check data
+    checkData(data);
+
+    // the strategies of the data run their collectives on the communicator of the session, are traced with the
+    // session, and may use its threads
+    data.strategyContext()->setComm(comm());
+    data.strategyContext()->setTracer(tracer_);
+    data.strategyContext()->setThreadPool(threadPool_);
+    strategyContexts_.push_back(data.strategyContext());
+
+    // Run each PluginCore for every active plugin
+    for (auto& pluginHandler : registry_->getActivePlugins()) {
+        // Create derived fields if requested
+        // Will do nothing if a previous plugin has already triggered the parameter creation
+        for (const auto& requestedParam : pluginHandler.getRequiredParams()) {
+            if (!requestedParam.strategy().empty()) {
+                data.dispatchCreateParam(requestedParam.strategy(), requestedParam.config());
+            }
+        }
+
+        // get the share of run data needed to run the plugincore
+        auto requiredParams          = pluginHandler.getRequiredParamNames();
+        data::ModelData requiredData = data.filter(requiredParams);
+
+        if (pluginHandler.skipsEmptyRegions()) {
+            pluginHandler.setIdle(hasOnlyEmptyRegions(pluginHandler, requiredData));
+            if (pluginHandler.isIdle()) {
+                eckit::Log::info() << "Plugin " << pluginHandler.pluginName()
+                                   << " has no points in its regions on this partition and will not run" << std::endl;
+            }
+        }
+
+        // profile the reads of the negotiated params
+        if (managerConfig_->profileAccess()) {
+            std::vector<std::string> profiled;
+            for (const auto& param : requiredParams) {
+                if (requiredData.hasParameter(param)) {
+                    profiled.push_back(param);
+                }
+            }
+            auto profile = std::make_shared<data::AccessProfile>(profiled);
+            requiredData.setAccessProfile(profile);
+            accessProfiles_[pluginHandler.pluginName()] = profile;
+        }
+
+        // grab data
+        pluginHandler.grabData(requiredData);
+
+        // setup
+        pluginHandler.setup();
+    }
+}
+
+
+// Run all active plugincores
+void Session::run() {
+    ThreadAffinity::Scope scope(affinity_);
+    Tracer::Install install(tracer_.get());
+    tracer_->setStep(++step_);
+    Tracer::Scope trace("session", "run");
+    for (auto& [name, profile] : accessProfiles_) {
+        profile->newStep();
+    }
+
+    auto& pluginHandlers = registry_->getActivePlugins();
+    for (auto& pluginHandler : pluginHandlers) {
+        if (!pluginHandler.isIdle()) {
+            pluginHandler.run();
+        }
+        else if (Metrics::instance().enabled()) {
+            Metrics::instance().counter(Metrics::stepsSkipped, pluginHandler.pluginName()).add();
+        }
+    }
+
+    // then the update callbacks whose parameters changed in this step
+    // (callbacks of different plugins may run concurrently, those of a plugin run in subscription order)
+    std::vector<PluginHandler*> subscribers;
+    for (auto& pluginHandler : pluginHandlers) {
+        if (!pluginHandler.isIdle() && pluginHandler.hasUpdateCallbacks()) {
+            subscribers.push_back(&pluginHandler);
+        }
+    }
+    Tracer::Scope updates("session", "updates");
+    if (parallelCallbacks_ && subscribers.size() > 1) {
+        threadPool_->parallelFor(subscribers.size(), [&](size_t i) { subscribers[i]->dispatchUpdates(); });
+    }
+    else {
+        for (auto* subscriber : subscribers) {
+            subscriber->dispatchUpdates();
+        }
+    }
+}
+
+
+// Teardown all active plugins
+void Session::teardown() {
+    ThreadAffinity::Scope scope(affinity_);
+    Tracer::Install install(tracer_.get());
+    {
+        Tracer::Scope trace("session", "teardown");
+        for (auto& pluginHandler : registry_->getActivePlugins()) {
+            // teardown the plugincore first
+            pluginHandler.teardown();
+        }
+    }
+
+    // collective, all the ranks of the session are traced
+    if (tracer_->enabled()) {
+        tracer_->write(comm());
+    }
+    if (metricsWriter_) {
+        metricsWriter_->finish(comm());
+        metricsWriter_.reset();
+    }
+
+    for (const auto& [name, profile] : accessProfiles_) {
+        eckit::Log::info() << "--- Plume parameters read by plugin " << name << ":" << std::endl;
+        profile->report(eckit::Log::info());
+    }
+
+    clearStrategyCaches();
+}
+
+
+bool Session::isPluginActivated(const std::string& name) const {
+    for (const auto& pluginHandler : registry_->getActivePlugins()) {
+        if (pluginHandler.pluginName() == name) {
+            return true;
+        }
+    }
+    return false;
+}
+
+
+std::unordered_set<std::string> Session::getActiveParams() const {
+    return registry_->getActiveParams();
+}
+
+
+data::ParameterCatalogue Session::getActiveDataCatalogue() const {
+    return registry_->getActiveDataCatalogue();
+}
+
+
+bool Session::isParamRequested(const std::string& name) const {
+    return registry_->isParamRequested(name);
+}
+
+
+bool Session::isConfigured() const {
+    return managerConfig_.has_value();
+}
+
+
+std::shared_ptr<const data::AccessProfile> Session::accessProfile(const std::string& pluginName) const {
+    auto it = accessProfiles_.find(pluginName);
+    return it != accessProfiles_.end() ? it->second : nullptr;
+}
+
+
+const eckit::mpi::Comm& Session::comm() const {
+    return commName_.empty() ? eckit::mpi::comm() : eckit::mpi::comm(commName_.c_str());
+}
+
+
+ThreadPool& Session::threadPool() {
+    ASSERT_MSG(threadPool_, "Plume session needs to be configured first!");
+    return *threadPool_;
+}
+
+
+void Session::checkData(const data::ModelData& data) const {
+
+    eckit::Log::info() << "--- Plume manager is checking data ..." << std::endl;
+    Tracer::Scope trace("session", "check");
+
+    // Check all requested params (regardless of whether they are "always-available" or "on-demand")
+    // Skip all derived params as they are not yet created
+    data::DataChecker::checkAllParams(data, registry_->getActiveDataCatalogue(false),
+                                      plume::data::CheckPolicyWarning{});
+
+    // Check that all the "always" params are present
+    data::DataChecker::checkAlwaysAvailParams(data, registry_->getDataCatalogue(), plume::data::CheckPolicyWarning{});
+
+    eckit::Log::info() << "--- Plume manager has checked data." << std::endl;
+}
+
+
+void Session::reset() {
+    registry_ = std::make_unique<PluginRegistry>();
+    managerConfig_.reset();
+    commName_.clear();
+    threadPool_.reset();
+    affinity_          = ThreadAffinity();
+    parallelCallbacks_ = false;
+    step_              = 0;
+    tracer_            = std::make_shared<Tracer>();
+    metricsWriter_.reset();
+    memoryBudget_ = MemoryBudget();
+    accessProfiles_.clear();
+    clearStrategyCaches();
+}
+
+
+void Session::clearStrategyCaches() {
+    for (const auto& context : strategyContexts_) {
+        if (auto alive = context.lock()) {
+            alive->clearCaches();
+        }
+    }
+    strategyContexts_.clear();
+}
+
+}  // namespace plume
@@ -0,0 +1,220 @@
+/*
+ * (C) Copyright 2025- ECMWF.
+ *
+ * This software is licensed under the terms of the Apache Licence Version 2.0
+ * which can be obtained at http://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * In applying this licence, ECMWF does not waive the privileges and immunities
+ * granted to it by virtue of its status as an intergovernmental organisation nor
+ * does it submit to any jurisdiction.
+ */
+#pragma once
+
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <optional>
+#include <string>
+#include <unordered_set>
+#include <vector>
+
+#include "eckit/config/Configuration.h"
+#include "eckit/memory/NonCopyable.h"
+#include "eckit/mpi/Comm.h"
+
+#include "plume/ManagerConfig.h"
+#include "plume/MemoryBudget.h"
+#include "plume/Metrics.h"
+#include "plume/Plugin.h"
+#include "plume/Protocol.h"
+#include "plume/ThreadAffinity.h"
+#include "plume/ThreadPool.h"
+#include "plume/Tracer.h"
+#include "plume/data/AccessProfile.h"
+#include "plume/data/ModelData.h"
+#include "plume/data/ParameterCatalogue.h"
+
+
+namespace plume {
+
+// fwd declaration
+class PluginRegistry;
+
+/**
+ * @brief An independent Plume instance: configuration, active plugins, data catalogue and thread pool.
+ *
+ * Several sessions can live in the same process, e.g. one per model component (atmosphere, waves) each with its
+ * own grid and its own set of plugins. The static Manager API is a facade over the default session.
+ *
+ * @note A session is not meant to be driven concurrently from several threads.
+ */
+class Session : private eckit::NonCopyable {
+
+public:
+
+    Session();
+
+    ~Session();
+
+    /**
+     * @brief The process-wide session used by the static Manager API
+     *
+     * @return Session&
+     */
+    static Session& defaultSession();
+
+    /**
+     * @brief configure the session (subsequent calls are ignored)
+     *
+     * @param config
+     */
+    void configure(const eckit::Configuration& config);
+
+    /**
+     * @brief Negotiate with Plugins
+     *
+     * The memory each accepted plugin adds on a rank is projected from the sizes of the offered fields, then checked
+     * against the `memory` budget (if configured), see MemoryBudget. The check is collective: a plugin is admitted on
+     * the largest projection of the ranks of the session, so that the same plugins are active on all of them.
+     *
+     * @param offers
+     */
+    void negotiate(const Protocol& offers);
+
+    /**
+     * @brief Let each plugin take its own share of data
+     *
+     * Derived parameters are created on the data, which stays open to other sessions until its first update freezes it
+     * (see ModelData::freeze). Sessions sharing the same data must all be fed before the first update.
+     *
+     * @param data
+     */
+    void feedPlugins(data::ModelData& data);
+
+    /**
+     * @brief run all active plugins, then the plugin update callbacks whose parameters have been updated
+     * (concurrently if `threads.parallel-callbacks` is configured)
+     *
+     */
+    void run();
+
+    /**
+     * @brief teardown all active plugins (and report the parameters read by each plugin, if profiled)
+     *
+     * The caches of the strategies created for the fed data are cleared.
+     */
+    void teardown();
+
+    bool isPluginActivated(const std::string& name) const;
+
+    std::unordered_set<std::string> getActiveParams() const;
+
+    data::ParameterCatalogue getActiveDataCatalogue() const;
+
+    bool isParamRequested(const std::string& name) const;
+
+    bool isConfigured() const;
+
+    /**
+     * @brief Reads of the parameters negotiated by a plugin (null unless `profiling.access` is configured)
+     *
+     * @param pluginName
+     * @return std::shared_ptr<const data::AccessProfile>
+     */
+    std::shared_ptr<const data::AccessProfile> accessProfile(const std::string& pluginName) const;
+
+    /**
+     * @brief Projected memory of the plugins evaluated at negotiation, per rank
+     *
+     * @return const MemoryBudget&
+     */
+    const MemoryBudget& memoryBudget() const { return memoryBudget_; }
+
+    /**
+     * @brief Placement of the threads of this session
+     *
+     * @return const ThreadAffinity&
+     */
+    const ThreadAffinity& threadAffinity() const { return affinity_; }
+
+    /**
+     * @brief Identifier of this session, in order of creation in the process (the default session is usually 0)
+     *
+     * @return std::size_t
+     */
+    std::size_t id() const { return id_; }
+
+    /**
+     * @brief Communicator of this session (the `comm` communicator if configured, the default one otherwise), the
+     *        collectives of the session (e.g. writing the trace) run on it
+     *
+     * @return const eckit::mpi::Comm&
+     */
+    const eckit::mpi::Comm& comm() const;
+
+    /**
+     * @brief Timeline of this session, installed on the threads running its calls, updates and tasks
+     *
+     * @return Tracer&
+     */
+    Tracer& tracer() { return *tracer_; }
+
+    /**
+     * @brief Pool of worker threads of this session (no workers unless `threads.count` is configured)
+     *
+     * @return ThreadPool&
+     */
+    ThreadPool& threadPool();
+
+private:
+
+    Plugin& loadPlugin(const std::string& lib, const std::string& name);
+
+    void checkData(const data::ModelData& data) const;
+
+    // clears the caches of the strategy contexts of the fed data
+    void clearStrategyCaches();
+
+    /**
+     * @brief Reset the session configuration, this method is only intended for use within tests.
+     */
+    void reset();
+
+    const std::size_t id_;
+
+    std::optional<ManagerConfig> managerConfig_;
+
+    std::unique_ptr<PluginRegistry> registry_;
+
+    // name of the communicator (empty for the default one)
+    std::string commName_;
+
+    ThreadAffinity affinity_;
+
+    // (shared with the strategy contexts of the fed data)
+    std::shared_ptr<ThreadPool> threadPool_;
+
+    bool parallelCallbacks_ = false;
+
+    // projected memory of the plugins
+    MemoryBudget memoryBudget_;
+
+    // periodic export of the overhead metrics (if configured)
+    std::unique_ptr<MetricsWriter> metricsWriter_;
+
+    // timeline of the session (shared with the strategy contexts of the fed data)
+    std::shared_ptr<Tracer> tracer_;
+
+    // steps run so far (traced events are tagged with it)
+    std::uint64_t step_ = 0;
+
+    // parameter reads per plugin (if profiled)
+    std::map<std::string, std::shared_ptr<data::AccessProfile>> accessProfiles_;
+
+    // strategy contexts of the data fed to the plugins (their caches are cleared at teardown)
+    std::vector<std::weak_ptr<data::StrategyContext>> strategyContexts_;
+
+    friend class Manager;
+};
+
+}  // namespace plume
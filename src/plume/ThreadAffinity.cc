@@ -0,0 +1,351 @@
+/*
+ * (C) Copyright 2025- ECMWF.
+ *
+ * This software is licensed under the terms of the Apache Licence Version 2.0
+ * which can be obtained at http://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * In applying this licence, ECMWF does not waive the privileges and immunities
+ * granted to it by virtue of its status as an intergovernmental organisation nor
+ * does it submit to any jurisdiction.
+ */
+#include <algorithm>
+#include <condition_variable>
+#include <fstream>
+#include <mutex>
+#include <sstream>
+#include <thread>
+
+#if defined(__linux__)
+#include <pthread.h>
+#include <sched.h>
+#endif
+#include <unistd.h>
+
+#include "eckit/exception/Exceptions.h"
+#include "eckit/log/Log.h"
+#include "eckit/utils/StringTools.h"
+
+#include "plume/ThreadAffinity.h"
+
+
+namespace plume {
+
+namespace {
+
+thread_local const ThreadAffinity* currentAffinity_ = nullptr;
+
+// Affinity mask of the process (of its main thread), empty if it cannot be queried
+std::vector<int> queryProcessCpus() {
+    std::vector<int> cpus;
+#if defined(__linux__)
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    if (sched_getaffinity(getpid(), sizeof(cpu_set_t), &set) == 0) {
+        for (int cpu = 0; cpu < CPU_SETSIZE; ++cpu) {
+            if (CPU_ISSET(cpu, &set)) {
+                cpus.push_back(cpu);
+            }
+        }
+    }
+#endif
+    return cpus;
+}
+
+// Saved when the library is loaded, before Plume pins any thread: the mask of a pinned thread is not the model's
+const std::vector<int> initialProcessCpus_ = queryProcessCpus();
+
+// Pins the calling thread to a list of cores, returns the error code (0 on success)
+int pinThread(const std::vector<int>& cpus) {
+#if defined(__linux__)
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    for (int cpu : cpus) {
+        CPU_SET(cpu, &set);
+    }
+    return pthread_setaffinity_np(pthread_self(), sizeof(cpu_set_t), &set);
+#else
+    return 0;  // placement is not controlled, as with `inherit`
+#endif
+}
+
+const char* modeToString(ThreadAffinity::Mode mode) {
+    switch (mode) {
+        case ThreadAffinity::Mode::CpuSet:
+            return "cpuset";
+        case ThreadAffinity::Mode::Spare:
+            return "spare";
+        default:
+            return "inherit";
+    }
+}
+
+}  // namespace
+
+
+/// Thread pinned to the Plume cores, running one initialisation at a time for its callers
+class ThreadAffinity::Toucher {
+public:
+    explicit Toucher(std::vector<int> cpus) : cpus_{std::move(cpus)} {}
+
+    ~Toucher() {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            stop_ = true;
+        }
+        ready_.notify_all();
+        if (thread_.joinable()) {
+            thread_.join();
+        }
+    }
+
+    Toucher(const Toucher&)            = delete;
+    Toucher& operator=(const Toucher&) = delete;
+
+    void run(const std::function<void()>& init) {
+        std::lock_guard<std::mutex> call(callMutex_);
+        std::unique_lock<std::mutex> lock(mutex_);
+        if (!thread_.joinable()) {
+            thread_ = std::thread([this]() { loop(); });
+        }
+        task_  = &init;
+        error_ = nullptr;
+        ready_.notify_all();
+        ready_.wait(lock, [this]() { return task_ == nullptr; });
+        if (error_) {
+            std::rethrow_exception(error_);
+        }
+    }
+
+private:
+    void loop() {
+        if (int rc = pinThread(cpus_); rc != 0) {
+            eckit::Log::warning() << "ThreadAffinity: failed to pin first-touch thread to cores "
+                                  << ThreadAffinity::formatCpuList(cpus_) << " (error " << rc << ")" << std::endl;
+        }
+        std::unique_lock<std::mutex> lock(mutex_);
+        while (true) {
+            ready_.wait(lock, [this]() { return stop_ || task_ != nullptr; });
+            if (stop_) {
+                return;
+            }
+            lock.unlock();
+            try {
+                (*task_)();
+            }
+            catch (...) {
+                error_ = std::current_exception();
+            }
+            lock.lock();
+            task_ = nullptr;
+            ready_.notify_all();
+        }
+    }
+
+    std::vector<int> cpus_;
+    std::thread thread_;
+
+    std::mutex callMutex_;  // one caller at a time
+    std::mutex mutex_;
+    std::condition_variable ready_;
+    const std::function<void()>* task_ = nullptr;
+    std::exception_ptr error_;
+    bool stop_ = false;
+};
+
+
+ThreadAffinity::ThreadAffinity() : mode_{Mode::Inherit}, numaFirstTouch_{false} {}
+
+
+ThreadAffinity::ThreadAffinity(const eckit::Configuration& config) : ThreadAffinity() {
+
+    if (!isValid(config)) {
+        throw eckit::BadValue("ThreadAffinity: threads configuration is not valid", Here());
+    }
+
+    std::string affinity = config.getString("affinity", "inherit");
+    numaFirstTouch_      = config.getBool("numa-first-touch", false);
+
+    if (affinity == "cpuset") {
+        mode_ = Mode::CpuSet;
+        cpus_ = parseCpuList(config.getString("cpuset"));
+
+        auto online = onlineCpus();
+        for (int cpu : cpus_) {
+            if (std::find(online.begin(), online.end(), cpu) == online.end()) {
+                throw eckit::BadValue("ThreadAffinity: cpu " + std::to_string(cpu) + " is not online", Here());
+            }
+        }
+    }
+    else if (affinity == "spare") {
+        mode_ = Mode::Spare;
+
+        auto online  = onlineCpus();
+        auto process = processCpus();
+        std::set_difference(online.begin(), online.end(), process.begin(), process.end(), std::back_inserter(cpus_));
+
+        if (cpus_.empty()) {
+            eckit::Log::warning() << "ThreadAffinity: no cores left outside the process mask "
+                                  << formatCpuList(process) << ", Plume threads will share the model cores"
+                                  << std::endl;
+            cpus_ = process;
+        }
+    }
+
+    // the thread itself is only started by the first initialisation
+    if (numaFirstTouch_ && !cpus_.empty()) {
+        toucher_ = std::make_shared<Toucher>(cpus_);
+    }
+}
+
+
+bool ThreadAffinity::isValid(const eckit::Configuration& config) {
+
+    std::string affinity = config.getString("affinity", "inherit");
+    if (affinity != "inherit" && affinity != "cpuset" && affinity != "spare") {
+        eckit::Log::error() << "Invalid thread affinity: " << affinity << " (inherit, cpuset or spare)" << std::endl;
+        return false;
+    }
+
+    // cpuset mode needs a list of cores, and only cpuset mode accepts one
+    if ((affinity == "cpuset") != config.has("cpuset")) {
+        eckit::Log::error() << "Key 'cpuset' must be given if and only if affinity is 'cpuset'" << std::endl;
+        return false;
+    }
+
+    return true;
+}
+
+
+bool ThreadAffinity::pinCurrentThread() const {
+    if (cpus_.empty()) {
+        return false;
+    }
+#if defined(__linux__)
+    int rc = pinThread(cpus_);
+    if (rc != 0) {
+        eckit::Log::warning() << "ThreadAffinity: failed to pin thread to cores " << formatCpuList(cpus_)
+                              << " (error " << rc << ")" << std::endl;
+        return false;
+    }
+    return true;
+#else
+    return false;
+#endif
+}
+
+
+void ThreadAffinity::firstTouch(const std::function<void()>& init) const {
+
+    if (!toucher_) {
+        init();
+        return;
+    }
+    toucher_->run(init);
+}
+
+
+std::vector<int> ThreadAffinity::processCpus() {
+    return initialProcessCpus_.empty() ? onlineCpus() : initialProcessCpus_;
+}
+
+
+std::vector<int> ThreadAffinity::onlineCpus() {
+#if defined(__linux__)
+    std::ifstream online("/sys/devices/system/cpu/online");
+    std::string list;
+    if (online && std::getline(online, list) && !list.empty()) {
+        return parseCpuList(list);
+    }
+#endif
+    long n = sysconf(_SC_NPROCESSORS_ONLN);
+    std::vector<int> cpus;
+    for (int cpu = 0; cpu < std::max(n, 1L); ++cpu) {
+        cpus.push_back(cpu);
+    }
+    return cpus;
+}
+
+
+std::vector<int> ThreadAffinity::parseCpuList(const std::string& list) {
+
+    std::vector<int> cpus;
+
+    for (const auto& token : eckit::StringTools::split(",", list)) {
+        auto range = eckit::StringTools::split("-", eckit::StringTools::trim(token));
+        if (range.empty() || range.size() > 2) {
+            throw eckit::BadValue("ThreadAffinity: invalid cpu list '" + list + "'", Here());
+        }
+        try {
+            int first = std::stoi(range.front());
+            int last  = std::stoi(range.back());
+            if (first < 0 || last < first) {
+                throw eckit::BadValue("ThreadAffinity: invalid cpu range '" + token + "'", Here());
+            }
+            for (int cpu = first; cpu <= last; ++cpu) {
+                cpus.push_back(cpu);
+            }
+        }
+        catch (const std::logic_error&) {
+            throw eckit::BadValue("ThreadAffinity: invalid cpu list '" + list + "'", Here());
+        }
+    }
+
+    std::sort(cpus.begin(), cpus.end());
+    cpus.erase(std::unique(cpus.begin(), cpus.end()), cpus.end());
+
+    if (cpus.empty()) {
+        throw eckit::BadValue("ThreadAffinity: empty cpu list", Here());
+    }
+
+    return cpus;
+}
+
+
+std::string ThreadAffinity::formatCpuList(const std::vector<int>& cpus) {
+
+    std::ostringstream oss;
+
+    for (size_t i = 0; i < cpus.size();) {
+        size_t j = i;
+        while (j + 1 < cpus.size() && cpus[j + 1] == cpus[j] + 1) {
+            ++j;
+        }
+        oss << (i > 0 ? "," : "") << cpus[i];
+        if (j > i) {
+            oss << "-" << cpus[j];
+        }
+        i = j + 1;
+    }
+
+    return oss.str();
+}
+
+
+ThreadAffinity ThreadAffinity::current() {
+    return currentAffinity_ ? *currentAffinity_ : ThreadAffinity();
+}
+
+
+ThreadAffinity::Scope::Scope(const ThreadAffinity& affinity) : previous_{currentAffinity_} {
+    currentAffinity_ = &affinity;
+}
+
+
+ThreadAffinity::Scope::~Scope() {
+    currentAffinity_ = previous_;
+}
+
+
+std::ostream& operator<<(std::ostream& oss, const ThreadAffinity& obj) {
+    oss << "affinity: " << modeToString(obj.mode_);
+    if (!obj.cpus_.empty()) {
+        oss << ", cores: " << ThreadAffinity::formatCpuList(obj.cpus_);
+    }
+    else {
+        oss << ", cores: " << ThreadAffinity::formatCpuList(ThreadAffinity::processCpus()) << " (inherited)";
+    }
+    oss << ", numa-first-touch: " << (obj.numaFirstTouch_ ? "on" : "off");
+    return oss;
+}
+
+}  // namespace plume
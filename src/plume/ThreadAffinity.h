@@ -0,0 +1,163 @@
+/*
+ * (C) Copyright 2025- ECMWF.
+ *
+ * This software is licensed under the terms of the Apache Licence Version 2.0
+ * which can be obtained at http://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * In applying this licence, ECMWF does not waive the privileges and immunities
+ * granted to it by virtue of its status as an intergovernmental organisation nor
+ * does it submit to any jurisdiction.
+ */
+#pragma once
+
+#include <functional>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "eckit/config/Configuration.h"
+
+
+namespace plume {
+
+/**
+ * @brief Placement of the threads created by Plume (and by plugins that opt in).
+ *
+ * The model usually pins its own (OpenMP) threads, any thread spawned afterwards inherits the affinity of its
+ * creator and ends up competing with the model for the same cores. This class resolves the set of cores that Plume
+ * threads should run on from the `threads` section of the manager configuration:
+ *
+ * @code{.yaml}
+ * threads:
+ *   affinity: spare          # inherit (default) | cpuset | spare
+ *   cpuset: "4-7,12"         # only used (and required) by "cpuset"
+ *   numa-first-touch: true   # initialise Plume-owned buffers from a pinned thread
+ *   count: 2                 # size of the session thread pool (see Session)
+ * @endcode
+ *
+ * - `inherit` leaves thread placement untouched.
+ * - `cpuset` pins Plume threads to an explicit list of cores.
+ * - `spare` pins Plume threads to the online cores that are not part of the process affinity mask (i.e. cores not
+ *   used by the model). If there are none, it falls back to the process mask.
+ *
+ * @note Affinity control is only available on Linux, elsewhere all modes behave as `inherit`.
+ */
+class ThreadAffinity {
+
+public:
+
+    enum class Mode
+    {
+        Inherit,
+        CpuSet,
+        Spare
+    };
+
+    /**
+     * @brief Default placement, threads inherit the affinity of their creator
+     */
+    ThreadAffinity();
+
+    /**
+     * @brief Resolve the placement from a `threads` configuration
+     *
+     * @param config
+     */
+    explicit ThreadAffinity(const eckit::Configuration& config);
+
+    /**
+     * @brief check if the placement keys (`affinity`, `cpuset`, `numa-first-touch`) of a `threads` configuration are
+     * valid, the other keys of the section are left to their owners (see ManagerConfig)
+     *
+     * @param config
+     * @return true
+     * @return false
+     */
+    static bool isValid(const eckit::Configuration& config);
+
+    Mode mode() const { return mode_; }
+
+    /**
+     * @brief Cores Plume threads are placed on (empty when inheriting)
+     *
+     * @return const std::vector<int>&
+     */
+    const std::vector<int>& cpus() const { return cpus_; }
+
+    bool numaFirstTouch() const { return numaFirstTouch_; }
+
+    /**
+     * @brief Pin the calling thread to the Plume cores
+     *
+     * @return true if the affinity of the calling thread has been changed
+     */
+    bool pinCurrentThread() const;
+
+    /**
+     * @brief Run an allocation/initialisation function so that the pages it touches first are NUMA-local to the
+     * Plume cores.
+     *
+     * When first-touch placement is enabled (and there are cores to pin to), the function runs to completion on a
+     * thread pinned to the Plume cores, started on the first call and reused by the next ones (and by the copies of
+     * this placement). Otherwise it runs inline on the calling thread.
+     *
+     * @param init
+     */
+    void firstTouch(const std::function<void()>& init) const;
+
+    /**
+     * @brief Process affinity mask, saved when Plume is loaded (all online cores if it cannot be queried)
+     *
+     * The mask is not re-read from the calling thread, which may already be pinned to the Plume cores.
+     */
+    static std::vector<int> processCpus();
+
+    /// Online cores of the node
+    static std::vector<int> onlineCpus();
+
+    /// Parse a cpu list in the kernel format, e.g. "0-3,8,10-11"
+    static std::vector<int> parseCpuList(const std::string& list);
+
+    /// Format a cpu list in the kernel format, e.g. "0-3,8,10-11"
+    static std::string formatCpuList(const std::vector<int>& cpus);
+
+    /**
+     * @brief Placement in use by the session operating on the calling thread (inherit outside of any session)
+     *
+     * @return ThreadAffinity
+     */
+    static ThreadAffinity current();
+
+    /**
+     * @brief Makes a placement current on the calling thread for the lifetime of the scope
+     */
+    class Scope {
+    public:
+        explicit Scope(const ThreadAffinity& affinity);
+        ~Scope();
+
+        Scope(const Scope&)            = delete;
+        Scope& operator=(const Scope&) = delete;
+
+    private:
+        const ThreadAffinity* previous_;
+    };
+
+    friend std::ostream& operator<<(std::ostream& oss, const ThreadAffinity& obj);
+
+private:
+
+    class Toucher;
+
+    Mode mode_;
+
+    std::vector<int> cpus_;
+
+    bool numaFirstTouch_;
+
+    // pinned thread running the first-touch initialisations (shared by copies)
+    std::shared_ptr<Toucher> toucher_;
+};
+
+}  // namespace plume
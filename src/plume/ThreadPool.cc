@@ -0,0 +1,151 @@
+/*
+ * (C) Copyright 2025- ECMWF.
+ *
+ * This software is licensed under the terms of the Apache Licence Version 2.0
+ * which can be obtained at http://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * In applying this licence, ECMWF does not waive the privileges and immunities
+ * granted to it by virtue of its status as an intergovernmental organisation nor
+ * does it submit to any jurisdiction.
+ */
+#include <algorithm>
+#include <atomic>
+#include <exception>
+
+#include "eckit/exception/Exceptions.h"
+
+#include "plume/ThreadPool.h"
+#include "plume/Tracer.h"
+
+
+namespace plume {
+
+namespace {
+
+// set on pool workers, nested parallel loops run serially to avoid workers waiting on each other
+thread_local bool isPoolWorker_ = false;
+
+}  // namespace
+
+
+ThreadPool::ThreadPool(std::size_t nthreads, const ThreadAffinity& affinity) :
+    affinity_{affinity}, stopping_{false} {
+    workers_.reserve(nthreads);
+    for (std::size_t i = 0; i < nthreads; ++i) {
+        workers_.emplace_back([this]() { work(); });
+    }
+}
+
+
+ThreadPool::~ThreadPool() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stopping_ = true;
+    }
+    cv_.notify_all();
+    for (auto& worker : workers_) {
+        worker.join();
+    }
+}
+
+
+std::future<void> ThreadPool::submit(std::function<void()> task) {
+
+    // the task records its trace events to the tracer of the submitting thread
+    std::packaged_task<void()> packaged([task = std::move(task), tracer = Tracer::current()]() {
+        Tracer::Install install(tracer);
+        task();
+    });
+    auto future = packaged.get_future();
+
+    if (workers_.empty()) {
+        packaged();
+        return future;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        ASSERT_MSG(!stopping_, "ThreadPool: cannot submit tasks to a pool being destroyed");
+        tasks_.push_back(std::move(packaged));
+    }
+    cv_.notify_one();
+
+    return future;
+}
+
+
+void ThreadPool::parallelFor(std::size_t n, const std::function<void(std::size_t)>& fn) {
+
+    if (n == 0) {
+        return;
+    }
+
+    if (workers_.empty() || n == 1 || isPoolWorker_) {
+        for (std::size_t i = 0; i < n; ++i) {
+            fn(i);
+        }
+        return;
+    }
+
+    std::atomic<std::size_t> next{0};
+    auto loop = [&]() {
+        for (std::size_t i = next++; i < n; i = next++) {
+            fn(i);
+        }
+    };
+
+    std::size_t nhelpers = std::min(workers_.size(), n - 1);
+    std::vector<std::future<void>> helpers;
+    helpers.reserve(nhelpers);
+    for (std::size_t h = 0; h < nhelpers; ++h) {
+        helpers.push_back(submit(loop));
+    }
+
+    std::exception_ptr error;
+    try {
+        loop();
+    }
+    catch (...) {
+        error = std::current_exception();
+        next  = n;  // stop handing out work
+    }
+
+    for (auto& helper : helpers) {
+        try {
+            helper.get();
+        }
+        catch (...) {
+            if (!error) {
+                error = std::current_exception();
+            }
+        }
+    }
+
+    if (error) {
+        std::rethrow_exception(error);
+    }
+}
+
+
+void ThreadPool::work() {
+
+    isPoolWorker_ = true;
+    affinity_.pinCurrentThread();
+    ThreadAffinity::Scope scope(affinity_);
+
+    while (true) {
+        std::packaged_task<void()> task;
+        {
+            std::unique_lock<std::mutex> lock(mutex_);
+            cv_.wait(lock, [this]() { return stopping_ || !tasks_.empty(); });
+            if (tasks_.empty()) {
+                return;  // stopping, and nothing left to do
+            }
+            task = std::move(tasks_.front());
+            tasks_.pop_front();
+        }
+        task();
+    }
+}
+
+}  // namespace plume
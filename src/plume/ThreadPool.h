@@ -0,0 +1,92 @@
+/*
+ * (C) Copyright 2025- ECMWF.
+ *
+ * This software is licensed under the terms of the Apache Licence Version 2.0
+ * which can be obtained at http://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * In applying this licence, ECMWF does not waive the privileges and immunities
+ * granted to it by virtue of its status as an intergovernmental organisation nor
+ * does it submit to any jurisdiction.
+ */
+#pragma once
+
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <future>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "eckit/memory/NonCopyable.h"
+
+#include "plume/ThreadAffinity.h"
+
+
+namespace plume {
+
+/**
+ * @brief Fixed-size pool of worker threads placed according to a ThreadAffinity.
+ *
+ * A pool with no workers is valid: tasks are then executed inline by the submitting thread, so code using the pool
+ * does not need a serial fallback.
+ */
+class ThreadPool : private eckit::NonCopyable {
+
+public:
+
+    /**
+     * @brief Construct a new ThreadPool object
+     *
+     * @param nthreads number of worker threads (0 runs tasks inline)
+     * @param affinity placement of the worker threads
+     */
+    explicit ThreadPool(std::size_t nthreads = 0, const ThreadAffinity& affinity = ThreadAffinity());
+
+    /**
+     * @brief Waits for queued tasks to complete and joins the workers
+     *
+     */
+    ~ThreadPool();
+
+    std::size_t size() const { return workers_.size(); }
+
+    const ThreadAffinity& affinity() const { return affinity_; }
+
+    /**
+     * @brief Queue a task, exceptions thrown by the task are rethrown by the returned future
+     * The task records its trace events to the tracer current on the submitting thread.
+     *
+     * @param task
+     * @return std::future<void>
+     */
+    std::future<void> submit(std::function<void()> task);
+
+    /**
+     * @brief Run fn(i) for i in [0, n), blocking until all iterations are done.
+     * The calling thread takes part in the work, the first exception (if any) is rethrown.
+     *
+     * @param n
+     * @param fn
+     */
+    void parallelFor(std::size_t n, const std::function<void(std::size_t)>& fn);
+
+private:
+
+    void work();
+
+    ThreadAffinity affinity_;
+
+    std::vector<std::thread> workers_;
+
+    std::deque<std::packaged_task<void()>> tasks_;
+
+    std::mutex mutex_;
+
+    std::condition_variable cv_;
+
+    bool stopping_;
+};
+
+}  // namespace plume
@@ -0,0 +1,247 @@
+/*
+ * (C) Copyright 2025- ECMWF.
+ *
+ * This software is licensed under the terms of the Apache Licence Version 2.0
+ * which can be obtained at http://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * In applying this licence, ECMWF does not waive the privileges and immunities
+ * granted to it by virtue of its status as an intergovernmental organisation nor
+ * does it submit to any jurisdiction.
+ */
+#include <algorithm>
+#include <atomic>
+#include <cstdlib>
+#include <cstring>
+#include <cxxabi.h>
+#include <fstream>
+#include <sstream>
+#include <utility>
+
+#include "eckit/exception/Exceptions.h"
+#include "eckit/log/Log.h"
+
+#include "plume/Tracer.h"
+
+
+namespace plume {
+
+namespace {
+
+// JSON string contents
+std::string escape(const std::string& text) {
+    std::string escaped;
+    escaped.reserve(text.size());
+    for (char c : text) {
+        if (c == '"' || c == '\\') {
+            escaped += '\\';
+            escaped += c;
+        }
+        else if (static_cast<unsigned char>(c) < 0x20) {
+            escaped += ' ';
+        }
+        else {
+            escaped += c;
+        }
+    }
+    return escaped;
+}
+
+std::atomic<std::uint64_t> nextId_{0};
+
+thread_local Tracer* currentTracer_ = nullptr;
+
+}  // namespace
+
+
+Tracer::Tracer() : id_{nextId_++} {}
+
+
+Tracer::~Tracer() = default;
+
+
+Tracer* Tracer::current() {
+    return currentTracer_;
+}
+
+
+std::uint64_t Tracer::currentStep() {
+    return currentTracer_ ? currentTracer_->step() : 0;
+}
+
+
+Tracer::Install::Install(Tracer* tracer) : previous_{currentTracer_} {
+    currentTracer_ = tracer;
+}
+
+
+Tracer::Install::~Install() {
+    currentTracer_ = previous_;
+}
+
+
+std::string Tracer::demangle(const char* name) {
+    int status  = 0;
+    char* plain = abi::__cxa_demangle(name, nullptr, nullptr, &status);
+    std::string demangled(status == 0 && plain ? plain : name);
+    std::free(plain);
+    return demangled;
+}
+
+
+void Tracer::enable(const std::string& path) {
+    ASSERT_MSG(!path.empty(), "Tracer: the path of the trace is empty");
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        path_ = path;
+    }
+    enabled_.store(true, std::memory_order_relaxed);
+}
+
+
+void Tracer::disable() {
+    enabled_.store(false, std::memory_order_relaxed);
+}
+
+
+std::string Tracer::path() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return path_;
+}
+
+
+Tracer::ThreadBuffer& Tracer::threadBuffer() {
+    // registered on the first event of each thread, owned by the tracer (kept after the thread exits)
+    thread_local std::vector<std::pair<std::uint64_t, std::weak_ptr<ThreadBuffer>>> buffers;
+    for (const auto& [id, buffer] : buffers) {
+        if (id == id_) {
+            return *buffer.lock();  // alive as long as this tracer
+        }
+    }
+
+    // buffers of destroyed tracers are released
+    auto expired = [](const auto& entry) { return entry.second.expired(); };
+    buffers.erase(std::remove_if(buffers.begin(), buffers.end(), expired), buffers.end());
+
+    auto buffer = std::make_shared<ThreadBuffer>();
+    buffer->events.resize(capacity);
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        buffer->thread = buffers_.size();
+        buffers_.push_back(buffer);
+    }
+    buffers.emplace_back(id_, buffer);
+    return *buffer;
+}
+
+
+void Tracer::record(const char* category, const char* name, const char* detail, Clock::time_point begin,
+                    Clock::time_point end, bool typeName) {
+    if (!enabled()) {
+        return;
+    }
+    auto& buffer      = threadBuffer();
+    std::size_t count = buffer.recorded.load(std::memory_order_relaxed);
+    Event& event      = buffer.events[count % capacity];
+
+    std::size_t length = std::min(std::strlen(name), nameLength);
+    std::memcpy(event.name, name, length);
+    if (*detail && length < nameLength) {
+        event.name[length++] = ' ';
+        std::size_t extra    = std::min(std::strlen(detail), nameLength - length);
+        std::memcpy(event.name + length, detail, extra);
+        length += extra;
+    }
+    event.name[length] = '\0';
+
+    using std::chrono::duration_cast;
+    using std::chrono::microseconds;
+    event.category = category;
+    event.typeName = typeName;
+    event.begin    = duration_cast<microseconds>(begin.time_since_epoch()).count();
+    event.duration = duration_cast<microseconds>(end - begin).count();
+    event.step     = step();
+
+    buffer.recorded.store(count + 1, std::memory_order_release);
+}
+
+
+std::size_t Tracer::size() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    std::size_t kept = 0;
+    for (const auto& buffer : buffers_) {
+        kept += std::min(buffer->recorded.load(std::memory_order_acquire), capacity);
+    }
+    return kept;
+}
+
+
+std::string Tracer::events(std::size_t rank) const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    std::ostringstream out;
+    const char* separator = ",\n";
+
+    out << R"({"name":"process_name","ph":"M","pid":)" << rank << R"(,"args":{"name":"rank )" << rank << "\"}}";
+
+    for (const auto& buffer : buffers_) {
+        const std::size_t recorded = buffer->recorded.load(std::memory_order_acquire);
+        const std::size_t kept     = std::min(recorded, capacity);
+        if (kept == 0) {
+            continue;
+        }
+        out << separator << R"({"name":"thread_name","ph":"M","pid":)" << rank << R"(,"tid":)" << buffer->thread
+            << R"(,"args":{"name":"thread )" << buffer->thread << "\"}}";
+
+        for (std::size_t i = recorded - kept; i < recorded; ++i) {
+            const Event& event = buffer->events[i % capacity];
+            std::string name   = event.typeName ? demangle(event.name) : std::string(event.name);
+            out << separator << R"({"name":")" << escape(name) << R"(","cat":")" << event.category
+                << R"(","ph":"X","ts":)" << event.begin << R"(,"dur":)" << event.duration << R"(,"pid":)" << rank
+                << R"(,"tid":)" << buffer->thread << R"(,"args":{"step":)" << event.step << "}}";
+        }
+    }
+    return out.str();
+}
+
+
+void Tracer::write(const eckit::mpi::Comm& comm, std::size_t root) {
+    const std::string local = events(comm.rank());
+
+    // events of all the ranks on the root
+    std::vector<int> sizes(comm.size());
+    comm.gather(static_cast<int>(local.size()), sizes, root);
+    std::vector<int> displs(comm.size(), 0);
+    for (std::size_t r = 1; r < sizes.size(); ++r) {
+        displs[r] = displs[r - 1] + sizes[r - 1];
+    }
+    std::string all(comm.rank() == root ? displs.back() + sizes.back() : 0, '\0');
+    comm.gatherv(local.begin(), local.end(), all.begin(), all.end(), sizes, displs, root);
+
+    if (comm.rank() == root) {
+        const std::string file = path();
+        std::ofstream out(file);
+        if (!out) {
+            throw eckit::CantOpenFile(file, Here());
+        }
+        out << "{\"traceEvents\":[\n";
+        const char* separator = "";
+        for (std::size_t r = 0; r < sizes.size(); ++r) {
+            out << separator;
+            out.write(all.data() + displs[r], sizes[r]);
+            separator = ",\n";
+        }
+        out << "\n],\"displayTimeUnit\":\"ms\"}\n";
+        eckit::Log::info() << "Plume trace of " << comm.size() << " rank(s) written to " << file << std::endl;
+    }
+
+    clear();
+}
+
+
+void Tracer::clear() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    for (auto& buffer : buffers_) {
+        buffer->recorded.store(0, std::memory_order_release);
+    }
+}
+
+}  // namespace plume
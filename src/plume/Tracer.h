@@ -0,0 +1,183 @@
+/*
+ * (C) Copyright 2025- ECMWF.
+ *
+ * This software is licensed under the terms of the Apache Licence Version 2.0
+ * which can be obtained at http://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * In applying this licence, ECMWF does not waive the privileges and immunities
+ * granted to it by virtue of its status as an intergovernmental organisation nor
+ * does it submit to any jurisdiction.
+ */
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <typeinfo>
+#include <vector>
+
+#include "eckit/memory/NonCopyable.h"
+#include "eckit/mpi/Comm.h"
+
+
+namespace plume {
+
+/**
+ * @brief Opt-in timeline of the Plume lifecycle, exported as a Chrome trace (JSON, for Perfetto or chrome://tracing)
+ *
+ * Each session owns a tracer, enabled by `profiling.trace: <path>` in its manager configuration, or by the PLUME_TRACE
+ * environment variable (the path). Trace scopes record to the tracer current on their thread (see Install), which the
+ * session installs in its calls, the model data in its updates and the thread pool in its tasks, so that sessions
+ * sharing a process keep their own events and steps. Each thread records complete events (begin, duration and step)
+ * in its own ring buffer per tracer, without locks once the buffer is registered, the oldest events being overwritten
+ * when it is full. At teardown, the events of all the ranks of the session communicator are gathered and written by
+ * the root, with one trace process per rank and one trace thread per Plume thread.
+ *
+ * When no tracer is current or it is disabled, a trace scope costs a thread-local and a relaxed atomic load.
+ */
+class Tracer : private eckit::NonCopyable {
+
+public:
+
+    using Clock = std::chrono::system_clock;  // comparable across ranks
+
+    /// Events kept per thread
+    static constexpr std::size_t capacity = 1 << 14;
+
+    /// Longest event name kept (longer names are truncated)
+    static constexpr std::size_t nameLength = 63;
+
+    /// Name of the environment variable enabling the tracer
+    static constexpr const char* environment = "PLUME_TRACE";
+
+    Tracer();
+
+    ~Tracer();
+
+    /// Tracer installed on the calling thread (nullptr if none).
+    static Tracer* current();
+
+    /// Step of the tracer installed on the calling thread (0 if none).
+    static std::uint64_t currentStep();
+
+    /**
+     * @brief Makes a tracer current on the calling thread for the lifetime of the install (nullptr for none)
+     */
+    class Install : private eckit::NonCopyable {
+    public:
+        explicit Install(Tracer* tracer);
+        ~Install();
+
+    private:
+        Tracer* previous_;
+    };
+
+    /// Readable name of a type, from its mangled name.
+    static std::string demangle(const char* name);
+
+    /// Enables the tracer, the trace is written to `path` (overwritten) by `write`.
+    void enable(const std::string& path);
+
+    void disable();
+
+    bool enabled() const { return enabled_.load(std::memory_order_relaxed); }
+
+    std::string path() const;
+
+    /// Step of the events recorded from now on (set by the session on each run).
+    void setStep(std::uint64_t step) { step_.store(step, std::memory_order_relaxed); }
+
+    std::uint64_t step() const { return step_.load(std::memory_order_relaxed); }
+
+    /// Records a complete event of the calling thread (if enabled).
+    void record(const char* category, const char* name, const char* detail, Clock::time_point begin,
+                Clock::time_point end, bool typeName = false);
+
+    /// Number of events kept for the threads of this process.
+    std::size_t size() const;
+
+    /// Events of the threads of this process as Chrome trace events, comma separated.
+    std::string events(std::size_t rank = 0) const;
+
+    /// Gathers the events of all the ranks, written to the path by the root, then clears them (collective).
+    void write(const eckit::mpi::Comm& comm = eckit::mpi::comm(), std::size_t root = 0);
+
+    /// Drops the events recorded so far.
+    void clear();
+
+    /**
+     * @brief Records an event from its construction to its destruction (if the tracer is enabled)
+     *
+     * Names are static strings (or the name of a type, demangled when written), the detail (e.g. a plugin name) is
+     * appended to the name. The event goes to the tracer current when the scope is opened.
+     */
+    class Scope : private eckit::NonCopyable {
+    public:
+        Scope(const char* category, const char* name, const std::string& detail = std::string()) :
+            category_{category}, name_{name}, tracer_{active(current())} {
+            if (tracer_) {
+                detail_ = detail;
+                begin_  = Clock::now();
+            }
+        }
+
+        Scope(const char* category, const std::type_info& type) :
+            category_{category}, name_{type.name()}, typeName_{true}, tracer_{active(current())} {
+            if (tracer_) {
+                begin_ = Clock::now();
+            }
+        }
+
+        ~Scope() {
+            if (tracer_) {
+                tracer_->record(category_, name_, detail_.c_str(), begin_, Clock::now(), typeName_);
+            }
+        }
+
+    private:
+        static Tracer* active(Tracer* tracer) { return tracer && tracer->enabled() ? tracer : nullptr; }
+
+        const char* category_;
+        const char* name_;
+        std::string detail_;
+        bool typeName_ = false;
+        Tracer* tracer_;
+        Clock::time_point begin_;
+    };
+
+private:
+
+    struct Event {
+        char name[nameLength + 1];
+        const char* category;
+        bool typeName;
+        std::int64_t begin;  // microseconds since the epoch of the clock
+        std::int64_t duration;
+        std::uint64_t step;
+    };
+
+    // ring buffer of a thread, written by that thread only
+    struct ThreadBuffer {
+        std::size_t thread;
+        std::vector<Event> events;
+        std::atomic<std::size_t> recorded{0};
+    };
+
+    ThreadBuffer& threadBuffer();
+
+    // identifies the buffers of this tracer in the threads (never reused)
+    const std::uint64_t id_;
+
+    std::atomic<bool> enabled_{false};
+    std::atomic<std::uint64_t> step_{0};
+
+    mutable std::mutex mutex_;  // guards the path and the list of buffers
+    std::string path_;
+    std::vector<std::shared_ptr<ThreadBuffer>> buffers_;
+};
+
+}  // namespace plume
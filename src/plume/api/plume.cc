@@ -22,10 +22,12 @@
 
 #include "atlas/array.h"
 #include "atlas/field/Field.h"
+#include "atlas/field/FieldSet.h"
 #include "atlas/field/detail/FieldImpl.h"
 
 #include "plume.h"
 #include "plume/Manager.h"
+#include "plume/Session.h"
 #include "plume/data/ParameterCatalogue.h"
 #include "plume/data/ModelData.h"
 
@@ -95,6 +97,19 @@ int wrapApiFunction(FN f) {
     ASSERT(false);
 }
 
+/** Checks the rank of an array passed through the C interface (offered or provided) */
+void assertArrayRank(int rank) {
+    ASSERT_MSG(rank > 0 && rank <= PLUME_ARRAY_MAX_RANK,
+               "Array of rank " + std::to_string(rank) + " (expected 1 to " + std::to_string(PLUME_ARRAY_MAX_RANK) +
+                   ")");
+}
+
+/** Wraps a C producer callback of a lazily provided parameter */
+std::function<void()> makeProducer(const char* name, plume_data_producer_t producer, void* context) {
+    ASSERT_MSG(producer, "Producer of parameter " + std::string(name) + " is null");
+    return [producer, context, pname = std::string(name)] { producer(pname.c_str(), context); };
+}
+
 int plume_set_failure_handler(plume_failure_handler_t handler, void* context) {
     return wrapApiFunction([handler, context] {
         g_failure_handler         = handler;
@@ -115,11 +130,13 @@ struct plume_protocol_handle_t {
     std::unique_ptr<plume::Protocol> impl_;
 };
 
-// Model handle
+// Model handle (drives either the default session or a session it owns)
 struct plume_manager_handle_t {
-    plume_manager_handle_t(plume::Manager* manager) : impl_(manager) {}
+    plume_manager_handle_t(plume::Session* session, bool ownsSession) :
+        impl_(session), owned_(ownsSession ? session : nullptr) {}
     ~plume_manager_handle_t() noexcept(false) {}
-    std::unique_ptr<plume::Manager> impl_;
+    plume::Session* impl_;
+    std::unique_ptr<plume::Session> owned_;
 };
 
 // PLUME data
@@ -209,6 +226,29 @@ int plume_protocol_offer_atlas_field(plume_protocol_handle_t* h, const char* nam
     });
 }
 
+int plume_protocol_offer_atlas_fieldset(plume_protocol_handle_t* h, void* ptr, const char* avail,
+                                        const char* comment) {
+    return wrapApiFunction([h, ptr, avail, comment] {
+        ASSERT(h);
+        ASSERT((h)->impl_);
+        ASSERT(ptr);
+        atlas::FieldSet fields(static_cast<atlas::FieldSet::Implementation*>(ptr));
+        h->impl_->offerFieldSet(fields, avail, comment);
+    });
+}
+
+int plume_protocol_offer_array(plume_protocol_handle_t* h, const char* name, const char* avail, const char* comment,
+                               const char* datatype, int rank, const int* shape) {
+    return wrapApiFunction([h, name, avail, comment, datatype, rank, shape] {
+        ASSERT(h);
+        ASSERT((h)->impl_);
+        ASSERT(shape);
+        assertArrayRank(rank);
+        std::vector<long> extents(shape, shape + rank);
+        h->impl_->offer<plume::data::ArrayView>(name, avail, comment, extents, datatype);
+    });
+}
+
 int plume_protocol_delete_handle(plume_protocol_handle_t* h) {
     return wrapApiFunction([&h] {
         if (h) {
@@ -223,10 +263,19 @@ int plume_protocol_delete_handle(plume_protocol_handle_t* h) {
 
 // ------------------------------------ PLUME manager ----------------------------------------
 
-// Create a plume-plugin manager handle
+// Create a plume-plugin manager handle (default session)
 int plume_manager_create_handle(plume_manager_handle_t** h) {
     return wrapApiFunction([h] {
-        *h = new plume_manager_handle_t(new plume::Manager);
+        *h = new plume_manager_handle_t(&plume::Session::defaultSession(), false);
+        ASSERT(*h);
+        ASSERT((*h)->impl_);
+    });
+}
+
+// Create a plume-plugin manager handle owning an independent session
+int plume_manager_create_session_handle(plume_manager_handle_t** h) {
+    return wrapApiFunction([h] {
+        *h = new plume_manager_handle_t(new plume::Session, true);
         ASSERT(*h);
         ASSERT((*h)->impl_);
     });
@@ -486,12 +535,123 @@ int plume_data_provide_atlas_field_shared(plume_data_handle_t* h, const char* na
     });
 }
 
+// -------- Arrays
+int plume_data_provide_array(plume_data_handle_t* h, const char* name, void* ptr, const char* datatype, int rank,
+                             const int* shape, const int* strides) {
+    return wrapApiFunction([h, name, ptr, datatype, rank, shape, strides] {
+        ASSERT(shape);
+        assertArrayRank(rank);
+        std::vector<long> extents(shape, shape + rank);
+        std::vector<long> steps;
+        if (strides) {
+            steps.assign(strides, strides + rank);
+        }
+        h->impl_->provideArray(name, plume::data::ArrayView(ptr, datatype, extents, steps));
+    });
+}
+
+int plume_data_provide_atlas_fieldset_shared(plume_data_handle_t* h, void* ptr, int count, int* ids) {
+    return wrapApiFunction([h, ptr, count, ids] {
+        ASSERT(ptr);
+        atlas::FieldSet fields(static_cast<atlas::FieldSet::Implementation*>(ptr));
+        ASSERT_MSG(count >= fields.size(), "Field set of " + std::to_string(fields.size()) + " fields, room for " +
+                                               std::to_string(count) + " ids only");
+        auto paramIds = h->impl_->provideFieldSet(fields);
+        for (std::size_t i = 0; i < paramIds.size(); ++i) {
+            ids[i] = static_cast<int>(paramIds[i].value());
+        }
+    });
+}
+
+int plume_data_param_id(plume_data_handle_t* h, const char* name, int* id) {
+    return wrapApiFunction([h, name, id] {
+        auto paramId = plume::data::ParamId::find(name);
+        if (!h->impl_->hasParameter(paramId)) {
+            throw eckit::BadParameter("Parameter '" + std::string(name) + "' not found in model data!", Here());
+        }
+        *id = static_cast<int>(paramId.value());
+    });
+}
+
+// -------- Lazily produced params
+int plume_data_provide_int_lazy(plume_data_handle_t* h, const char* name, int* param, plume_data_producer_t producer,
+                                void* context) {
+    return wrapApiFunction([h, name, param, producer, context] {
+        h->impl_->provideParam(name, param, makeProducer(name, producer, context));
+    });
+}
+
+int plume_data_provide_bool_lazy(plume_data_handle_t* h, const char* name, bool* param,
+                                 plume_data_producer_t producer, void* context) {
+    return wrapApiFunction([h, name, param, producer, context] {
+        h->impl_->provideParam(name, param, makeProducer(name, producer, context));
+    });
+}
+
+int plume_data_provide_float_lazy(plume_data_handle_t* h, const char* name, float* param,
+                                  plume_data_producer_t producer, void* context) {
+    return wrapApiFunction([h, name, param, producer, context] {
+        h->impl_->provideParam(name, param, makeProducer(name, producer, context));
+    });
+}
+
+int plume_data_provide_double_lazy(plume_data_handle_t* h, const char* name, double* param,
+                                   plume_data_producer_t producer, void* context) {
+    return wrapApiFunction([h, name, param, producer, context] {
+        h->impl_->provideParam(name, param, makeProducer(name, producer, context));
+    });
+}
+
+int plume_data_provide_atlas_field_shared_lazy(plume_data_handle_t* h, const char* name, void* ptr,
+                                               plume_data_producer_t producer, void* context) {
+    return wrapApiFunction([h, name, ptr, producer, context] {
+        auto field_ptr = static_cast<atlas::Field::Implementation*>(ptr);
+        h->impl_->provideParam(name, field_ptr, makeProducer(name, producer, context));
+    });
+}
+
 
 // ----------------- Data view "updaters" (Plugin API) -----------------
 int plume_data_get_shared_atlas_field(plume_data_handle_t* h, const char* name, void** ptr) {
     return wrapApiFunction([h, name, ptr] { *ptr = h->impl_->getParam<atlas::Field>(name).get(); });
 }
 
+namespace {
+
+void describeArray(const plume::data::ArrayView& view, plume_array_t* array) {
+    ASSERT(array);
+    static_assert(PLUME_ARRAY_MAX_RANK == plume::data::ArrayView::maxRank, "C and C++ array ranks differ");
+    array->data     = view.data();
+    array->datatype = view.datatype();
+    array->rank     = static_cast<int>(view.rank());
+    for (std::size_t dim = 0; dim < PLUME_ARRAY_MAX_RANK; ++dim) {
+        array->shape[dim]   = dim < view.rank() ? static_cast<int>(view.shape(dim)) : 0;
+        array->strides[dim] = dim < view.rank() ? static_cast<int>(view.stride(dim)) : 0;
+    }
+}
+
+}  // namespace
+
+int plume_data_get_array(plume_data_handle_t* h, const char* name, plume_array_t* array) {
+    return wrapApiFunction([h, name, array] { describeArray(h->impl_->getArray(name), array); });
+}
+
+int plume_data_get_array_levels(plume_data_handle_t* h, const char* name, const char* levels, plume_array_t* array) {
+    return wrapApiFunction([h, name, levels, array] {
+        // a strided view of the source ('levels'), or a compact copy ('levels-copy')
+        const char* levtype = h->impl_->hasParameter(name, levels, "ml") ? "ml" : "mlc";
+        describeArray(h->impl_->getArray(name, levels, levtype), array);
+    });
+}
+
+int plume_data_is_updated(plume_data_handle_t* h, const char* name, bool* updated) {
+    return wrapApiFunction([h, name, updated] { *updated = h->impl_->isUpdated(name); });
+}
+
+int plume_data_generation(plume_data_handle_t* h, const char* name, uint64_t* generation) {
+    return wrapApiFunction([h, name, generation] { *generation = h->impl_->generation(name); });
+}
+
 int plume_data_get_int(plume_data_handle_t* h, const char* name, int* val) {
     return wrapApiFunction([h, name, val] { *val = h->impl_->getParam<int>(name); });
 }
@@ -520,6 +680,25 @@ int plume_data_set_updated(plume_data_handle_t* h, const int count, const char**
     return wrapApiFunction([h, params] {h->impl_->setUpdated(params); });
 }
 
+int plume_data_set_updated_ids(plume_data_handle_t* h, const int count, const int* ids) {
+    return wrapApiFunction([h, count, ids] {
+        std::vector<plume::data::ParamId> params;
+        params.reserve(count);
+        for (int i = 0; i < count; ++i) {
+            ASSERT_MSG(ids[i] >= 0, "Invalid parameter id " + std::to_string(ids[i]));
+            params.push_back(plume::data::ParamId::fromValue(static_cast<std::uint32_t>(ids[i])));
+        }
+        h->impl_->setUpdatedIds(params);
+    });
+}
+
+int plume_data_set_updated_mask(plume_data_handle_t* h, const int nwords, const uint64_t* mask) {
+    return wrapApiFunction([h, nwords, mask] {
+        ASSERT(nwords >= 0);
+        h->impl_->setUpdatedMask(mask, static_cast<std::size_t>(nwords));
+    });
+}
+
 // --------------------------------------------------------------------------------------
 
 
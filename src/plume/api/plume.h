@@ -15,6 +15,7 @@ extern "C" {
 #endif
 
 #include <stdbool.h>
+#include <stdint.h>
 
 /* Plume C-interface */
 
@@ -74,6 +75,26 @@ struct plume_data_handle_t;
 typedef struct plume_data_handle_t plume_data_handle_t;
 
 
+/* --- Plume arrays --- */
+
+/* Maximum rank of the arrays exchanged through the API */
+#define PLUME_ARRAY_MAX_RANK 4
+
+/**
+ * @brief Raw description of the memory of a field or array parameter, read in place by plugins
+ *
+ * Shape and strides are in the order of the underlying array (row-major for Atlas fields, the order of the provider
+ * for arrays), strides are in elements. The data is owned by the model or by Plume and must not be written to.
+ */
+typedef struct plume_array_t {
+    const void* data;     /* first element */
+    const char* datatype; /* "real32", "real64", "int32" or "int64" (static string) */
+    int rank;
+    int shape[PLUME_ARRAY_MAX_RANK];
+    int strides[PLUME_ARRAY_MAX_RANK];
+} plume_array_t;
+
+
 /* --- Plume Library --- */
 
 /**
@@ -100,6 +121,32 @@ int plume_protocol_offer_bool(plume_protocol_handle_t* h, const char* name, cons
 int plume_protocol_offer_float(plume_protocol_handle_t* h, const char* name, const char* avail, const char* comment);
 int plume_protocol_offer_double(plume_protocol_handle_t* h, const char* name, const char* avail, const char* comment);
 int plume_protocol_offer_atlas_field(plume_protocol_handle_t* h, const char* name, const char* avail, const char* comment);
+
+/**
+ * @brief Offer all the fields of an Atlas FieldSet (named as the fields), with their local shape and datatype
+ *
+ * @param h Handle
+ * @param ptr Pointer to FieldSet
+ * @param avail Availability of the fields
+ * @param comment Comment on the fields
+ * @return Error code
+ */
+int plume_protocol_offer_atlas_fieldset(plume_protocol_handle_t* h, void* ptr, const char* avail, const char* comment);
+
+/**
+ * @brief Offer a strided array of the model (type ARRAY), with its local shape and datatype
+ *
+ * @param h Handle
+ * @param name Name of array
+ * @param avail Availability of the array
+ * @param comment Comment on the array
+ * @param datatype Type of the elements: "real32", "real64", "int32" or "int64"
+ * @param rank Number of dimensions (1 to 4)
+ * @param shape Extent of each dimension
+ * @return Error code
+ */
+int plume_protocol_offer_array(plume_protocol_handle_t* h, const char* name, const char* avail, const char* comment,
+                               const char* datatype, int rank, const int* shape);
 int plume_protocol_delete_handle(plume_protocol_handle_t* h);
 
 /* --- Plume Manager --- */
@@ -107,11 +154,24 @@ int plume_protocol_delete_handle(plume_protocol_handle_t* h);
 /**
  * @brief Create a plume manager handle
  *
+ * The handle drives the process-wide default session, shared with the C++ static Manager API.
+ *
  * @param h Handle
  * @return Error code
  */
 int plume_manager_create_handle(plume_manager_handle_t** h);
 
+/**
+ * @brief Create a plume manager handle owning an independent session
+ *
+ * Each session has its own configuration, plugins and data catalogue (e.g. one per model component).
+ * The session is destroyed with the handle.
+ *
+ * @param h Handle
+ * @return Error code
+ */
+int plume_manager_create_session_handle(plume_manager_handle_t** h);
+
 /**
  * @brief create data handle from existing data
  *
@@ -385,6 +445,127 @@ int plume_data_provide_double(plume_data_handle_t* h, const char* name, double*
  */
 int plume_data_provide_atlas_field_shared(plume_data_handle_t* h, const char* name, void* ptr);
 
+/**
+ * @brief Insert a strided array owned by the model (type ARRAY), without copying it
+ *
+ * The array is seen in place by the plugins, the model updates its values and marks it as updated as any other
+ * parameter. Shape and strides are copied, the array must outlive Plume.
+ *
+ * @param h Handle
+ * @param name Name of array
+ * @param ptr Pointer to the first element
+ * @param datatype Type of the elements: "real32", "real64", "int32" or "int64"
+ * @param rank Number of dimensions (1 to 4)
+ * @param shape Extent of each dimension
+ * @param strides Distance between consecutive elements of each dimension, in elements (NULL if contiguous row-major)
+ * @return Error code
+ */
+int plume_data_provide_array(plume_data_handle_t* h, const char* name, void* ptr, const char* datatype, int rank,
+                             const int* shape, const int* strides);
+
+/**
+ * @brief Insert all the fields of an Atlas FieldSet (named as the fields) in one call
+ *
+ * The ids of the fields can then mark them as updated, with plume_data_set_updated_ids or
+ * plume_data_set_updated_mask, without passing their names. Fails, without inserting any field, if a field is named
+ * as an existing parameter.
+ *
+ * @param h Handle
+ * @param ptr Pointer to FieldSet
+ * @param count Size of the ids array (at least the number of fields)
+ * @param ids Ids of the fields, in the order of the FieldSet
+ * @return Error code
+ */
+int plume_data_provide_atlas_fieldset_shared(plume_data_handle_t* h, void* ptr, int count, int* ids);
+
+/**
+ * @brief Id of a parameter in the data (e.g. provided by name), to mark it as updated
+ *
+ * @param h Handle
+ * @param name Name of the parameter
+ * @param id Id of the parameter
+ * @return Error code
+ */
+int plume_data_param_id(plume_data_handle_t* h, const char* name, int* id);
+
+/** @brief Producer callback function signature, computes the value of a lazily provided parameter in place
+ *
+ * The producer only runs when the parameter is read through the model data (e.g. plume_data_get_*). Plugins that
+ * keep a pointer or a field from an earlier read are not refreshed and see the values of the last produced step:
+ * lazy parameters must be read again in each step.
+ *
+ * \param name Name of the parameter to produce
+ * \param context Producer context
+ */
+typedef void (*plume_data_producer_t)(const char* name, void* context);
+
+/**
+ * @brief Insert parameters (int) produced on demand: the producer fills *param the first time
+ * the parameter is accessed in a step (i.e. after plume_data_set_updated)
+ *
+ * @param h Handle
+ * @param name Name of parameter
+ * @param param parameter
+ * @param producer Producer callback
+ * @param context Producer context
+ * @return Error code
+ */
+int plume_data_provide_int_lazy(plume_data_handle_t* h, const char* name, int* param, plume_data_producer_t producer,
+                                void* context);
+
+/**
+ * @brief Insert parameters (bool) produced on demand
+ *
+ * @param h Handle
+ * @param name Name of parameter
+ * @param param parameter
+ * @param producer Producer callback
+ * @param context Producer context
+ * @return Error code
+ */
+int plume_data_provide_bool_lazy(plume_data_handle_t* h, const char* name, bool* param,
+                                 plume_data_producer_t producer, void* context);
+
+/**
+ * @brief Insert parameters (float) produced on demand
+ *
+ * @param h Handle
+ * @param name Name of parameter
+ * @param param parameter
+ * @param producer Producer callback
+ * @param context Producer context
+ * @return Error code
+ */
+int plume_data_provide_float_lazy(plume_data_handle_t* h, const char* name, float* param,
+                                  plume_data_producer_t producer, void* context);
+
+/**
+ * @brief Insert parameters (double) produced on demand
+ *
+ * @param h Handle
+ * @param name Name of parameter
+ * @param param parameter
+ * @param producer Producer callback
+ * @param context Producer context
+ * @return Error code
+ */
+int plume_data_provide_double_lazy(plume_data_handle_t* h, const char* name, double* param,
+                                   plume_data_producer_t producer, void* context);
+
+/**
+ * @brief Insert Atlas Field produced on demand: the producer fills the field values the first time
+ * the field is accessed in a step
+ *
+ * @param h Handle
+ * @param name Name of field
+ * @param ptr Pointer to Field
+ * @param producer Producer callback
+ * @param context Producer context
+ * @return Error code
+ */
+int plume_data_provide_atlas_field_shared_lazy(plume_data_handle_t* h, const char* name, void* ptr,
+                                               plume_data_producer_t producer, void* context);
+
 /**
  * @brief C pointer of a selected field
  *
@@ -438,6 +619,53 @@ int plume_data_get_float(plume_data_handle_t* h, const char* name, float* val);
 int plume_data_get_double(plume_data_handle_t* h, const char* name, double* val);
 
 
+/**
+ * @brief Data pointer, datatype, shape and strides of an Atlas field or array parameter, without Atlas bindings
+ *
+ * The description stays valid as long as the parameter does (the whole run for provided parameters), the values it
+ * points to change with the model steps. Threshold exceedances (levtype 'exc') have a row per point and level: the
+ * exceeding points are in the first rows, followed by rows of NaN.
+ *
+ * @param h Handle
+ * @param name Name of the field or array
+ * @param array Description of its memory
+ * @return Error code
+ */
+int plume_data_get_array(plume_data_handle_t* h, const char* name, plume_array_t* array);
+
+/**
+ * @brief Data pointer, datatype, shape and strides of a level subset of a field (required as 'levels' or
+ * 'levels-copy'), e.g. levels "128-137" of "t"
+ *
+ * @param h Handle
+ * @param name Name of the source field
+ * @param levels Level selection, as required by the plugin
+ * @param array Description of the memory of the subset
+ * @return Error code
+ */
+int plume_data_get_array_levels(plume_data_handle_t* h, const char* name, const char* levels, plume_array_t* array);
+
+/**
+ * @brief Whether a parameter has been updated in the current step
+ *
+ * @param h Handle
+ * @param name Name of the parameter
+ * @param updated Updated flag
+ * @return Error code
+ */
+int plume_data_is_updated(plume_data_handle_t* h, const char* name, bool* updated);
+
+/**
+ * @brief Number of times a parameter has been marked as updated, to compare with the last generation seen
+ *
+ * @param h Handle
+ * @param name Name of the parameter
+ * @param generation Generation of the parameter
+ * @return Error code
+ */
+int plume_data_generation(plume_data_handle_t* h, const char* name, uint64_t* generation);
+
+
 /* ----------------- Utils ----------------- */
 /**
  * @brief Print plume data
@@ -457,6 +685,28 @@ int plume_data_print(plume_data_handle_t* h);
  */
 int plume_data_set_updated(plume_data_handle_t* h, const int count, const char** names);
 
+/**
+ * @brief Set params updated flag, from the ids of the updated parameters (see plume_data_param_id)
+ *
+ * @param h Handle
+ * @param count Number of parameters updated
+ * @param ids The ids of the updated parameters
+ * @return Error code
+ */
+int plume_data_set_updated_ids(plume_data_handle_t* h, const int count, const int* ids);
+
+/**
+ * @brief Set params updated flag, from a bitmask of the ids of the updated parameters
+ *
+ * The parameter of id `id` is updated if bit `id % 64` of word `id / 64` is set.
+ *
+ * @param h Handle
+ * @param nwords Number of 64-bit words of the mask
+ * @param mask The bitmask of the updated parameters
+ * @return Error code
+ */
+int plume_data_set_updated_mask(plume_data_handle_t* h, const int nwords, const uint64_t* mask);
+
 
 #if defined(__cplusplus)
 }  // extern "C"
@@ -0,0 +1,105 @@
+/*
+ * (C) Copyright 2025- ECMWF.
+ *
+ * This software is licensed under the terms of the Apache Licence Version 2.0
+ * which can be obtained at http://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * In applying this licence, ECMWF does not waive the privileges and immunities
+ * granted to it by virtue of its status as an intergovernmental organisation nor
+ * does it submit to any jurisdiction.
+ */
+#include <algorithm>
+#include <iomanip>
+#include <ostream>
+
+#include "eckit/exception/Exceptions.h"
+
+#include "plume/data/AccessProfile.h"
+
+
+namespace plume {
+namespace data {
+
+AccessProfile::AccessProfile(const std::vector<std::string>& params) {
+    for (const auto& param : params) {
+        counters_.try_emplace(param);
+    }
+}
+
+
+void AccessProfile::recordRead(const std::string& name) {
+    auto it = counters_.find(name);
+    if (it == counters_.end()) {
+        return;
+    }
+    auto& counter = it->second;
+    counter.reads.fetch_add(1, std::memory_order_relaxed);
+
+    // first read in this step
+    auto step = step_.load(std::memory_order_relaxed);
+    if (counter.lastStep.exchange(step, std::memory_order_relaxed) != step) {
+        counter.stepsRead.fetch_add(1, std::memory_order_relaxed);
+    }
+}
+
+
+void AccessProfile::newStep() {
+    step_.fetch_add(1, std::memory_order_relaxed);
+}
+
+
+std::uint64_t AccessProfile::reads(const std::string& name) const {
+    return counter(name).reads.load(std::memory_order_relaxed);
+}
+
+
+std::uint64_t AccessProfile::stepsRead(const std::string& name) const {
+    return counter(name).stepsRead.load(std::memory_order_relaxed);
+}
+
+
+std::vector<std::string> AccessProfile::unusedParams() const {
+    std::vector<std::string> unused;
+    for (const auto& [name, counter] : counters_) {
+        if (counter.reads.load(std::memory_order_relaxed) == 0) {
+            unused.push_back(name);
+        }
+    }
+    return unused;
+}
+
+
+void AccessProfile::report(std::ostream& out) const {
+
+    size_t width = 9;
+    for (const auto& [name, counter] : counters_) {
+        width = std::max(width, name.size());
+    }
+
+    out << "    " << std::left << std::setw(width) << "parameter" << std::right << std::setw(12) << "reads"
+        << std::setw(12) << "steps-read" << "  (" << steps() << " steps)" << std::endl;
+    for (const auto& [name, counter] : counters_) {
+        out << "    " << std::left << std::setw(width) << name << std::right << std::setw(12)
+            << counter.reads.load(std::memory_order_relaxed) << std::setw(12)
+            << counter.stepsRead.load(std::memory_order_relaxed) << std::endl;
+    }
+
+    auto unused = unusedParams();
+    out << "    negotiated but never read: " << unused.size();
+    for (const auto& name : unused) {
+        out << " " << name;
+    }
+    out << std::endl;
+}
+
+
+const AccessProfile::Counter& AccessProfile::counter(const std::string& name) const {
+    auto it = counters_.find(name);
+    if (it == counters_.end()) {
+        throw eckit::BadParameter("Parameter '" + name + "' not profiled", Here());
+    }
+    return it->second;
+}
+
+}  // namespace data
+}  // namespace plume
@@ -0,0 +1,78 @@
+/*
+ * (C) Copyright 2025- ECMWF.
+ *
+ * This software is licensed under the terms of the Apache Licence Version 2.0
+ * which can be obtained at http://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * In applying this licence, ECMWF does not waive the privileges and immunities
+ * granted to it by virtue of its status as an intergovernmental organisation nor
+ * does it submit to any jurisdiction.
+ */
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <iosfwd>
+#include <limits>
+#include <map>
+#include <string>
+#include <vector>
+
+#include "eckit/memory/NonCopyable.h"
+
+
+namespace plume {
+namespace data {
+
+/**
+ * @brief Counts the reads of a set of parameters (typically those negotiated by a plugin), per step.
+ *
+ * The set of profiled parameters is fixed at construction, so reads can be recorded concurrently without locking.
+ * Reads of derived parameters are recorded under their full name, which identifies the level (e.g. 'u;hl;100').
+ * Reads recorded before the first step (e.g. during plugin setup) are attributed to step 0.
+ */
+class AccessProfile : private eckit::NonCopyable {
+
+public:
+
+    explicit AccessProfile(const std::vector<std::string>& params);
+
+    /// Records a read of a parameter, reads of parameters not profiled are ignored.
+    void recordRead(const std::string& name);
+
+    /// Starts a new step.
+    void newStep();
+
+    /// Number of steps started so far.
+    std::uint64_t steps() const { return step_.load(std::memory_order_relaxed); }
+
+    /// Total number of reads of a parameter.
+    std::uint64_t reads(const std::string& name) const;
+
+    /// Number of steps in which a parameter has been read at least once.
+    std::uint64_t stepsRead(const std::string& name) const;
+
+    /// Profiled parameters never read.
+    std::vector<std::string> unusedParams() const;
+
+    /// Writes a table of reads per parameter, followed by the parameters never read.
+    void report(std::ostream& out) const;
+
+private:
+
+    struct Counter {
+        std::atomic<std::uint64_t> reads{0};
+        std::atomic<std::uint64_t> stepsRead{0};
+        std::atomic<std::uint64_t> lastStep{std::numeric_limits<std::uint64_t>::max()};
+    };
+
+    const Counter& counter(const std::string& name) const;
+
+    // node-based container, counters are never moved
+    std::map<std::string, Counter> counters_;
+
+    std::atomic<std::uint64_t> step_{0};
+};
+
+}  // namespace data
+}  // namespace plume
@@ -0,0 +1,114 @@
+/*
+ * (C) Copyright 2025- ECMWF.
+ *
+ * This software is licensed under the terms of the Apache Licence Version 2.0
+ * which can be obtained at http://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * In applying this licence, ECMWF does not waive the privileges and immunities
+ * granted to it by virtue of its status as an intergovernmental organisation nor
+ * does it submit to any jurisdiction.
+ */
+#include "plume/data/ArrayView.h"
+
+
+namespace plume {
+namespace data {
+
+ArrayView::ArrayView(const void* data, const std::string& datatype, const std::vector<long>& shape,
+                     const std::vector<long>& strides) :
+    data_{data}, datatype_{dataTypeFromString(datatype)}, rank_{shape.size()} {
+    ASSERT_MSG(data != nullptr, "ArrayView: null data pointer");
+    ASSERT_MSG(rank_ > 0 && rank_ <= maxRank, "ArrayView: rank must be between 1 and " + std::to_string(maxRank));
+    ASSERT_MSG(strides.empty() || strides.size() == rank_, "ArrayView: strides and shape of different ranks");
+    for (std::size_t dim = 0; dim < rank_; ++dim) {
+        ASSERT_MSG(shape[dim] >= 0, "ArrayView: negative extent");
+        shape_[dim] = shape[dim];
+    }
+    long stride = 1;
+    for (std::size_t dim = rank_; dim-- > 0;) {
+        strides_[dim] = strides.empty() ? stride : strides[dim];
+        stride *= shape_[dim];
+    }
+}
+
+
+ArrayView::DataType ArrayView::dataTypeFromString(const std::string& datatype) {
+    if (datatype == "real32" || datatype == "float") {
+        return DataType::REAL32;
+    }
+    if (datatype == "real64" || datatype == "double") {
+        return DataType::REAL64;
+    }
+    if (datatype == "int32") {
+        return DataType::INT32;
+    }
+    if (datatype == "int64") {
+        return DataType::INT64;
+    }
+    throw eckit::BadValue("ArrayView: datatype '" + datatype + "' not supported (real32, real64, int32 or int64)",
+                          Here());
+}
+
+
+const char* ArrayView::dataTypeToString(DataType datatype) {
+    switch (datatype) {
+        case DataType::REAL32:
+            return "real32";
+        case DataType::REAL64:
+            return "real64";
+        case DataType::INT32:
+            return "int32";
+        case DataType::INT64:
+            return "int64";
+    }
+    throw eckit::BadValue("ArrayView: datatype invalid", Here());
+}
+
+
+std::size_t ArrayView::elementSize(DataType datatype) {
+    return datatype == DataType::REAL32 || datatype == DataType::INT32 ? 4 : 8;
+}
+
+
+std::size_t ArrayView::size() const {
+    if (rank_ == 0) {
+        return 0;
+    }
+    std::size_t size = 1;
+    for (std::size_t dim = 0; dim < rank_; ++dim) {
+        size *= static_cast<std::size_t>(shape_[dim]);
+    }
+    return size;
+}
+
+
+bool ArrayView::contiguous() const {
+    long rowMajor    = 1;
+    long columnMajor = 1;
+    bool isRowMajor  = true;
+    bool isColMajor  = true;
+    for (std::size_t dim = 0; dim < rank_; ++dim) {
+        std::size_t back = rank_ - 1 - dim;
+        isRowMajor       = isRowMajor && (shape_[back] == 1 || strides_[back] == rowMajor);
+        isColMajor       = isColMajor && (shape_[dim] == 1 || strides_[dim] == columnMajor);
+        rowMajor *= shape_[back];
+        columnMajor *= shape_[dim];
+    }
+    return isRowMajor || isColMajor;
+}
+
+
+std::ostream& operator<<(std::ostream& os, const ArrayView& view) {
+    os << "ArrayView(" << view.datatype() << ", shape [";
+    for (std::size_t dim = 0; dim < view.rank(); ++dim) {
+        os << (dim ? ", " : "") << view.shape(dim);
+    }
+    os << "], strides [";
+    for (std::size_t dim = 0; dim < view.rank(); ++dim) {
+        os << (dim ? ", " : "") << view.stride(dim);
+    }
+    return os << "])";
+}
+
+}  // namespace data
+}  // namespace plume
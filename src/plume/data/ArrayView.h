@@ -0,0 +1,146 @@
+/*
+ * (C) Copyright 2025- ECMWF.
+ *
+ * This software is licensed under the terms of the Apache Licence Version 2.0
+ * which can be obtained at http://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * In applying this licence, ECMWF does not waive the privileges and immunities
+ * granted to it by virtue of its status as an intergovernmental organisation nor
+ * does it submit to any jurisdiction.
+ */
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <ostream>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+#include "eckit/exception/Exceptions.h"
+
+
+namespace plume {
+namespace data {
+
+/**
+ * @brief Non-owning view of a strided array owned by the model (type ARRAY), for models and plugins without Atlas
+ *
+ * A view is a pointer, a datatype ("real32", "real64", "int32" or "int64", as Atlas names them), a shape and strides
+ * in elements. The memory is never copied: plugins read the model arrays in place. Views are read-only, only the model
+ * (which owns the array) writes to it. Views are small and copied without allocating (the rank is at most `maxRank`).
+ *
+ * Strides default to a contiguous row-major (C) layout, Fortran arrays pass their column-major strides.
+ */
+class ArrayView {
+public:
+    static constexpr std::size_t maxRank = 4;
+
+    enum class DataType
+    {
+        REAL32,
+        REAL64,
+        INT32,
+        INT64
+    };
+
+    /// Empty view (rank 0, no data)
+    ArrayView() = default;
+
+    /**
+     * @param data first element of the array
+     * @param datatype e.g. "real64"
+     * @param shape extent of each dimension
+     * @param strides distance between consecutive elements of each dimension, in elements (row-major if empty)
+     */
+    ArrayView(const void* data, const std::string& datatype, const std::vector<long>& shape,
+              const std::vector<long>& strides = {});
+
+    static DataType dataTypeFromString(const std::string& datatype);
+    static const char* dataTypeToString(DataType datatype);
+    static std::size_t elementSize(DataType datatype);
+
+    /// Data type of a C++ type, e.g. `double` for REAL64
+    template <typename T>
+    static constexpr DataType dataTypeOf() {
+        static_assert(std::is_same_v<T, float> || std::is_same_v<T, double> || std::is_same_v<T, std::int32_t> ||
+                          std::is_same_v<T, std::int64_t>,
+                      "ArrayView: unsupported element type");
+        if constexpr (std::is_same_v<T, float>) {
+            return DataType::REAL32;
+        }
+        else if constexpr (std::is_same_v<T, double>) {
+            return DataType::REAL64;
+        }
+        else if constexpr (std::is_same_v<T, std::int32_t>) {
+            return DataType::INT32;
+        }
+        else {
+            return DataType::INT64;
+        }
+    }
+
+    const void* data() const { return data_; }
+
+    /// Typed pointer to the first element, throws if the datatype differs
+    template <typename T>
+    const T* data() const {
+        if (dataTypeOf<std::remove_const_t<T>>() != datatype_) {
+            throw eckit::BadCast(std::string("ArrayView: array of ") + datatype() + " accessed as " +
+                                     dataTypeToString(dataTypeOf<std::remove_const_t<T>>()),
+                                 Here());
+        }
+        return static_cast<const T*>(data_);
+    }
+
+    const char* datatype() const { return dataTypeToString(datatype_); }
+    DataType dataType() const { return datatype_; }
+    std::size_t elementSize() const { return elementSize(datatype_); }
+
+    std::size_t rank() const { return rank_; }
+    long shape(std::size_t dim) const { return shape_[dim]; }
+    long stride(std::size_t dim) const { return strides_[dim]; }
+
+    /// Shape as a vector, e.g. to offer the array (allocates, not for the time loop)
+    std::vector<long> shape() const { return {shape_.begin(), shape_.begin() + rank_}; }
+
+    /// Number of elements
+    std::size_t size() const;
+
+    /// Number of bytes of the elements (not of the gaps between strided elements)
+    std::size_t bytes() const { return size() * elementSize(); }
+
+    /// Whether the elements are contiguous in memory, in row-major or column-major order
+    bool contiguous() const;
+
+    /// Offset of an element from the first one, in elements
+    template <typename... Index>
+    std::ptrdiff_t offset(Index... index) const {
+        static_assert(sizeof...(Index) <= maxRank, "ArrayView: too many indices");
+        const std::array<long, sizeof...(Index)> indices{static_cast<long>(index)...};
+        std::ptrdiff_t offset = 0;
+        for (std::size_t dim = 0; dim < indices.size(); ++dim) {
+            offset += indices[dim] * strides_[dim];
+        }
+        return offset;
+    }
+
+    /// Element of the array (no bound checks)
+    template <typename T, typename... Index>
+    const T& at(Index... index) const {
+        return data<T>()[offset(index...)];
+    }
+
+    friend std::ostream& operator<<(std::ostream& os, const ArrayView& view);
+
+private:
+    const void* data_   = nullptr;
+    DataType datatype_  = DataType::REAL64;
+    std::size_t rank_   = 0;
+    std::array<long, maxRank> shape_{};
+    std::array<long, maxRank> strides_{};
+};
+
+}  // namespace data
+}  // namespace plume
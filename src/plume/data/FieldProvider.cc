@@ -8,12 +8,26 @@
  * granted to it by virtue of its status as an intergovernmental organisation nor
  * does it submit to any jurisdiction.
  */
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <limits>
+#include <set>
 #include <sstream>
 
 #include "atlas/array.h"
+#include "atlas/functionspace/StructuredColumns.h"
 
+#include "plume/Metrics.h"
+
+#include "plume/ThreadAffinity.h"
+#include "plume/ThreadPool.h"
 #include "plume/data/FieldProvider.h"
+#include "plume/data/HorizontalDerivatives.h"
 #include "plume/data/ParameterValue.h"
+#include "plume/data/Reductions.h"
+#include "plume/data/StationExtraction.h"
+#include "plume/data/StrategyContext.h"
 
 namespace plume {
 namespace field_provider {
@@ -93,7 +107,11 @@ WindAtHeight::WindAtHeight(std::size_t height, AtlasFieldObservablePtr geopotent
     ASSERT(target);
 
     const auto& field3d = target->get();
-    atlas::Field field2d(field3d.name(), field3d.datatype(), atlas::array::make_shape(field3d.shape(0), 1));
+    atlas::Field field2d;
+    ThreadAffinity::current().firstTouch([&]() {
+        field2d = atlas::Field(field3d.name(), field3d.datatype(), atlas::array::make_shape(field3d.shape(0), 1));
+        std::memset(field2d.storage(), 0, field2d.bytes());
+    });
     field2d.metadata() = field3d.metadata();
     field2d.set_levels(1);
     field2d.set_functionspace(field3d.functionspace());
@@ -158,6 +176,1078 @@ void WindAtHeight::update() {
 
     windAtHeightField->setUpdated(true);
 }
+
+// ---------------------------------------------------------------------------------------------------------------------
+// Level subsets
+// ---------------------------------------------------------------------------------------------------------------------
+std::vector<std::size_t> parseLevels(const std::string& selection) {
+
+    auto toLevel = [&selection](const std::string& str) -> std::size_t {
+        std::size_t pos = 0;
+        long level      = -1;
+        try {
+            level = std::stol(str, &pos);
+        }
+        catch (const std::exception&) {
+            pos = 0;
+        }
+        if (pos == 0 || pos != str.size() || level < 1) {
+            throw eckit::BadValue("Invalid level selection '" + selection + "'", Here());
+        }
+        return static_cast<std::size_t>(level);
+    };
+
+    std::set<std::size_t> levels;
+    std::stringstream ss(selection);
+    std::string item;
+    while (std::getline(ss, item, ',')) {
+        std::size_t step = 1;
+        auto slash       = item.find('/');
+        if (slash != std::string::npos) {
+            step = toLevel(item.substr(slash + 1));
+            item = item.substr(0, slash);
+        }
+        auto dash = item.find('-');
+        if (dash == std::string::npos) {
+            levels.insert(toLevel(item));
+            continue;
+        }
+        auto first = toLevel(item.substr(0, dash));
+        auto last  = toLevel(item.substr(dash + 1));
+        if (first > last) {
+            throw eckit::BadValue("Invalid level range in selection '" + selection + "'", Here());
+        }
+        for (auto level = first; level <= last; level += step) {
+            levels.insert(level);
+        }
+    }
+
+    if (levels.empty()) {
+        throw eckit::BadValue("Empty level selection '" + selection + "'", Here());
+    }
+    return {levels.begin(), levels.end()};
+}
+
+namespace {
+
+// checks that the selected levels exist in the (npoints, nlev) source field
+void checkLevels(const std::vector<std::size_t>& levels, const atlas::Field& source) {
+    if (source.rank() != 2) {
+        throw eckit::BadValue("Level selection of field '" + source.name() + "' requires a (npoints, nlev) field",
+                              Here());
+    }
+    if (levels.back() > static_cast<std::size_t>(source.shape(1))) {
+        std::ostringstream msg;
+        msg << "Level " << levels.back() << " selected, but field '" << source.name() << "' has only "
+            << source.shape(1) << " levels";
+        throw eckit::BadValue(msg.str(), Here());
+    }
+}
+
+// the target is a clone of the source, keep its name and (plume) metadata
+atlas::Field finaliseSubset(atlas::Field subset, const atlas::Field& target, const std::string& levels) {
+    subset.metadata() = target.metadata();
+    subset.metadata().set("levels", levels);
+    subset.set_levels(subset.shape(1));
+    subset.set_functionspace(target.functionspace());
+    return subset;
+}
+
+}  // namespace
+
+
+LevelView::LevelView(std::string levels, AtlasFieldObservablePtr source, AtlasFieldObserverPtr target) :
+    levels_(parseLevels(levels)), source_(source), target_(target) {
+
+    auto sourceField = source_.lock();
+    auto targetField = target_.lock();
+    ASSERT(sourceField && targetField);
+
+    const auto& field = sourceField->get();
+    checkLevels(levels_, field);
+
+    std::size_t step = levels_.size() > 1 ? levels_[1] - levels_[0] : 1;
+    for (std::size_t i = 1; i < levels_.size(); ++i) {
+        if (levels_[i] - levels_[i - 1] != step) {
+            throw eckit::BadValue("Level selection '" + levels +
+                                      "' is not regularly spaced and cannot be viewed, use 'levels-copy' instead",
+                                  Here());
+        }
+    }
+
+    // same memory, first selected level, every step-th level
+    atlas::array::ArrayShape shape{field.shape(0), static_cast<atlas::idx_t>(levels_.size())};
+    atlas::array::ArrayStrides strides{field.stride(0), static_cast<atlas::idx_t>(field.stride(1) * step)};
+    atlas::array::ArraySpec spec(shape, strides);
+
+    const auto& name = targetField->get().name();
+    auto offset      = static_cast<std::size_t>(field.stride(1)) * (levels_.front() - 1);
+    auto& provided   = sourceField->getProvidedField();
+
+    atlas::Field view;
+    const auto dt = field.datatype();
+    if (dt == atlas::array::DataType::real32()) {
+        view = atlas::Field(name, provided.data<float>() + offset, spec);
+    }
+    else if (dt == atlas::array::DataType::real64()) {
+        view = atlas::Field(name, provided.data<double>() + offset, spec);
+    }
+    else {
+        throw eckit::BadValue("Unsupported field value type for level selection (expected float or double)", Here());
+    }
+    targetField->set(finaliseSubset(view, targetField->get(), levels));
+}
+
+void LevelView::update() {
+    auto sourceField = source_.lock();
+    auto targetField = target_.lock();
+    ASSERT(sourceField && targetField);
+
+    sourceField->get();  // produces the source values, if provided lazily
+    targetField->setUpdated(true);
+}
+
+
+LevelCopy::LevelCopy(std::string levels, AtlasFieldObservablePtr source, AtlasFieldObserverPtr target) :
+    levels_(parseLevels(levels)), source_(source), target_(target) {
+
+    auto sourceField = source_.lock();
+    auto targetField = target_.lock();
+    ASSERT(sourceField && targetField);
+
+    const auto& field = sourceField->get();
+    checkLevels(levels_, field);
+
+    const auto& name = targetField->get().name();
+    atlas::Field subset;
+    ThreadAffinity::current().firstTouch([&]() {
+        subset = atlas::Field(name, field.datatype(),
+                              atlas::array::make_shape(field.shape(0), static_cast<atlas::idx_t>(levels_.size())));
+        std::memset(subset.storage(), 0, subset.bytes());
+    });
+    targetField->set(finaliseSubset(subset, targetField->get(), levels));
+}
+
+void LevelCopy::update() {
+    auto sourceField = source_.lock();
+    auto targetField = target_.lock();
+    ASSERT(sourceField && targetField);
+
+    auto copy = [&](auto make_view_t) {
+        using FIELD_TYPE_REAL = decltype(make_view_t);
+
+        auto source = atlas::array::make_view<FIELD_TYPE_REAL, 2>(sourceField->get());
+        auto target = atlas::array::make_view<FIELD_TYPE_REAL, 2>(targetField->getSettableField());
+
+        for (atlas::idx_t i = 0; i < target.shape(0); ++i) {
+            for (std::size_t k = 0; k < levels_.size(); ++k) {
+                target(i, k) = source(i, levels_[k] - 1);
+            }
+        }
+        Metrics::instance().addBytesCopied(target.size() * sizeof(FIELD_TYPE_REAL));
+    };
+
+    const auto dt = sourceField->get().datatype();
+    if (dt == atlas::array::DataType::real32()) {
+        copy(float{});
+    }
+    else if (dt == atlas::array::DataType::real64()) {
+        copy(double{});
+    }
+    else {
+        throw eckit::BadValue("Unsupported field value type for level selection (expected float or double)", Here());
+    }
+
+    targetField->setUpdated(true);
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+// Regional subsets
+// ---------------------------------------------------------------------------------------------------------------------
+Area Area::parse(const std::string& area) {
+    std::vector<double> values;
+    std::stringstream ss(area);
+    std::string item;
+    while (std::getline(ss, item, '/')) {
+        std::size_t pos = 0;
+        try {
+            values.push_back(std::stod(item, &pos));
+        }
+        catch (const std::exception&) {
+            pos = 0;
+        }
+        if (pos == 0 || pos != item.size()) {
+            throw eckit::BadValue("Invalid area '" + area + "' (expected N/W/S/E in degrees)", Here());
+        }
+    }
+    if (values.size() != 4 || values[0] < values[2] || values[0] > 90. || values[2] < -90.) {
+        throw eckit::BadValue("Invalid area '" + area + "' (expected N/W/S/E in degrees)", Here());
+    }
+    return Area{values[0], values[1], values[2], values[3]};
+}
+
+bool Area::contains(double lon, double lat) const {
+    if (lat < south || lat > north) {
+        return false;
+    }
+    double width = east - west;
+    if (width >= 360.) {
+        return true;
+    }
+    if (width < 0.) {
+        width += 360.;  // across the date line
+    }
+    double dlon = std::fmod(lon - west, 360.);
+    if (dlon < 0.) {
+        dlon += 360.;
+    }
+    return dlon <= width;
+}
+
+
+std::vector<bool> ownedPoints(const atlas::FunctionSpace& functionspace, atlas::idx_t npoints) {
+    std::vector<bool> owned(npoints, true);
+    if (!functionspace) {
+        return owned;
+    }
+
+    // halo points are owned (and processed) by another partition
+    atlas::Field ghost;
+    try {
+        ghost = functionspace.ghost();
+    }
+    catch (const eckit::Exception&) {
+        return owned;  // no ghost points in this function space
+    }
+    auto ghostView = atlas::array::make_view<int, 1>(ghost);
+    for (atlas::idx_t i = 0; i < npoints; ++i) {
+        owned[i] = !ghostView(i);
+    }
+    return owned;
+}
+
+
+std::shared_ptr<const std::vector<atlas::idx_t>> regionIndices(data::StrategyContext& context,
+                                                               const atlas::FunctionSpace& functionspace,
+                                                               const std::string& area) {
+    if (!functionspace) {
+        throw eckit::BadValue("Regional subsets require fields defined on a function space", Here());
+    }
+
+    return context.cached<std::vector<atlas::idx_t>>(functionspace, area, [&]() {
+        auto box    = Area::parse(area);
+        auto lonlat = atlas::array::make_view<double, 2>(functionspace.lonlat());
+        auto owned  = ownedPoints(functionspace, lonlat.shape(0));
+
+        auto indices = std::make_shared<std::vector<atlas::idx_t>>();
+        for (atlas::idx_t i = 0; i < lonlat.shape(0); ++i) {
+            if (owned[i] && box.contains(lonlat(i, 0), lonlat(i, 1))) {
+                indices->push_back(i);
+            }
+        }
+        return indices;
+    });
+}
+
+
+AreaSubset::AreaSubset(std::string area, AtlasFieldObservablePtr source, AtlasFieldObserverPtr target) :
+    source_(source), target_(target) {
+
+    auto sourceField = source_.lock();
+    auto targetField = target_.lock();
+    ASSERT(sourceField && targetField);
+
+    const auto& field = sourceField->get();
+    if (field.rank() > 2) {
+        throw eckit::BadValue("Regional subset of field '" + field.name() + "' requires a (npoints[, nlev]) field",
+                              Here());
+    }
+    indices_ = regionIndices(*data::StrategyContext::current(), field.functionspace(), area);
+
+    auto shape = field.shape();
+    shape[0]   = static_cast<atlas::idx_t>(indices_->size());
+
+    const auto& name = targetField->get().name();
+    atlas::Field subset;
+    ThreadAffinity::current().firstTouch([&]() {
+        subset = atlas::Field(name, field.datatype(), shape);
+        if (subset.bytes() > 0) {  // no points of the area on this partition
+            std::memset(subset.storage(), 0, subset.bytes());
+        }
+    });
+    subset.metadata() = targetField->get().metadata();
+    subset.metadata().set("area", area);
+    subset.metadata().set("points", indices_->size());
+    if (field.rank() == 2) {
+        subset.set_levels(subset.shape(1));
+    }
+    targetField->set(subset);
+}
+
+void AreaSubset::update() {
+    auto sourceField = source_.lock();
+    auto targetField = target_.lock();
+    ASSERT(sourceField && targetField);
+
+    const auto& indices = *indices_;
+    auto gather         = [&](auto make_view_t) {
+        using FIELD_TYPE = decltype(make_view_t);
+
+        const auto& field = sourceField->get();
+        if (field.rank() == 1) {
+            auto source = atlas::array::make_view<FIELD_TYPE, 1>(field);
+            auto target = atlas::array::make_view<FIELD_TYPE, 1>(targetField->getSettableField());
+            for (std::size_t i = 0; i < indices.size(); ++i) {
+                target(i) = source(indices[i]);
+            }
+            Metrics::instance().addBytesCopied(indices.size() * sizeof(FIELD_TYPE));
+            return;
+        }
+        auto source = atlas::array::make_view<FIELD_TYPE, 2>(field);
+        auto target = atlas::array::make_view<FIELD_TYPE, 2>(targetField->getSettableField());
+        for (std::size_t i = 0; i < indices.size(); ++i) {
+            for (atlas::idx_t k = 0; k < target.shape(1); ++k) {
+                target(i, k) = source(indices[i], k);
+            }
+        }
+        Metrics::instance().addBytesCopied(indices.size() * target.shape(1) * sizeof(FIELD_TYPE));
+    };
+
+    const auto dt = sourceField->get().datatype();
+    if (dt == atlas::array::DataType::real32()) {
+        gather(float{});
+    }
+    else if (dt == atlas::array::DataType::real64()) {
+        gather(double{});
+    }
+    else if (dt == atlas::array::DataType::int32()) {
+        gather(int{});
+    }
+    else {
+        throw eckit::BadValue("Unsupported field value type for regional subset (expected float, double or int)",
+                              Here());
+    }
+
+    targetField->setUpdated(true);
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+// Representations
+// ---------------------------------------------------------------------------------------------------------------------
+namespace {
+
+// square tiles of the level-major transposition, small enough to stay in L1 (in double precision)
+constexpr atlas::idx_t TILE = 32;
+
+// points converted by a task of the thread pool (whole tiles, so that tasks write whole cache lines)
+constexpr atlas::idx_t BLOCK = 256 * TILE;
+
+// converts the points [begin, end)
+template <typename S, typename T>
+void convertPoints(const atlas::Field& sourceField, atlas::Field& targetField, bool levelMajor, atlas::idx_t begin,
+                   atlas::idx_t end) {
+    if (sourceField.rank() == 1) {
+        auto source = atlas::array::make_view<S, 1>(sourceField);
+        auto target = atlas::array::make_view<T, 1>(targetField);
+        for (atlas::idx_t i = begin; i < end; ++i) {
+            target(i) = static_cast<T>(source(i));
+        }
+        return;
+    }
+
+    auto source = atlas::array::make_view<S, 2>(sourceField);
+    auto target = atlas::array::make_view<T, 2>(targetField);
+    if (!levelMajor) {
+        for (atlas::idx_t i = begin; i < end; ++i) {
+            for (atlas::idx_t k = 0; k < source.shape(1); ++k) {
+                target(i, k) = static_cast<T>(source(i, k));
+            }
+        }
+        return;
+    }
+
+    // blocked transposition, both the reads and the writes of a tile are (mostly) contiguous
+    const atlas::idx_t nlev = source.shape(1);
+    for (atlas::idx_t i0 = begin; i0 < end; i0 += TILE) {
+        const atlas::idx_t i1 = std::min(i0 + TILE, end);
+        for (atlas::idx_t k0 = 0; k0 < nlev; k0 += TILE) {
+            const atlas::idx_t k1 = std::min(k0 + TILE, nlev);
+            for (atlas::idx_t k = k0; k < k1; ++k) {
+                for (atlas::idx_t i = i0; i < i1; ++i) {
+                    target(k, i) = static_cast<T>(source(i, k));
+                }
+            }
+        }
+    }
+}
+
+// converts blocks of points on the pool (if any, and if there is more than one block)
+template <typename S, typename T>
+void convertField(const atlas::Field& sourceField, atlas::Field& targetField, bool levelMajor, ThreadPool* pool) {
+    Metrics::instance().addBytesCopied(sourceField.size() * sizeof(T));
+
+    const atlas::idx_t npoints = sourceField.shape(0);
+    const std::size_t nblocks  = (npoints + BLOCK - 1) / BLOCK;
+    auto block                 = [&](std::size_t b) {
+        const atlas::idx_t begin = static_cast<atlas::idx_t>(b) * BLOCK;
+        convertPoints<S, T>(sourceField, targetField, levelMajor, begin, std::min(begin + BLOCK, npoints));
+    };
+    if (pool && nblocks > 1) {
+        pool->parallelFor(nblocks, block);
+        return;
+    }
+    for (std::size_t b = 0; b < nblocks; ++b) {
+        block(b);
+    }
+}
+
+// converts the source into the target, dispatching on their precisions
+void convertField(const atlas::Field& source, atlas::Field& target, bool levelMajor, ThreadPool* pool) {
+    const bool sourceDouble = source.datatype() == atlas::array::DataType::real64();
+    const bool targetDouble = target.datatype() == atlas::array::DataType::real64();
+    if (sourceDouble && targetDouble) {
+        convertField<double, double>(source, target, levelMajor, pool);
+    }
+    else if (sourceDouble) {
+        convertField<double, float>(source, target, levelMajor, pool);
+    }
+    else if (targetDouble) {
+        convertField<float, double>(source, target, levelMajor, pool);
+    }
+    else {
+        convertField<float, float>(source, target, levelMajor, pool);
+    }
+}
+
+atlas::array::DataType representationType(const std::string& precision, const atlas::Field& source) {
+    if (precision.empty()) {
+        return source.datatype();
+    }
+    if (precision == "float") {
+        return atlas::array::DataType::real32();
+    }
+    if (precision == "double") {
+        return atlas::array::DataType::real64();
+    }
+    throw eckit::BadValue("Invalid precision '" + precision + "' (expected float or double)", Here());
+}
+
+}  // namespace
+
+
+Representation::Representation(std::string precision, std::string layout, AtlasFieldObservablePtr source,
+                               AtlasFieldObserverPtr target) :
+    levelMajor_(layout == "level-major"), context_(data::StrategyContext::current()), source_(source), target_(target) {
+
+    if (!layout.empty() && layout != "level-major" && layout != "point-major") {
+        throw eckit::BadValue("Invalid layout '" + layout + "' (expected point-major or level-major)", Here());
+    }
+
+    auto sourceField = source_.lock();
+    auto targetField = target_.lock();
+    ASSERT(sourceField && targetField);
+
+    const auto& field = sourceField->get();
+    if (field.datatype() != atlas::array::DataType::real32() && field.datatype() != atlas::array::DataType::real64()) {
+        throw eckit::BadValue("Unsupported field value type for representation (expected float or double)", Here());
+    }
+    if (field.rank() > 2) {
+        throw eckit::BadValue("Representation of field '" + field.name() + "' requires a (npoints[, nlev]) field",
+                              Here());
+    }
+
+    auto shape = field.shape();
+    if (levelMajor_ && field.rank() == 2) {
+        std::swap(shape[0], shape[1]);
+    }
+
+    const auto& name = targetField->get().name();
+    atlas::Field converted;
+    ThreadAffinity::current().firstTouch([&]() {
+        converted = atlas::Field(name, representationType(precision, field), shape);
+        std::memset(converted.storage(), 0, converted.bytes());
+    });
+    converted.metadata() = targetField->get().metadata();
+    converted.metadata().set("precision", precision.empty() ? std::string("source") : precision);
+    converted.metadata().set("layout", levelMajor_ ? std::string("level-major") : std::string("point-major"));
+    if (!levelMajor_) {
+        converted.set_levels(field.levels());
+        converted.set_functionspace(field.functionspace());
+    }
+    targetField->set(converted);
+}
+
+void Representation::update() {
+    auto sourceField = source_.lock();
+    auto targetField = target_.lock();
+    ASSERT(sourceField && targetField);
+
+    convertField(sourceField->get(), targetField->getSettableField(), levelMajor_, context_->threadPool());
+
+    targetField->setUpdated(true);
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+// Global statistics
+// ---------------------------------------------------------------------------------------------------------------------
+GlobalStatistic::GlobalStatistic(std::string statistic, AtlasFieldObservablePtr source, AtlasFieldObserverPtr target) :
+    statistic_(std::move(statistic)), context_(data::StrategyContext::current()), source_(source), target_(target) {
+
+    auto sourceField = source_.lock();
+    auto targetField = target_.lock();
+    ASSERT(sourceField && targetField);
+
+    const auto& field = sourceField->get();
+    if (field.rank() > 2) {
+        throw eckit::BadValue("Statistics of field '" + field.name() + "' require a (npoints[, nlev]) field", Here());
+    }
+    const atlas::idx_t nlev = field.rank() == 2 ? field.shape(1) : 1;
+
+    atlas::array::ArrayShape shape{nlev};
+    if (statistic_ == "zonal-mean") {
+        atlas::functionspace::StructuredColumns fs(field.functionspace());
+        if (!fs.valid()) {
+            throw eckit::BadValue("Zonal means of field '" + field.name() + "' require a field on StructuredColumns",
+                                  Here());
+        }
+        shape = atlas::array::make_shape(fs.grid().ny(), nlev);
+    }
+    else {
+        data::statisticFromString(statistic_);  // validates the statistic
+    }
+
+    const auto& name = targetField->get().name();
+    atlas::Field values(name, atlas::array::DataType::real64(), shape);
+    std::memset(values.storage(), 0, values.bytes());
+    values.metadata() = targetField->get().metadata();
+    values.metadata().set("statistic", statistic_);
+    targetField->set(values);
+}
+
+void GlobalStatistic::update() {
+    auto sourceField = source_.lock();
+    auto targetField = target_.lock();
+    ASSERT(sourceField && targetField);
+
+    // computed with the other statistics of the step
+    auto& reductions  = context_->reductions();
+    const auto& field = sourceField->get();
+    auto handle       = statistic_ == "zonal-mean" ? reductions.addZonalMean(field)
+                                                   : reductions.add(field, data::statisticFromString(statistic_));
+
+    context_->defer([this, &reductions, handle]() {
+        auto targetField = target_.lock();
+        ASSERT(targetField);
+
+        const auto& result = reductions.result(handle);
+        auto& target       = targetField->getSettableField();
+        std::copy(result.begin(), result.end(), target.data<double>());
+
+        targetField->setUpdated(true);
+    });
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+// Threshold exceedance
+// ---------------------------------------------------------------------------------------------------------------------
+namespace {
+
+// parses "[>|<]value[/steps]"
+bool parseThreshold(const std::string& threshold, bool& above, double& value, std::size_t& steps) {
+    std::string spec = threshold;
+    if (!spec.empty() && (spec[0] == '>' || spec[0] == '<')) {
+        above = spec[0] == '>';
+        spec  = spec.substr(1);
+    }
+    auto slash        = spec.find('/');
+    std::string level = spec.substr(0, slash);
+    try {
+        std::size_t pos = 0;
+        value           = std::stod(level, &pos);
+        if (pos != level.size()) {
+            return false;
+        }
+        if (slash != std::string::npos) {
+            std::string count = spec.substr(slash + 1);
+            long n            = std::stol(count, &pos);
+            if (pos != count.size() || n < 1 || n > std::numeric_limits<std::uint16_t>::max()) {
+                return false;
+            }
+            steps = static_cast<std::size_t>(n);
+        }
+    }
+    catch (const std::exception&) {
+        return false;
+    }
+    return true;
+}
+
+}  // namespace
+
+
+ThresholdExceedance::ThresholdExceedance(std::string threshold, std::string count, AtlasFieldObservablePtr source,
+                                         AtlasFieldObserverPtr target) :
+    above_(true),
+    threshold_(0.),
+    steps_(1),
+    globalCount_(count == "global"),
+    context_(data::StrategyContext::current()),
+    source_(source),
+    target_(target) {
+
+    if (!parseThreshold(threshold, above_, threshold_, steps_)) {
+        throw eckit::BadValue("Invalid threshold '" + threshold + "' (expected [>|<]value[/steps])", Here());
+    }
+    if (count != "local" && count != "global") {
+        throw eckit::BadValue("Invalid count '" + count + "' (expected local or global)", Here());
+    }
+
+    auto sourceField = source_.lock();
+    auto targetField = target_.lock();
+    ASSERT(sourceField && targetField);
+
+    const auto& field = sourceField->get();
+    if (field.rank() > 2) {
+        throw eckit::BadValue("Threshold exceedance of field '" + field.name() + "' requires a (npoints[, nlev]) field",
+                              Here());
+    }
+    if (field.datatype() != atlas::array::DataType::real32() && field.datatype() != atlas::array::DataType::real64()) {
+        throw eckit::BadValue("Unsupported field value type for threshold exceedance (expected float or double)",
+                              Here());
+    }
+
+    const atlas::idx_t npoints = field.shape(0);
+    const atlas::idx_t nlev    = field.rank() == 2 ? field.shape(1) : 1;
+    owned_                     = ownedPoints(field.functionspace(), npoints);
+    if (field.functionspace()) {
+        lonlat_ = field.functionspace().lonlat();
+    }
+    if (steps_ > 1) {
+        runs_.assign(npoints * nlev, 0);
+    }
+    hits_.resize(npoints * nlev);
+
+    // room for all the points, so that the target is never reallocated
+    atlas::Field rows(targetField->get().name(), atlas::array::DataType::real64(),
+                      atlas::array::make_shape(npoints * nlev, static_cast<atlas::idx_t>(Columns)));
+    atlas::array::make_view<double, 2>(rows).assign(std::numeric_limits<double>::quiet_NaN());
+    rows.metadata() = targetField->get().metadata();
+    rows.metadata().set("threshold", threshold);
+    rows.metadata().set("count", 0);
+    targetField->set(rows);
+}
+
+template <typename T>
+std::size_t ThresholdExceedance::compact(const atlas::Field& field) {
+    const atlas::idx_t npoints = field.shape(0);
+    const atlas::idx_t nlev    = field.rank() == 2 ? field.shape(1) : 1;
+    const T threshold          = static_cast<T>(threshold_);
+
+    // branchless compaction: every candidate index is written, the output position only advances on exceedance
+    std::size_t n = 0;
+    auto pass     = [&](auto&& value) {
+        for (atlas::idx_t i = 0; i < npoints; ++i) {
+            if (!owned_[i]) {
+                continue;
+            }
+            for (atlas::idx_t k = 0; k < nlev; ++k) {
+                const T x      = value(i, k);
+                bool hit       = above_ ? x > threshold : x < threshold;
+                const auto idx = i * nlev + k;
+                if (steps_ > 1) {
+                    auto& run = runs_[idx];
+                    run       = hit ? std::min<int>(run + 1, std::numeric_limits<std::uint16_t>::max()) : 0;
+                    hit       = run >= steps_;
+                }
+                hits_[n] = idx;
+                n += hit;
+            }
+        }
+    };
+
+    if (field.rank() == 1) {
+        auto view = atlas::array::make_view<T, 1>(field);
+        pass([&view](atlas::idx_t i, atlas::idx_t) { return view(i); });
+    }
+    else {
+        auto view = atlas::array::make_view<T, 2>(field);
+        pass([&view](atlas::idx_t i, atlas::idx_t k) { return view(i, k); });
+    }
+    return n;
+}
+
+void ThresholdExceedance::update() {
+    auto sourceField = source_.lock();
+    auto targetField = target_.lock();
+    ASSERT(sourceField && targetField);
+
+    const auto& field       = sourceField->get();
+    const bool single       = field.datatype() == atlas::array::DataType::real32();
+    const auto n            = single ? compact<float>(field) : compact<double>(field);
+    const atlas::idx_t nlev = field.rank() == 2 ? field.shape(1) : 1;
+
+    // rows of the exceeding points, written in place
+    auto& target = targetField->getSettableField();
+    auto rows    = atlas::array::make_view<double, 2>(target);
+    auto gather  = [&](auto make_view_t) {
+        using FIELD_TYPE_REAL = decltype(make_view_t);
+        if (field.rank() == 1) {
+            auto view = atlas::array::make_view<FIELD_TYPE_REAL, 1>(field);
+            for (std::size_t h = 0; h < n; ++h) {
+                rows(h, Value) = view(hits_[h]);
+            }
+            return;
+        }
+        auto view = atlas::array::make_view<FIELD_TYPE_REAL, 2>(field);
+        for (std::size_t h = 0; h < n; ++h) {
+            rows(h, Value) = view(hits_[h] / nlev, hits_[h] % nlev);
+        }
+    };
+    if (single) {
+        gather(float{});
+    }
+    else {
+        gather(double{});
+    }
+
+    for (std::size_t h = 0; h < n; ++h) {
+        rows(h, Index) = hits_[h] / nlev;
+        rows(h, Level) = hits_[h] % nlev;
+        rows(h, Lon)   = std::numeric_limits<double>::quiet_NaN();
+        rows(h, Lat)   = std::numeric_limits<double>::quiet_NaN();
+    }
+    if (lonlat_) {
+        auto lonlat = atlas::array::make_view<double, 2>(lonlat_);
+        for (std::size_t h = 0; h < n; ++h) {
+            rows(h, Lon) = lonlat(hits_[h] / nlev, 0);
+            rows(h, Lat) = lonlat(hits_[h] / nlev, 1);
+        }
+    }
+
+    // rows left from the previous update are reset, so that readers without metadata can stop at the first NaN index
+    for (std::size_t h = n; h < count_; ++h) {
+        for (atlas::idx_t c = 0; c < Columns; ++c) {
+            rows(h, c) = std::numeric_limits<double>::quiet_NaN();
+        }
+    }
+    count_ = n;
+    target.metadata().set("count", n);
+    if (!globalCount_) {
+        targetField->setUpdated(true);
+        return;
+    }
+
+    // counted with the other reductions of the step
+    auto& reductions = context_->reductions();
+    auto handle      = reductions.addSum({static_cast<double>(n)});
+    context_->defer([this, &reductions, handle]() {
+        auto targetField = target_.lock();
+        ASSERT(targetField);
+
+        auto total = static_cast<std::size_t>(reductions.result(handle).front());
+        targetField->getSettableField().metadata().set("global-count", total);
+        targetField->setUpdated(true);
+    });
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+// Stations
+// ---------------------------------------------------------------------------------------------------------------------
+StationValues::StationValues(std::string stations, AtlasFieldObservablePtr source, AtlasFieldObserverPtr target) :
+    context_(data::StrategyContext::current()), source_(source), target_(target) {
+
+    auto sourceField = source_.lock();
+    auto targetField = target_.lock();
+    ASSERT(sourceField && targetField);
+
+    const auto& field = sourceField->get();
+    if (field.rank() > 2) {
+        throw eckit::BadValue("Station values of field '" + field.name() + "' require a (npoints[, nlev]) field",
+                              Here());
+    }
+    extraction_ = data::StationExtraction::cached(*context_, field.functionspace(), stations);
+
+    auto shape = field.shape();
+    shape[0]   = static_cast<atlas::idx_t>(extraction_->size());
+
+    atlas::Field values(targetField->get().name(), atlas::array::DataType::real64(), shape);
+    std::memset(values.storage(), 0, values.bytes());
+    values.metadata() = targetField->get().metadata();
+    values.metadata().set("stations", stations);
+    if (field.rank() == 2) {
+        values.set_levels(values.shape(1));
+    }
+    targetField->set(values);
+}
+
+void StationValues::update() {
+    auto sourceField = source_.lock();
+    auto targetField = target_.lock();
+    ASSERT(sourceField && targetField);
+
+    // combined with the other reductions of the step
+    auto& reductions = context_->reductions();
+    auto handle      = reductions.addSum(extraction_->localValues({sourceField->get()}));
+
+    context_->defer([this, &reductions, handle]() {
+        auto targetField = target_.lock();
+        ASSERT(targetField);
+
+        const auto& values = reductions.result(handle);
+        auto& target       = targetField->getSettableField();
+        std::copy(values.begin(), values.end(), target.data<double>());
+
+        targetField->setUpdated(true);
+    });
+}
+
+namespace {
+
+// double precision field shaped like the source, replacing the target
+void replaceByDerivative(const atlas::Field& source, const AtlasFieldObserverPtr& target, const std::string& derivative) {
+    auto targetField = target.lock();
+    ASSERT(targetField);
+
+    atlas::Field values(targetField->get().name(), atlas::array::DataType::real64(), source.shape());
+    if (values.size() > 0) {
+        std::memset(values.storage(), 0, values.bytes());
+    }
+    values.metadata() = targetField->get().metadata();
+    values.metadata().set("derivative", derivative);
+    values.set_functionspace(source.functionspace());
+    if (source.rank() == 2) {
+        values.set_levels(values.shape(1));
+    }
+    targetField->set(values);
+}
+
+}  // namespace
+
+StencilDerivative::StencilDerivative(std::string derivative, AtlasFieldObservablePtr source,
+                                     AtlasFieldObserverPtr target) :
+    derivative_(std::move(derivative)), context_(data::StrategyContext::current()), source_(source), target_(target) {
+
+    auto sourceField = source_.lock();
+    ASSERT(sourceField);
+
+    if (derivative_ != "ddx" && derivative_ != "ddy" && derivative_ != "laplacian") {
+        throw eckit::BadValue("Invalid derivative '" + derivative_ + "' (expected ddx, ddy or laplacian)", Here());
+    }
+    const auto& field = sourceField->get();
+    if (field.rank() > 2) {
+        throw eckit::BadValue("Derivatives of field '" + field.name() + "' require a (npoints[, nlev]) field", Here());
+    }
+    derivatives_ = data::HorizontalDerivatives::cached(*context_, field.functionspace());
+    halo_        = derivatives_->haloCopies({field});
+    replaceByDerivative(field, target_, derivative_);
+}
+
+void StencilDerivative::update() {
+    auto sourceField = source_.lock();
+    ASSERT(sourceField);
+
+    // exchanged with the other halo copies of the step
+    derivatives_->copyOwned(sourceField->get(), halo_[0]);
+    context_->addHaloExchange(derivatives_, halo_);
+
+    context_->defer([this]() {
+        auto targetField = target_.lock();
+        ASSERT(targetField);
+
+        auto& target = targetField->getSettableField();
+        if (derivative_ == "ddx") {
+            derivatives_->ddx(halo_[0], target);
+        }
+        else if (derivative_ == "ddy") {
+            derivatives_->ddy(halo_[0], target);
+        }
+        else {
+            derivatives_->laplacian(halo_[0], target);
+        }
+
+        targetField->setUpdated(true);
+    });
+}
+
+WindDerivative::WindDerivative(std::string derivative, AtlasFieldObservablePtr v, AtlasFieldObservablePtr u,
+                               AtlasFieldObserverPtr target) :
+    derivative_(std::move(derivative)), context_(data::StrategyContext::current()), v_(v), u_(u), target_(target) {
+
+    auto uField = u_.lock();
+    auto vField = v_.lock();
+    ASSERT(uField && vField);
+
+    if (derivative_ != "vorticity" && derivative_ != "divergence") {
+        throw eckit::BadValue("Invalid wind derivative '" + derivative_ + "' (expected vorticity or divergence)",
+                              Here());
+    }
+    if (uField == vField) {
+        throw eckit::BadValue("Wind derivatives are derived from u, not v", Here());
+    }
+    const auto& field = uField->get();
+    if (field.rank() > 2 || field.shape() != vField->get().shape()) {
+        throw eckit::BadValue("Wind derivatives require (npoints[, nlev]) fields u and v of the same shape", Here());
+    }
+    derivatives_ = data::HorizontalDerivatives::cached(*context_, field.functionspace());
+    halo_        = derivatives_->haloCopies({field, vField->get()});
+    replaceByDerivative(field, target_, derivative_);
+}
+
+void WindDerivative::update() {
+    auto uField = u_.lock();
+    auto vField = v_.lock();
+    ASSERT(uField && vField);
+
+    // exchanged with the other halo copies of the step
+    derivatives_->copyOwned(uField->get(), halo_[0]);
+    derivatives_->copyOwned(vField->get(), halo_[1]);
+    context_->addHaloExchange(derivatives_, halo_);
+
+    context_->defer([this]() {
+        auto targetField = target_.lock();
+        ASSERT(targetField);
+
+        auto& target = targetField->getSettableField();
+        if (derivative_ == "vorticity") {
+            derivatives_->vorticity(halo_[0], halo_[1], target);
+        }
+        else {
+            derivatives_->divergence(halo_[0], halo_[1], target);
+        }
+
+        targetField->setUpdated(true);
+    });
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+// Field histories
+// ---------------------------------------------------------------------------------------------------------------------
+namespace {
+
+// parses "K[/float|/double]", false if malformed
+bool parseHistory(const std::string& history, std::size_t& depth, std::string& precision) {
+    auto slash        = history.find('/');
+    std::string count = history.substr(0, slash);
+    precision         = slash != std::string::npos ? history.substr(slash + 1) : "";
+    try {
+        std::size_t pos = 0;
+        long n          = std::stol(count, &pos);
+        if (pos != count.size() || n < 1) {
+            return false;
+        }
+        depth = static_cast<std::size_t>(n);
+    }
+    catch (const std::exception&) {
+        return false;
+    }
+    return slash == std::string::npos || precision == "float" || precision == "double";
+}
+
+// slot of a ring buffer, wrapping its memory to be written by the history strategy
+template <typename T>
+atlas::Field historySlot(atlas::Field& history, std::size_t slot) {
+    atlas::array::ArrayShape shape(history.shape().begin() + 1, history.shape().end());
+    const atlas::idx_t size = history.size() / history.shape(0);
+    atlas::Field snapshot(history.name(), history.data<T>() + slot * size, shape);
+    if (snapshot.rank() == 2) {
+        snapshot.set_levels(snapshot.shape(1));
+    }
+    return snapshot;
+}
+
+atlas::Field historySlot(atlas::Field& history, std::size_t slot) {
+    if (history.datatype() == atlas::array::DataType::real64()) {
+        return historySlot<double>(history, slot);
+    }
+    return historySlot<float>(history, slot);
+}
+
+// read-only view of a slot of a ring buffer, for the plugins
+template <typename T>
+data::ArrayView historySlotView(const atlas::Field& history, std::size_t slot) {
+    std::vector<long> shape(history.shape().begin() + 1, history.shape().end());
+    const atlas::idx_t size = history.size() / history.shape(0);
+    return data::ArrayView(history.data<T>() + slot * size, history.datatype().str(), shape);
+}
+
+}  // namespace
+
+FieldHistory::FieldHistory(std::string history, AtlasFieldObservablePtr source, AtlasFieldObserverPtr target) :
+    depth_(0), head_(0), count_(0), context_(data::StrategyContext::current()), source_(source), target_(target) {
+
+    std::string precision;
+    if (!parseHistory(history, depth_, precision)) {
+        throw eckit::BadValue("Invalid history '" + history + "' (expected K, K/float or K/double)", Here());
+    }
+
+    auto sourceField = source_.lock();
+    auto targetField = target_.lock();
+    ASSERT(sourceField && targetField);
+
+    const auto& field = sourceField->get();
+    if (field.datatype() != atlas::array::DataType::real32() && field.datatype() != atlas::array::DataType::real64()) {
+        throw eckit::BadValue("Unsupported field value type for history (expected float or double)", Here());
+    }
+    if (field.rank() > 2) {
+        throw eckit::BadValue("History of field '" + field.name() + "' requires a (npoints[, nlev]) field", Here());
+    }
+
+    atlas::array::ArrayShape shape{static_cast<atlas::idx_t>(depth_)};
+    shape.insert(shape.end(), field.shape().begin(), field.shape().end());
+
+    const auto& name = targetField->get().name();
+    atlas::Field ring;
+    ThreadAffinity::current().firstTouch([&]() {
+        ring = atlas::Field(name, representationType(precision, field), shape);
+        std::memset(ring.storage(), 0, ring.bytes());
+    });
+    ring.metadata() = targetField->get().metadata();
+    ring.metadata().set("history", depth_);
+    ring.metadata().set("history-head", head_);
+    ring.metadata().set("history-count", count_);
+    targetField->set(ring);
+}
+
+void FieldHistory::update() {
+    auto sourceField = source_.lock();
+    auto targetField = target_.lock();
+    ASSERT(sourceField && targetField);
+
+    const auto& source = sourceField->get();
+    auto& ring         = targetField->getSettableField();
+
+    // the oldest snapshot becomes the latest one
+    head_         = count_ > 0 ? (head_ + 1) % depth_ : 0;
+    count_        = std::min(count_ + 1, depth_);
+    auto snapshot = historySlot(ring, head_);
+
+    convertField(source, snapshot, false, context_->threadPool());
+    ring.metadata().set("history-head", head_);
+    ring.metadata().set("history-count", count_);
+
+    targetField->setUpdated(true);
+}
+
+data::ArrayView historySnapshot(const atlas::Field& history, std::size_t lag) {
+    if (!history.metadata().has("history")) {
+        throw eckit::BadValue("Field '" + history.name() + "' is not a history", Here());
+    }
+    const auto depth = history.metadata().get<std::size_t>("history");
+    const auto head  = history.metadata().get<std::size_t>("history-head");
+    const auto count = history.metadata().get<std::size_t>("history-count");
+    if (lag >= count) {
+        std::ostringstream msg;
+        msg << "History '" << history.name() << "' holds " << count << " of " << depth
+            << " snapshots, no snapshot at lag " << lag;
+        throw eckit::BadValue(msg.str(), Here());
+    }
+    const std::size_t slot = (head + depth - lag) % depth;
+    if (history.datatype() == atlas::array::DataType::real64()) {
+        return historySlotView<double>(history, slot);
+    }
+    return historySlotView<float>(history, slot);
+}
+
 // ---------------------------------------------------------------------------------------------------------------------
 
 }  // namespace field_provider
@@ -10,6 +10,7 @@
  */
 #pragma once
 #include <array>
+#include <cstdint>
 #include <functional>
 #include <memory>
 #include <string>
@@ -20,10 +21,13 @@
 #include <vector>
 
 #include "atlas/field/Field.h"
+#include "atlas/functionspace/FunctionSpace.h"
 
 #include "eckit/config/LocalConfiguration.h"
 #include "eckit/exception/Exceptions.h"
 
+#include "plume/data/ArrayView.h"
+
 namespace plume {
 
 namespace data {
@@ -34,6 +38,9 @@ class ParameterValue;
 class IParameterObservable;
 class IParameterObserver;
 class IParameterValue;
+class HorizontalDerivatives;
+class StationExtraction;
+class StrategyContext;
 }  // namespace data
 
 namespace field_provider {
@@ -100,6 +107,373 @@ public:
     void update() override;
 };
 
+/**
+ * @brief Parses a selection of model levels, e.g. "1-10", "90,100-137" or "1-137/4" (every 4th level).
+ *
+ * Levels are numbered from 1 (top of the atmosphere) as model levels, the returned levels are sorted and unique.
+ *
+ * @throws eckit::BadValue If the selection is empty or malformed.
+ */
+std::vector<std::size_t> parseLevels(const std::string& selection);
+
+/**
+ * @class LevelView
+ * @brief Update strategy exposing a subset of the levels of a 3D field without copying it.
+ *
+ * The target field wraps the memory of the source field, with strides selecting the requested levels. The selection
+ * must therefore be regularly spaced (e.g. "128-137" or "1-137/4"). Use `LevelCopy` for arbitrary selections.
+ *
+ * Like the source field, the view is only read by plugins (`ModelData::getArray` gives a read-only view of it), the
+ * model alone writes to its memory.
+ */
+class LevelView : public UpdateStrategy {
+private:
+    std::vector<std::size_t> levels_;
+
+    AtlasFieldObservablePtr source_;
+    AtlasFieldObserverPtr target_;
+
+public:
+    /// Replaces the target field (a clone of the source) by a strided view of the source.
+    LevelView(std::string levels, AtlasFieldObservablePtr source, AtlasFieldObserverPtr target);
+
+    /// Nothing to copy, (re)produces the source if lazy and marks the view as updated.
+    void update() override;
+};
+
+/**
+ * @class LevelCopy
+ * @brief Update strategy copying a subset of the levels of a 3D field into a compact (contiguous) field.
+ *
+ * The copy is shared by all plugins requesting the same selection.
+ */
+class LevelCopy : public UpdateStrategy {
+private:
+    std::vector<std::size_t> levels_;
+
+    AtlasFieldObservablePtr source_;
+    AtlasFieldObserverPtr target_;
+
+public:
+    /// Replaces the target field (a clone of the source) by a field holding the selected levels only.
+    LevelCopy(std::string levels, AtlasFieldObservablePtr source, AtlasFieldObserverPtr target);
+
+    /// Copies the selected levels of the source into the target, and marks the target as updated.
+    void update() override;
+};
+
+/**
+ * @class Area
+ * @brief A lat/lon box given as "N/W/S/E" in degrees (as in MARS requests), e.g. "60/-10/35/30".
+ *
+ * Longitudes are periodic, a box can cross the date line (e.g. "10/170/-10/-170").
+ */
+struct Area {
+    double north;
+    double west;
+    double south;
+    double east;
+
+    /// @throws eckit::BadValue If the area is malformed, or if north < south.
+    static Area parse(const std::string& area);
+
+    bool contains(double lon, double lat) const;
+};
+
+/// Flags of the first `npoints` points of a function space owned by this partition (all of them, unless the function
+/// space defines ghost points).
+std::vector<bool> ownedPoints(const atlas::FunctionSpace& functionspace, atlas::idx_t npoints);
+
+/**
+ * @brief Local (non-ghost) points of a function space that are inside an area, computed from its `lonlat` field.
+ *
+ * Index lists are computed once per function space and area in a context, and shared by all the fields (and plugins)
+ * using them. Plugins can use them to iterate over the region directly on full fields, in the context of their model
+ * data (see `ModelData::strategyContext`).
+ *
+ * @throws eckit::BadValue If the function space is not defined.
+ */
+std::shared_ptr<const std::vector<atlas::idx_t>> regionIndices(data::StrategyContext& context,
+                                                               const atlas::FunctionSpace& functionspace,
+                                                               const std::string& area);
+
+/**
+ * @class AreaSubset
+ * @brief Update strategy gathering the points of a field inside an area into a compact field.
+ *
+ * The target field has the shape of the source field, with the points dimension reduced to the points in the area
+ * (possibly none on some partitions). It has no function space, point `i` is point `regionIndices(...)[i]` of the
+ * source field.
+ */
+class AreaSubset : public UpdateStrategy {
+private:
+    std::shared_ptr<const std::vector<atlas::idx_t>> indices_;
+
+    AtlasFieldObservablePtr source_;
+    AtlasFieldObserverPtr target_;
+
+public:
+    /// Replaces the target field (a clone of the source) by a field holding the points in the area only.
+    AreaSubset(std::string area, AtlasFieldObservablePtr source, AtlasFieldObserverPtr target);
+
+    /// Gathers the points in the area from the source into the target, and marks the target as updated.
+    void update() override;
+};
+
+/**
+ * @class Representation
+ * @brief Update strategy converting a field to another precision and/or layout.
+ *
+ * - precision : "float" or "double" (empty keeps the precision of the source)
+ * - layout    : "point-major" (as provided by the model, the default) or "level-major", i.e. a (nlev, npoints) field
+ *               with contiguous levels (it has no function space)
+ *
+ * The converted field is shared by all the plugins requesting the same representation, and refreshed once on update,
+ * by blocks of points shared on the thread pool of the session (see data::StrategyContext).
+ */
+class Representation : public UpdateStrategy {
+private:
+    bool levelMajor_;
+    std::shared_ptr<data::StrategyContext> context_;
+
+    AtlasFieldObservablePtr source_;
+    AtlasFieldObserverPtr target_;
+
+public:
+    /// Replaces the target field (a clone of the source) by a field of the requested precision and layout.
+    Representation(std::string precision, std::string layout, AtlasFieldObservablePtr source,
+                   AtlasFieldObserverPtr target);
+
+    /// Converts the source into the target, and marks the target as updated.
+    void update() override;
+};
+
+/// Representation of a field in another precision only
+class PrecisionRepresentation : public Representation {
+public:
+    PrecisionRepresentation(std::string precision, AtlasFieldObservablePtr source, AtlasFieldObserverPtr target) :
+        Representation(std::move(precision), "", source, target) {}
+};
+
+/// Representation of a field in another layout only
+class LayoutRepresentation : public Representation {
+public:
+    LayoutRepresentation(std::string layout, AtlasFieldObservablePtr source, AtlasFieldObserverPtr target) :
+        Representation("", std::move(layout), source, target) {}
+};
+
+/**
+ * @class GlobalStatistic
+ * @brief Update strategy computing a global statistic of a distributed field, per level (see data::Reductions).
+ *
+ * - statistic : "sum", "mean", "min" or "max" (a (nlev) field), or "zonal-mean" (a (nrows, nlev) field, for fields on
+ *               StructuredColumns)
+ *
+ * The values are the same on all partitions. The update is collective, the source must be updated on all partitions:
+ * the statistics of all the fields updated in a step are computed together, in the reductions of the step (see
+ * data::StrategyContext).
+ */
+class GlobalStatistic : public UpdateStrategy {
+private:
+    std::string statistic_;
+    std::shared_ptr<data::StrategyContext> context_;
+
+    AtlasFieldObservablePtr source_;
+    AtlasFieldObserverPtr target_;
+
+public:
+    /// Replaces the target field (a clone of the source) by a field holding the statistic.
+    GlobalStatistic(std::string statistic, AtlasFieldObservablePtr source, AtlasFieldObserverPtr target);
+
+    /// Computes the statistic of the source into the target, and marks the target as updated.
+    void update() override;
+};
+
+/**
+ * @class ThresholdExceedance
+ * @brief Update strategy extracting the points of a field exceeding a threshold, as a sparse (npoints, 5) field.
+ *
+ * - threshold : "[>|<]value[/steps]", e.g. ">30" (the default comparison), "<-10", or ">30/3" for points exceeding
+ *               the threshold at 3 consecutive updates
+ * - count     : "local" (the default) or "global", to also count the points of all partitions (collective update,
+ *               in the reductions of the step, see data::StrategyContext)
+ *
+ * The target is a (npoints * nlev, 5) field, allocated once. Its first `count` rows (in its metadata, with the
+ * `global-count` of points) hold the point index, level, value, longitude and latitude (NaN without function space)
+ * of the owned points exceeding the threshold at the last update, the other rows are NaN.
+ */
+class ThresholdExceedance : public UpdateStrategy {
+public:
+    enum Column
+    {
+        Index = 0,
+        Level,
+        Value,
+        Lon,
+        Lat,
+        Columns
+    };
+
+private:
+    bool above_;
+    double threshold_;
+    std::size_t steps_;
+    bool globalCount_;
+    std::shared_ptr<data::StrategyContext> context_;
+
+    // owned points, lon/lat and consecutive exceedances (point-major) of the source
+    std::vector<bool> owned_;
+    atlas::Field lonlat_;
+    std::vector<std::uint16_t> runs_;
+
+    // flat indices of the exceeding points (reused), and their number at the last update
+    std::vector<atlas::idx_t> hits_;
+    std::size_t count_ = 0;
+
+    AtlasFieldObservablePtr source_;
+    AtlasFieldObserverPtr target_;
+
+    template <typename T>
+    std::size_t compact(const atlas::Field& field);
+
+public:
+    ThresholdExceedance(std::string threshold, std::string count, AtlasFieldObservablePtr source,
+                        AtlasFieldObserverPtr target);
+
+    /// Writes the points currently exceeding the threshold to the first rows of the target, and marks it as updated.
+    void update() override;
+};
+
+/// Threshold exceedance, counting the points of this partition only
+class LocalThresholdExceedance : public ThresholdExceedance {
+public:
+    LocalThresholdExceedance(std::string threshold, AtlasFieldObservablePtr source, AtlasFieldObserverPtr target) :
+        ThresholdExceedance(std::move(threshold), "local", source, target) {}
+};
+
+/**
+ * @class StationValues
+ * @brief Update strategy extracting the values of a field at a list of stations (see data::StationExtraction).
+ *
+ * - stations : "lon/lat,lon/lat,..." in degrees, the values at the nearest points are gathered into a
+ *              (nstations[, nlev]) field, the same on all partitions
+ *
+ * The construction and the update are collective, the source must be updated on all partitions: the values of all the
+ * stations extracted in a step are combined together, in the reductions of the step (see data::StrategyContext).
+ */
+class StationValues : public UpdateStrategy {
+private:
+    std::shared_ptr<data::StrategyContext> context_;
+    std::shared_ptr<const data::StationExtraction> extraction_;
+
+    AtlasFieldObservablePtr source_;
+    AtlasFieldObserverPtr target_;
+
+public:
+    /// Replaces the target field (a clone of the source) by a field holding the values at the stations.
+    StationValues(std::string stations, AtlasFieldObservablePtr source, AtlasFieldObserverPtr target);
+
+    /// Extracts the values of the source at the stations into the target, and marks the target as updated.
+    void update() override;
+};
+
+/**
+ * @class StencilDerivative
+ * @brief Update strategy computing a horizontal derivative of a field on StructuredColumns (see
+ * data::HorizontalDerivatives).
+ *
+ * - derivative : "ddx" (eastward), "ddy" (northward) or "laplacian", into a double precision field shaped like the
+ *                source, in units of the source per meter (squared for the laplacian)
+ *
+ * The update is collective (halo exchange), the source must be updated on all partitions: the halo copy of the source,
+ * allocated once, is exchanged with those of all the derivatives of the step (see data::StrategyContext).
+ */
+class StencilDerivative : public UpdateStrategy {
+private:
+    std::string derivative_;
+    std::shared_ptr<data::StrategyContext> context_;
+    std::shared_ptr<const data::HorizontalDerivatives> derivatives_;
+    std::vector<atlas::Field> halo_;
+
+    AtlasFieldObservablePtr source_;
+    AtlasFieldObserverPtr target_;
+
+public:
+    /// Replaces the target field (a clone of the source) by a double precision field holding the derivative.
+    StencilDerivative(std::string derivative, AtlasFieldObservablePtr source, AtlasFieldObserverPtr target);
+
+    /// Computes the derivative of the source into the target, and marks the target as updated.
+    void update() override;
+};
+
+/**
+ * @class WindDerivative
+ * @brief Update strategy computing the relative vorticity or the divergence of the wind (u, v) on StructuredColumns.
+ *
+ * - wind-derivative : "vorticity" or "divergence" (1/s), into a double precision field shaped like u
+ *
+ * The source is u. The halo copies of both components, allocated once, are exchanged with those of all the derivatives
+ * of the step, so the update is collective (see data::StrategyContext).
+ */
+class WindDerivative : public UpdateStrategy {
+private:
+    std::string derivative_;
+    std::shared_ptr<data::StrategyContext> context_;
+    std::shared_ptr<const data::HorizontalDerivatives> derivatives_;
+    std::vector<atlas::Field> halo_;
+
+    AtlasFieldObservablePtr v_;
+    AtlasFieldObservablePtr u_;
+    AtlasFieldObserverPtr target_;
+
+public:
+    /// Replaces the target field (a clone of u) by a double precision field holding the derivative.
+    WindDerivative(std::string derivative, AtlasFieldObservablePtr v, AtlasFieldObservablePtr u,
+                   AtlasFieldObserverPtr target);
+
+    /// Computes the derivative of the wind into the target, and marks the target as updated.
+    void update() override;
+};
+
+/**
+ * @class FieldHistory
+ * @brief Update strategy keeping the last K snapshots of a field in a ring buffer, shared by all requesting plugins.
+ *
+ * - history : "K", or "K/float" ("K/double") for snapshots stored in single (double) precision, e.g. "3/float"
+ *
+ * The target is a (K, npoints[, nlev]) field. Each update overwrites the oldest snapshot and moves the head to it,
+ * nothing is shifted. The metadata of the target holds the slot of the latest snapshot (`history-head`) and the number
+ * of snapshots taken so far (`history-count`, at most K). See `historySnapshot` to read the snapshot at a given lag.
+ * Snapshots are copied like representations, on the thread pool of the session.
+ */
+class FieldHistory : public UpdateStrategy {
+private:
+    std::size_t depth_;
+    std::size_t head_;
+    std::size_t count_;
+    std::shared_ptr<data::StrategyContext> context_;
+
+    AtlasFieldObservablePtr source_;
+    AtlasFieldObserverPtr target_;
+
+public:
+    /// Replaces the target field (a clone of the source) by the (empty) ring buffer of snapshots.
+    FieldHistory(std::string history, AtlasFieldObservablePtr source, AtlasFieldObserverPtr target);
+
+    /// Copies the source over the oldest snapshot, and marks the target as updated.
+    void update() override;
+};
+
+/**
+ * @brief Snapshot of a field `lag` updates ago (0 is the latest), from the ring buffer of a FieldHistory.
+ *
+ * The snapshot is a read-only view of the ring buffer (no copy), with the shape of the source field. Only the history
+ * strategy writes to the buffer, the snapshot is overwritten K updates later.
+ *
+ * @throws eckit::BadValue If the field is not a history, or if it holds no snapshot at that lag (yet).
+ */
+data::ArrayView historySnapshot(const atlas::Field& history, std::size_t lag);
+
 // ---------------------------------------------------------------------------------------------------------------------
 // Strategy type traits
 // ---------------------------------------------------------------------------------------------------------------------
@@ -112,7 +486,8 @@ public:
  * Each specialisation should at least have the following information:
  * - `name` gives the string identifier of the strategy.
  * - `levtype` Only used for naming purposes to give users an idea of the strategy. Might not always be relevant.
- * - `levelKey` The config key where the level can be found.
+ * - `levelKey` The config key where the level can be found (several keys joined by '+' give a level joining their
+ *   values with '+').
  * - `configArgs` is an array of keys to retrieve from an eckit configuration.
  * - `paramArgs` is an array of param names to retrieve from the model data, except for the observable and observer.
  * - `requiredParams` is an array of valid combinations of required params that can be used by the negotiator.
@@ -126,7 +501,9 @@ public:
  */
 template <typename T>
 struct UpdateStrategyTraits {
-    static constexpr std::array<const char*, 1> allConfigArgs{"height"};
+    static constexpr std::array<const char*, 13> allConfigArgs{
+        "height",    "levels",    "levels-copy", "area",       "precision",       "layout",  "statistic",
+        "threshold", "count",     "stations",    "derivative", "wind-derivative", "history"};
 };
 
 template <>
@@ -140,12 +517,168 @@ struct UpdateStrategyTraits<WindAtHeight> {
     using Args = std::tuple<std::size_t, AtlasFieldObservablePtr, AtlasFieldObservablePtr, AtlasFieldObserverPtr>;
 };
 
+/// Any 3D field can be viewed, e.g. `levels: "128-137"` derives 'u;ml;128-137' from 'u'.
+template <>
+struct UpdateStrategyTraits<LevelView> {
+    static constexpr const char* name     = "level_view";
+    static constexpr const char* levtype  = "ml";
+    static constexpr const char* levelKey = "levels";
+    static constexpr std::array<const char*, 1> configArgs{"levels"};
+    static constexpr std::array<const char*, 0> paramArgs{};
+    static constexpr std::array<std::array<const char*, 0>, 0> requiredParams{};
+    using Args = std::tuple<std::string, AtlasFieldObservablePtr, AtlasFieldObserverPtr>;
+};
+
+/// Any 3D field can be subset, e.g. `levels-copy: "128-137"` derives 'u;mlc;128-137' from 'u'.
+template <>
+struct UpdateStrategyTraits<LevelCopy> {
+    static constexpr const char* name     = "level_copy";
+    static constexpr const char* levtype  = "mlc";
+    static constexpr const char* levelKey = "levels-copy";
+    static constexpr std::array<const char*, 1> configArgs{"levels-copy"};
+    static constexpr std::array<const char*, 0> paramArgs{};
+    static constexpr std::array<std::array<const char*, 0>, 0> requiredParams{};
+    using Args = std::tuple<std::string, AtlasFieldObservablePtr, AtlasFieldObserverPtr>;
+};
+
+/// Any field defined on a function space can be subset, e.g. `area: "60/-10/35/30"` derives 'u;area;60/-10/35/30'.
+template <>
+struct UpdateStrategyTraits<AreaSubset> {
+    static constexpr const char* name     = "area_subset";
+    static constexpr const char* levtype  = "area";
+    static constexpr const char* levelKey = "area";
+    static constexpr std::array<const char*, 1> configArgs{"area"};
+    static constexpr std::array<const char*, 0> paramArgs{};
+    static constexpr std::array<std::array<const char*, 0>, 0> requiredParams{};
+    using Args = std::tuple<std::string, AtlasFieldObservablePtr, AtlasFieldObserverPtr>;
+};
+
+/// Both precision and layout, e.g. `precision: float` and `layout: level-major` derive 'u;rep;float+level-major'.
+template <>
+struct UpdateStrategyTraits<Representation> {
+    static constexpr const char* name     = "representation";
+    static constexpr const char* levtype  = "rep";
+    static constexpr const char* levelKey = "precision+layout";
+    static constexpr std::array<const char*, 2> configArgs{"precision", "layout"};
+    static constexpr std::array<const char*, 0> paramArgs{};
+    static constexpr std::array<std::array<const char*, 0>, 0> requiredParams{};
+    using Args = std::tuple<std::string, std::string, AtlasFieldObservablePtr, AtlasFieldObserverPtr>;
+};
+
+/// e.g. `precision: float` derives 'u;rep;float'
+template <>
+struct UpdateStrategyTraits<PrecisionRepresentation> {
+    static constexpr const char* name     = "precision_representation";
+    static constexpr const char* levtype  = "rep";
+    static constexpr const char* levelKey = "precision";
+    static constexpr std::array<const char*, 1> configArgs{"precision"};
+    static constexpr std::array<const char*, 0> paramArgs{};
+    static constexpr std::array<std::array<const char*, 0>, 0> requiredParams{};
+    using Args = std::tuple<std::string, AtlasFieldObservablePtr, AtlasFieldObserverPtr>;
+};
+
+/// e.g. `layout: level-major` derives 'u;rep;level-major'
+template <>
+struct UpdateStrategyTraits<LayoutRepresentation> {
+    static constexpr const char* name     = "layout_representation";
+    static constexpr const char* levtype  = "rep";
+    static constexpr const char* levelKey = "layout";
+    static constexpr std::array<const char*, 1> configArgs{"layout"};
+    static constexpr std::array<const char*, 0> paramArgs{};
+    static constexpr std::array<std::array<const char*, 0>, 0> requiredParams{};
+    using Args = std::tuple<std::string, AtlasFieldObservablePtr, AtlasFieldObserverPtr>;
+};
+
+/// e.g. `statistic: mean` derives 'u;stat;mean'
+template <>
+struct UpdateStrategyTraits<GlobalStatistic> {
+    static constexpr const char* name     = "global_statistic";
+    static constexpr const char* levtype  = "stat";
+    static constexpr const char* levelKey = "statistic";
+    static constexpr std::array<const char*, 1> configArgs{"statistic"};
+    static constexpr std::array<const char*, 0> paramArgs{};
+    static constexpr std::array<std::array<const char*, 0>, 0> requiredParams{};
+    using Args = std::tuple<std::string, AtlasFieldObservablePtr, AtlasFieldObserverPtr>;
+};
+
+/// e.g. `threshold: ">30/3"` and `count: global` derive 'u;exc;>30/3+global'
+template <>
+struct UpdateStrategyTraits<ThresholdExceedance> {
+    static constexpr const char* name     = "threshold_exceedance";
+    static constexpr const char* levtype  = "exc";
+    static constexpr const char* levelKey = "threshold+count";
+    static constexpr std::array<const char*, 2> configArgs{"threshold", "count"};
+    static constexpr std::array<const char*, 0> paramArgs{};
+    static constexpr std::array<std::array<const char*, 0>, 0> requiredParams{};
+    using Args = std::tuple<std::string, std::string, AtlasFieldObservablePtr, AtlasFieldObserverPtr>;
+};
+
+/// e.g. `threshold: ">30"` derives 'u;exc;>30'
+template <>
+struct UpdateStrategyTraits<LocalThresholdExceedance> {
+    static constexpr const char* name     = "local_threshold_exceedance";
+    static constexpr const char* levtype  = "exc";
+    static constexpr const char* levelKey = "threshold";
+    static constexpr std::array<const char*, 1> configArgs{"threshold"};
+    static constexpr std::array<const char*, 0> paramArgs{};
+    static constexpr std::array<std::array<const char*, 0>, 0> requiredParams{};
+    using Args = std::tuple<std::string, AtlasFieldObservablePtr, AtlasFieldObserverPtr>;
+};
+
+/// e.g. `stations: "-0.12/51.5,2.35/48.86"` derives 'u;pt;-0.12/51.5,2.35/48.86'
+template <>
+struct UpdateStrategyTraits<StationValues> {
+    static constexpr const char* name     = "station_values";
+    static constexpr const char* levtype  = "pt";
+    static constexpr const char* levelKey = "stations";
+    static constexpr std::array<const char*, 1> configArgs{"stations"};
+    static constexpr std::array<const char*, 0> paramArgs{};
+    static constexpr std::array<std::array<const char*, 0>, 0> requiredParams{};
+    using Args = std::tuple<std::string, AtlasFieldObservablePtr, AtlasFieldObserverPtr>;
+};
+
+/// The wind derivatives of u, e.g. `wind-derivative: "vorticity"` derives 'u;der;vorticity' from 'u' and 'v'.
+template <>
+struct UpdateStrategyTraits<WindDerivative> {
+    static constexpr const char* name     = "wind_derivative";
+    static constexpr const char* levtype  = "der";
+    static constexpr const char* levelKey = "wind-derivative";
+    static constexpr std::array<const char*, 1> configArgs{"wind-derivative"};
+    static constexpr std::array<const char*, 1> paramArgs{"v"};
+    static constexpr std::array<std::array<const char*, 2>, 1> requiredParams{{{"u", "v"}}};
+    using Args = std::tuple<std::string, AtlasFieldObservablePtr, AtlasFieldObservablePtr, AtlasFieldObserverPtr>;
+};
+
+/// Any field on StructuredColumns can be derived, e.g. `derivative: "laplacian"` derives 't;der;laplacian' from 't'.
+template <>
+struct UpdateStrategyTraits<StencilDerivative> {
+    static constexpr const char* name     = "stencil_derivative";
+    static constexpr const char* levtype  = "der";
+    static constexpr const char* levelKey = "derivative";
+    static constexpr std::array<const char*, 1> configArgs{"derivative"};
+    static constexpr std::array<const char*, 0> paramArgs{};
+    static constexpr std::array<std::array<const char*, 0>, 0> requiredParams{};
+    using Args = std::tuple<std::string, AtlasFieldObservablePtr, AtlasFieldObserverPtr>;
+};
+
+/// Any field can keep a history, e.g. `history: "3/float"` derives 'u;hist;3/float' from 'u'.
+template <>
+struct UpdateStrategyTraits<FieldHistory> {
+    static constexpr const char* name     = "field_history";
+    static constexpr const char* levtype  = "hist";
+    static constexpr const char* levelKey = "history";
+    static constexpr std::array<const char*, 1> configArgs{"history"};
+    static constexpr std::array<const char*, 0> paramArgs{};
+    static constexpr std::array<std::array<const char*, 0>, 0> requiredParams{};
+    using Args = std::tuple<std::string, AtlasFieldObservablePtr, AtlasFieldObserverPtr>;
+};
+
 // ---------------------------------------------------------------------------------------------------------------------
 // Strategy registry
 // ---------------------------------------------------------------------------------------------------------------------
 // Add types as needed
-using StrategyArgs =
-    std::variant<std::size_t, AtlasFieldObservablePtr, AtlasFieldObserverPtr, IntObservablePtr, IntObserverPtr>;
+using StrategyArgs = std::variant<std::size_t, std::string, AtlasFieldObservablePtr, AtlasFieldObserverPtr,
+                                  IntObservablePtr, IntObserverPtr>;
 using StrategyArgList = std::vector<StrategyArgs>;
 
 /**
@@ -318,7 +851,15 @@ struct AutoRegister {
 // ---------------------------------------------------------------------------------------------------------------------
 // Negotiation utilities for options to strategy name mapping
 // ---------------------------------------------------------------------------------------------------------------------
-using AllUpdateStrategyTraits = std::tuple<UpdateStrategyTraits<WindAtHeight>>;
+// (strategies with more options first, they would otherwise be shadowed)
+using AllUpdateStrategyTraits =
+    std::tuple<UpdateStrategyTraits<WindAtHeight>, UpdateStrategyTraits<LevelView>, UpdateStrategyTraits<LevelCopy>,
+               UpdateStrategyTraits<AreaSubset>, UpdateStrategyTraits<Representation>,
+               UpdateStrategyTraits<PrecisionRepresentation>, UpdateStrategyTraits<LayoutRepresentation>,
+               UpdateStrategyTraits<GlobalStatistic>, UpdateStrategyTraits<ThresholdExceedance>,
+               UpdateStrategyTraits<LocalThresholdExceedance>, UpdateStrategyTraits<StationValues>,
+               UpdateStrategyTraits<WindDerivative>, UpdateStrategyTraits<StencilDerivative>,
+               UpdateStrategyTraits<FieldHistory>>;
 
 /**
  * @brief Checks if a strategy trait matches a given config of options and source parameter.
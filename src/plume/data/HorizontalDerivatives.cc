@@ -0,0 +1,319 @@
+/*
+ * (C) Copyright 2025- ECMWF.
+ *
+ * This software is licensed under the terms of the Apache Licence Version 2.0
+ * which can be obtained at http://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * In applying this licence, ECMWF does not waive the privileges and immunities
+ * granted to it by virtue of its status as an intergovernmental organisation nor
+ * does it submit to any jurisdiction.
+ */
+#include <algorithm>
+#include <cmath>
+#include <string>
+#include <tuple>
+
+#include "eckit/exception/Exceptions.h"
+
+#include "atlas/array.h"
+#include "atlas/field/FieldSet.h"
+#include "atlas/grid.h"
+#include "atlas/util/Earth.h"
+
+#include "plume/Metrics.h"
+#include "plume/data/HorizontalDerivatives.h"
+#include "plume/data/StrategyContext.h"
+
+
+namespace plume {
+namespace data {
+
+namespace {
+
+constexpr double degrees = M_PI / 180.;
+
+// below this cos(lat), a point is a pole
+constexpr double poleCos = 1e-10;
+
+// value of a neighbour interpolated in longitude
+template <typename View>
+double between(const View& f, atlas::idx_t i0, atlas::idx_t i1, double w, atlas::idx_t k) {
+    return f(i0, k) + w * (f(i1, k) - f(i0, k));
+}
+
+template <typename View, typename Stencil>
+double dx(const View& f, const Stencil& s, atlas::idx_t k) {
+    return s.ddx * (f(s.east, k) - f(s.west, k));
+}
+
+template <typename View, typename Stencil>
+double dy(const View& f, const Stencil& s, atlas::idx_t k) {
+    return s.ddyNorth * between(f, s.north0, s.north1, s.northWeight, k) + s.ddyCentre * f(s.point, k) +
+           s.ddySouth * between(f, s.south0, s.south1, s.southWeight, k);
+}
+
+template <typename View, typename Stencil>
+double dx2(const View& f, const Stencil& s, atlas::idx_t k) {
+    return 4. * s.ddx * s.ddx * (f(s.east, k) - 2. * f(s.point, k) + f(s.west, k));
+}
+
+template <typename View, typename Stencil>
+double dy2(const View& f, const Stencil& s, atlas::idx_t k) {
+    return s.d2dy2North * between(f, s.north0, s.north1, s.northWeight, k) + s.d2dy2Centre * f(s.point, k) +
+           s.d2dy2South * between(f, s.south0, s.south1, s.southWeight, k);
+}
+
+}  // namespace
+
+
+HorizontalDerivatives::HorizontalDerivatives(const atlas::FunctionSpace& functionspace) : fs_(functionspace) {
+    if (!functionspace || !fs_.valid()) {
+        throw eckit::BadValue("Horizontal derivatives require a StructuredColumns function space", Here());
+    }
+
+    // halo copies share the distribution of the function space
+    if (fs_.halo() >= 1) {
+        halo_ = fs_;
+    }
+    else {
+        halo_     = atlas::functionspace::StructuredColumns(fs_.grid(), atlas::option::halo(1));
+        bool same = halo_.sizeOwned() == fs_.sizeOwned() && halo_.j_begin() == fs_.j_begin() &&
+                    halo_.j_end() == fs_.j_end();
+        for (atlas::idx_t j = fs_.j_begin(); same && j < fs_.j_end(); ++j) {
+            same = halo_.i_begin(j) == fs_.i_begin(j) && halo_.i_end(j) == fs_.i_end(j);
+        }
+        if (!same) {
+            throw eckit::BadValue(
+                "Horizontal derivatives require a function space with a halo, or with the default distribution",
+                Here());
+        }
+    }
+
+    const auto& grid      = fs_.grid();
+    const double radius   = atlas::util::Earth::radius();
+    const atlas::idx_t ny = grid.ny();
+
+    // neighbour of (i, j) on the row jr, between two points of the halo copies
+    auto neighbour = [&](atlas::idx_t i, atlas::idx_t j, atlas::idx_t jr, atlas::idx_t& i0, atlas::idx_t& i1,
+                         double& w) {
+        double x = (grid.x(i, j) - grid.x(0, jr)) * grid.nx(jr) / 360.;
+        if (std::abs(x - std::round(x)) < 1e-9) {
+            x = std::round(x);  // aligned columns
+        }
+        const auto first  = static_cast<atlas::idx_t>(std::floor(x));
+        w                 = x - first;
+        const auto second = w > 0. ? first + 1 : first;
+        i0 = halo_.index(std::clamp(first, halo_.i_begin_halo(jr), halo_.i_end_halo(jr) - 1), jr);
+        i1 = halo_.index(std::clamp(second, halo_.i_begin_halo(jr), halo_.i_end_halo(jr) - 1), jr);
+    };
+
+    stencils_.reserve(fs_.sizeOwned());
+    for (atlas::idx_t j = fs_.j_begin(); j < fs_.j_end(); ++j) {
+        const double lat    = grid.y(j) * degrees;
+        const double cosLat = std::cos(lat);
+        const bool pole     = cosLat < poleCos;
+        const double north  = j > 0 ? radius * (grid.y(j - 1) - grid.y(j)) * degrees : 0.;
+        const double south  = j < ny - 1 ? radius * (grid.y(j) - grid.y(j + 1)) * degrees : 0.;
+
+        Stencil row{};
+        row.ddx      = pole ? 0. : grid.nx(j) / (4. * M_PI * radius * cosLat);
+        row.tanOverR = pole ? 0. : std::tan(lat) / radius;
+        if (north > 0. && south > 0.) {
+            row.ddyNorth    = south / (north * (north + south));
+            row.ddyCentre   = (north - south) / (north * south);
+            row.ddySouth    = -north / (south * (north + south));
+            row.d2dy2North  = 2. / (north * (north + south));
+            row.d2dy2Centre = -2. / (north * south);
+            row.d2dy2South  = 2. / (south * (north + south));
+        }
+        else if (south > 0.) {
+            row.ddyCentre = 1. / south;
+            row.ddySouth  = -1. / south;
+        }
+        else if (north > 0.) {
+            row.ddyNorth  = 1. / north;
+            row.ddyCentre = -1. / north;
+        }
+
+        for (atlas::idx_t i = fs_.i_begin(j); i < fs_.i_end(j); ++i) {
+            Stencil s = row;
+            s.source  = fs_.index(i, j);
+            s.point   = halo_.index(i, j);
+            s.east    = halo_.index(i + 1, j);
+            s.west    = halo_.index(i - 1, j);
+            s.north0 = s.north1 = s.south0 = s.south1 = s.point;
+            if (north > 0.) {
+                neighbour(i, j, j - 1, s.north0, s.north1, s.northWeight);
+            }
+            if (south > 0.) {
+                neighbour(i, j, j + 1, s.south0, s.south1, s.southWeight);
+            }
+            stencils_.push_back(s);
+        }
+    }
+}
+
+
+std::shared_ptr<const HorizontalDerivatives> HorizontalDerivatives::cached(StrategyContext& context,
+                                                                         const atlas::FunctionSpace& functionspace) {
+    if (!functionspace) {
+        throw eckit::BadValue("Horizontal derivatives require a StructuredColumns function space", Here());
+    }
+
+    return context.cached<HorizontalDerivatives>(
+        functionspace, "", [&]() { return std::make_shared<const HorizontalDerivatives>(functionspace); });
+}
+
+
+std::vector<atlas::Field> HorizontalDerivatives::exchange(const std::vector<atlas::Field>& fields) const {
+    auto copies = haloCopies(fields);
+    atlas::FieldSet exchanged;
+    for (std::size_t f = 0; f < fields.size(); ++f) {
+        copyOwned(fields[f], copies[f]);
+        exchanged.add(copies[f]);
+    }
+    exchange(exchanged);
+    return copies;
+}
+
+
+std::vector<atlas::Field> HorizontalDerivatives::haloCopies(const std::vector<atlas::Field>& fields) const {
+    std::vector<atlas::Field> copies;
+    copies.reserve(fields.size());
+    for (const auto& field : fields) {
+        if (field.rank() < 1 || field.rank() > 2 || field.shape(0) != fs_.size()) {
+            throw eckit::BadValue("Horizontal derivatives of field '" + field.name() +
+                                      "' require a (npoints[, nlev]) field on the function space of the derivatives",
+                                  Here());
+        }
+        const atlas::idx_t nlev = field.rank() == 2 ? field.shape(1) : 1;
+        copies.push_back(halo_.createField<double>(atlas::option::name(field.name()) | atlas::option::levels(nlev)));
+    }
+    return copies;
+}
+
+
+void HorizontalDerivatives::copyOwned(const atlas::Field& field, atlas::Field& copy) const {
+    const atlas::idx_t nlev = field.rank() == 2 ? field.shape(1) : 1;
+    if (field.rank() < 1 || field.rank() > 2 || field.shape(0) != fs_.size() || copy.shape(0) != halo_.size() ||
+        copy.rank() != 2 || copy.shape(1) != nlev) {
+        throw eckit::BadValue("Halo copy '" + copy.name() + "' does not match field '" + field.name() + "'", Here());
+    }
+    if (field.datatype() == atlas::array::DataType::real64()) {
+        copyPoints<double>(field, copy);
+    }
+    else if (field.datatype() == atlas::array::DataType::real32()) {
+        copyPoints<float>(field, copy);
+    }
+    else {
+        throw eckit::BadValue("Unsupported value type of field '" + field.name() + "' (expected float or double)",
+                              Here());
+    }
+    Metrics::instance().addBytesCopied(stencils_.size() * nlev * sizeof(double));
+}
+
+
+void HorizontalDerivatives::exchange(const atlas::FieldSet& copies) const {
+    // one exchange for all the fields
+    halo_.haloExchange(copies);
+}
+
+
+template <typename T>
+void HorizontalDerivatives::copyPoints(const atlas::Field& field, atlas::Field& copy) const {
+    auto to = atlas::array::make_view<double, 2>(copy);
+    if (field.rank() == 1) {
+        auto from = atlas::array::make_view<T, 1>(field);
+        for (const auto& s : stencils_) {
+            to(s.point, 0) = from(s.source);
+        }
+    }
+    else {
+        auto from               = atlas::array::make_view<T, 2>(field);
+        const atlas::idx_t nlev = from.shape(1);
+        for (const auto& s : stencils_) {
+            for (atlas::idx_t k = 0; k < nlev; ++k) {
+                to(s.point, k) = from(s.source, k);
+            }
+        }
+    }
+}
+
+
+template <typename... Fields>
+auto HorizontalDerivatives::views(const atlas::Field& out, const Fields&... fields) const {
+    if (out.datatype() != atlas::array::DataType::real64() || out.rank() < 1 || out.rank() > 2 ||
+        out.shape(0) != fs_.size()) {
+        throw eckit::BadValue("Horizontal derivative into field '" + out.name() +
+                                  "' requires a double precision (npoints[, nlev]) field on the function space",
+                              Here());
+    }
+    const atlas::idx_t nlev = out.rank() == 2 ? out.shape(1) : 1;
+
+    auto view = [&](const atlas::Field& f) {
+        if (f.datatype() != atlas::array::DataType::real64() || f.rank() != 2 || f.shape(0) != halo_.size() ||
+            f.shape(1) != nlev) {
+            throw eckit::BadValue("Horizontal derivative of field '" + f.name() +
+                                      "' requires a halo copy from HorizontalDerivatives::exchange, with the levels "
+                                      "of field '" + out.name() + "'",
+                                  Here());
+        }
+        return atlas::array::make_view<double, 2>(f);
+    };
+    return std::make_tuple(view(fields)...);
+}
+
+
+template <typename Fn>
+void HorizontalDerivatives::forEach(atlas::Field& out, Fn&& fn) const {
+    if (out.rank() == 1) {
+        auto view = atlas::array::make_view<double, 1>(out);
+        for (const auto& s : stencils_) {
+            view(s.source) = fn(s, 0);
+        }
+    }
+    else {
+        auto view               = atlas::array::make_view<double, 2>(out);
+        const atlas::idx_t nlev = view.shape(1);
+        for (const auto& s : stencils_) {
+            for (atlas::idx_t k = 0; k < nlev; ++k) {
+                view(s.source, k) = fn(s, k);
+            }
+        }
+    }
+}
+
+
+void HorizontalDerivatives::ddx(const atlas::Field& f, atlas::Field& dfdx) const {
+    auto [fv] = views(dfdx, f);
+    forEach(dfdx, [&fv = fv](const Stencil& s, atlas::idx_t k) { return dx(fv, s, k); });
+}
+
+void HorizontalDerivatives::ddy(const atlas::Field& f, atlas::Field& dfdy) const {
+    auto [fv] = views(dfdy, f);
+    forEach(dfdy, [&fv = fv](const Stencil& s, atlas::idx_t k) { return dy(fv, s, k); });
+}
+
+void HorizontalDerivatives::laplacian(const atlas::Field& f, atlas::Field& lap) const {
+    auto [fv] = views(lap, f);
+    forEach(lap, [&fv = fv](const Stencil& s, atlas::idx_t k) {
+        return dx2(fv, s, k) + dy2(fv, s, k) - s.tanOverR * dy(fv, s, k);
+    });
+}
+
+void HorizontalDerivatives::vorticity(const atlas::Field& u, const atlas::Field& v, atlas::Field& vort) const {
+    auto [uv, vv] = views(vort, u, v);
+    forEach(vort, [&uv = uv, &vv = vv](const Stencil& s, atlas::idx_t k) {
+        return dx(vv, s, k) - dy(uv, s, k) + s.tanOverR * uv(s.point, k);
+    });
+}
+
+void HorizontalDerivatives::divergence(const atlas::Field& u, const atlas::Field& v, atlas::Field& div) const {
+    auto [uv, vv] = views(div, u, v);
+    forEach(div, [&uv = uv, &vv = vv](const Stencil& s, atlas::idx_t k) {
+        return dx(uv, s, k) + dy(vv, s, k) - s.tanOverR * vv(s.point, k);
+    });
+}
+
+}  // namespace data
+}  // namespace plume
@@ -0,0 +1,128 @@
+/*
+ * (C) Copyright 2025- ECMWF.
+ *
+ * This software is licensed under the terms of the Apache Licence Version 2.0
+ * which can be obtained at http://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * In applying this licence, ECMWF does not waive the privileges and immunities
+ * granted to it by virtue of its status as an intergovernmental organisation nor
+ * does it submit to any jurisdiction.
+ */
+#pragma once
+
+#include <memory>
+#include <vector>
+
+#include "eckit/memory/NonCopyable.h"
+
+#include "atlas/field/Field.h"
+#include "atlas/field/FieldSet.h"
+#include "atlas/functionspace/StructuredColumns.h"
+
+
+namespace plume {
+namespace data {
+
+class StrategyContext;
+
+/**
+ * @brief Horizontal derivatives on the sphere of fields on StructuredColumns, by centred finite differences.
+ *
+ * The stencil of each owned point (its east and west neighbours, and its neighbours interpolated in longitude on the
+ * rows north and south of it) is computed once per function space. Differences in latitude are one-sided on the first
+ * and last rows of the grid, and differences in longitude are zero at the poles.
+ *
+ * The model fields usually have no halo: derivatives are computed on halo copies of them (double precision, on the
+ * same grid and distribution with a halo of 1), filled in by a single halo exchange for all the fields of a step.
+ */
+class HorizontalDerivatives : private eckit::NonCopyable {
+
+public:
+
+    /**
+     * @brief Stencils of the owned points of a function space (collective)
+     *
+     * @throws eckit::BadValue If the function space is not StructuredColumns, or if it has no halo and its distribution
+     * is not the default one of its grid.
+     */
+    explicit HorizontalDerivatives(const atlas::FunctionSpace& functionspace);
+
+    /// Derivatives shared by all the users of the same function space in a context (built on first use, collective).
+    static std::shared_ptr<const HorizontalDerivatives> cached(StrategyContext& context,
+                                                               const atlas::FunctionSpace& functionspace);
+
+    /// Halo copies, (nhalo, nlev), of (npoints[, nlev]) fields on the function space, in one halo exchange (collective).
+    std::vector<atlas::Field> exchange(const std::vector<atlas::Field>& fields) const;
+
+    // Steps of the above, for halo copies allocated once and exchanged with those of other users
+
+    /// Halo copies, (nhalo, nlev), for (npoints[, nlev]) fields on the function space (not filled).
+    std::vector<atlas::Field> haloCopies(const std::vector<atlas::Field>& fields) const;
+
+    /// Copies the owned points of a field into its halo copy.
+    void copyOwned(const atlas::Field& field, atlas::Field& copy) const;
+
+    /// Fills in the halos of halo copies, in one halo exchange (collective).
+    void exchange(const atlas::FieldSet& copies) const;
+
+    // Derivatives of halo copies, into double precision (npoints[, nlev]) fields on the function space (owned points)
+
+    void ddx(const atlas::Field& f, atlas::Field& dfdx) const;
+
+    void ddy(const atlas::Field& f, atlas::Field& dfdy) const;
+
+    void laplacian(const atlas::Field& f, atlas::Field& lap) const;
+
+    /// Relative vorticity of the wind (u, v).
+    void vorticity(const atlas::Field& u, const atlas::Field& v, atlas::Field& vort) const;
+
+    /// Divergence of the wind (u, v).
+    void divergence(const atlas::Field& u, const atlas::Field& v, atlas::Field& div) const;
+
+private:
+
+    struct Stencil {
+        atlas::idx_t source;  // point of the function space
+        atlas::idx_t point;   // point of the halo copies, and its neighbours
+        atlas::idx_t east;
+        atlas::idx_t west;
+
+        // neighbours north and south, interpolated in longitude between 0 and 1
+        atlas::idx_t north0;
+        atlas::idx_t north1;
+        double northWeight;
+        atlas::idx_t south0;
+        atlas::idx_t south1;
+        double southWeight;
+
+        // coefficients of the differences (1/m, 1/m^2), tan(lat) / R (1/m) for the metric terms
+        double ddx;
+        double ddyNorth;
+        double ddyCentre;
+        double ddySouth;
+        double d2dy2North;
+        double d2dy2Centre;
+        double d2dy2South;
+        double tanOverR;
+    };
+
+    template <typename T>
+    void copyPoints(const atlas::Field& field, atlas::Field& copy) const;
+
+    // halo copies of (npoints[, nlev]) fields like out, as (nhalo, nlev) views
+    template <typename... Fields>
+    auto views(const atlas::Field& out, const Fields&... fields) const;
+
+    // out(point, level) = fn(stencil, level) on the owned points
+    template <typename Fn>
+    void forEach(atlas::Field& out, Fn&& fn) const;
+
+    atlas::functionspace::StructuredColumns fs_;
+
+    atlas::functionspace::StructuredColumns halo_;
+
+    std::vector<Stencil> stencils_;
+};
+
+}  // namespace data
+}  // namespace plume
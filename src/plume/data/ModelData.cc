@@ -12,31 +12,73 @@
 #include <exception>
 
 #include <plume/data/ModelData.h>
+#include "plume/Probes.h"
 
 
 namespace plume {
 namespace data {
 
 
-ModelData::ModelData() {
+ModelData::ModelData() :
+    valueMap_{std::make_shared<const ValueMap>()}, strategyContext_{std::make_shared<StrategyContext>()} {
     // registering update strategies
     registerStrategy<field_provider::WindAtHeight>();
+    registerStrategy<field_provider::LevelView>();
+    registerStrategy<field_provider::LevelCopy>();
+    registerStrategy<field_provider::AreaSubset>();
+    registerStrategy<field_provider::Representation>();
+    registerStrategy<field_provider::PrecisionRepresentation>();
+    registerStrategy<field_provider::LayoutRepresentation>();
+    registerStrategy<field_provider::GlobalStatistic>();
+    registerStrategy<field_provider::ThresholdExceedance>();
+    registerStrategy<field_provider::LocalThresholdExceedance>();
+    registerStrategy<field_provider::StationValues>();
+    registerStrategy<field_provider::WindDerivative>();
+    registerStrategy<field_provider::StencilDerivative>();
+    registerStrategy<field_provider::FieldHistory>();
+}
+
+
+ModelData::ModelData(const ModelData& other) {
+    std::lock_guard<std::mutex> lock(other.writerMutex_);
+    valueMap_         = other.snapshot();
+    strategyRegistry_ = other.strategyRegistry_;
+    strategyHelpers_  = other.strategyHelpers_;
+    strategyContext_  = other.strategyContext_;
+    accessProfile_    = other.accessProfile_;
+}
+
+
+ModelData& ModelData::operator=(const ModelData& other) {
+    if (this != &other) {
+        std::scoped_lock lock(writerMutex_, other.writerMutex_);
+        assertNotFrozen("assign model data");
+        std::atomic_store(&valueMap_, other.snapshot());
+        strategyRegistry_ = other.strategyRegistry_;
+        strategyHelpers_  = other.strategyHelpers_;
+        strategyContext_  = other.strategyContext_;
+        accessProfile_    = other.accessProfile_;
+    }
+    return *this;
 }
 
 
 // Get a subset of the ModelData
 ModelData ModelData::filter(std::set<std::string> params) const {
-    ModelData filteredData;
-    std::vector<std::string> availParams = getAvailableValues();
+    auto table = snapshot();
+    auto filteredTable = std::make_shared<ValueMap>();
     for (const auto& key : params) {
-        if (std::find(availParams.begin(), availParams.end(), key) != availParams.end()) {
-            auto entry = valueMap_.at(key);
-            filteredData.valueMap_.insert(std::make_pair(key, entry));
+        auto it = table->find(key);
+        if (it != table->end()) {
+            filteredTable->insert(*it);
         }
         else {
             eckit::Log::info() << "Parameter: " << key << " NOT found in Data! " << std::endl;
         }
     }
+    ModelData filteredData;
+    filteredData.valueMap_        = std::move(filteredTable);
+    filteredData.strategyContext_ = strategyContext_;
     return filteredData;
 }
 
@@ -48,8 +90,41 @@ ModelData ModelData::filter(ParameterCatalogue params) const {
 
 
 // Check if a parameter is in the data
+std::string ModelData::historyName(const std::string& name, std::size_t lag) const {
+    if (name.find(";hist;") != std::string::npos) {
+        return name;
+    }
+    const std::string prefix = name + ";hist;";
+
+    // histories of the source, "K" or "K/precision"
+    std::string shallowest;
+    std::size_t shallowestDepth = 0;
+    for (const auto& [param, value] : *snapshot()) {
+        if (param.compare(0, prefix.size(), prefix) != 0) {
+            continue;
+        }
+        std::size_t depth = std::stoul(param.substr(prefix.size()));
+        if (depth > lag && (shallowest.empty() || depth < shallowestDepth)) {
+            shallowest      = param;
+            shallowestDepth = depth;
+        }
+    }
+    if (shallowest.empty()) {
+        throw eckit::BadParameter("No history of parameter '" + name + "' holding lag " + std::to_string(lag) +
+                                      " in model data!",
+                                  Here());
+    }
+    return shallowest;
+}
+
+
 bool ModelData::hasParameter(const std::string& name) const {
-    return valueMap_.find(name) != valueMap_.end();
+    return findValue(name) != nullptr;
+}
+
+
+bool ModelData::hasParameter(ParamId id) const {
+    return findValue(id) != nullptr;
 }
 
 
@@ -60,10 +135,9 @@ bool ModelData::hasParameter(const std::string& name, const std::string& level,
 
 
 bool ModelData::hasParameter(const std::string& name, const ParameterType& type) const {
-    if (valueMap_.find(name) != valueMap_.end()) {
-        ASSERT_MSG(valueMap_.at(name)->type() == type,
-                   "value.type = " + std::string(typeToString(valueMap_.at(name)->type())) +
-                       " vs expected = " + std::string(typeToString(type)));
+    if (auto value = findValue(name)) {
+        ASSERT_MSG(value->type() == type, "value.type = " + std::string(typeToString(value->type())) +
+                                              " vs expected = " + std::string(typeToString(type)));
         return true;
     }
     return false;
@@ -71,8 +145,9 @@ bool ModelData::hasParameter(const std::string& name, const ParameterType& type)
 
 
 bool ModelData::isUpdated(const std::string& name) const {
-    ASSERT_MSG(valueMap_.find(name) != valueMap_.end(), "Element not found in model data: " + name);
-    return valueMap_.at(name)->isUpdated();
+    auto value = findValue(name);
+    ASSERT_MSG(value, "Element not found in model data: " + name);
+    return value->isUpdated();
 }
 
 bool ModelData::isUpdated(const std::string& name, const std::string& level, const std::string& levtype) const {
@@ -82,24 +157,82 @@ bool ModelData::isUpdated(const std::string& name, const std::string& level, con
 
 
 void ModelData::setUpdated(const std::vector<std::string>& params) {
+    freeze();  // the first update ends the setup phase, all sessions have been fed by now
     clearUpdated();
+    StrategyContext::Step batch(*strategyContext_);  // collectives of the strategies are batched until the end
+    auto table = snapshot();
+    [[maybe_unused]] std::uint64_t step = 0;
     for (const auto& name : params) {
-        ASSERT_MSG(valueMap_.find(name) != valueMap_.end(), "Element not found in model data: " + name);
-        valueMap_.at(name)->setUpdated(true);
+        auto it = table->find(name);
+        ASSERT_MSG(it != table->end(), "Element not found in model data: " + name);
+        it->second->setUpdated(true);
+        step = std::max(step, it->second->generation());
     }
+    batch.end();
+    PLUME_PROBE(commit, step, params.size());
+}
+
+
+void ModelData::setUpdatedIds(const std::vector<ParamId>& ids) {
+    freeze();  // the first update ends the setup phase, all sessions have been fed by now
+    clearUpdated();
+    StrategyContext::Step batch(*strategyContext_);  // collectives of the strategies are batched until the end
+    [[maybe_unused]] std::uint64_t step = 0;
+    for (const auto& id : ids) {
+        auto value = findValue(id);
+        ASSERT_MSG(value, "Element not found in model data: id " + std::to_string(id.value()));
+        value->setUpdated(true);
+        step = std::max(step, value->generation());
+    }
+    batch.end();
+    PLUME_PROBE(commit, step, ids.size());
+}
+
+
+void ModelData::setUpdatedMask(const std::uint64_t* mask, std::size_t words) {
+    ASSERT(mask || words == 0);
+    freeze();  // the first update ends the setup phase, all sessions have been fed by now
+    clearUpdated();
+    StrategyContext::Step batch(*strategyContext_);  // collectives of the strategies are batched until the end
+    auto index = idIndex();
+    [[maybe_unused]] std::uint64_t step = 0;
+    [[maybe_unused]] std::size_t count  = 0;
+    for (std::size_t w = 0; w < words; ++w) {
+        for (std::size_t bit = 0; bit < 64 && mask[w] >> bit != 0; ++bit) {
+            if ((mask[w] >> bit & 1) == 0) {
+                continue;
+            }
+            std::size_t id = 64 * w + bit;
+            ASSERT_MSG(id < index->values.size() && index->values[id],
+                       "Element not found in model data: id " + std::to_string(id));
+            index->values[id]->setUpdated(true);
+            step = std::max(step, index->values[id]->generation());
+            ++count;
+        }
+    }
+    batch.end();
+    PLUME_PROBE(commit, step, count);
 }
 
 
 void ModelData::clearUpdated() {
-    for (const auto& [param, value] : valueMap_) {
+    for (const auto& [param, value] : *snapshot()) {
         value->setUpdated(false);
+        value->invalidate();
     }
 }
 
 
+std::uint64_t ModelData::generation(const std::string& name) const {
+    auto value = findValue(name);
+    ASSERT_MSG(value, "Element not found in model data: " + name);
+    return value->generation();
+}
+
+
 void ModelData::print() const {
     eckit::Log::info() << "*** Parameters: " << std::endl;
-    for (auto k : valueMap_) {
+    for (const auto& k : *snapshot()) {
         eckit::Log::info() << "Param: " << k.first << std::endl;
     }
 }
@@ -108,7 +241,7 @@ void ModelData::print() const {
 std::vector<std::string> ModelData::listAvailableParameters(std::string type_string) const {
     ParameterType type = typeFromString(type_string.c_str());
     std::vector<std::string> keys;
-    for (const auto& key : valueMap_) {
+    for (const auto& key : *snapshot()) {
         if (key.second->type() == type) {
             keys.push_back(key.first);
         }
@@ -116,33 +249,131 @@ std::vector<std::string> ModelData::listAvailableParameters(std::string type_str
     return keys;
 }
 
+
+void ModelData::provideArray(const std::string& name, const ArrayView& view) {
+    ASSERT_MSG(view.data() != nullptr, "Provided array '" + name + "' has no data");
+    std::lock_guard<std::mutex> lock(writerMutex_);
+    assertNotFrozen("provide parameter '" + name + "'");
+    // the value owns the view, not the array
+    if (!publishValue(name, std::make_shared<ParameterValue<ArrayView, IParameterObservable>>(view))) {
+        eckit::Log::warning() << "Parameter '" << name << "' already in Model Data. Not inserted!" << std::endl;
+    }
+}
+
+std::vector<ParamId> ModelData::provideFieldSet(atlas::FieldSet fields) {
+    std::vector<ParamId> ids;
+    std::lock_guard<std::mutex> lock(writerMutex_);
+    assertNotFrozen("provide field set");
+    auto table = std::make_shared<ValueMap>(*snapshot());
+    for (atlas::idx_t i = 0; i < fields.size(); ++i) {
+        atlas::Field& field = fields[i];
+        ASSERT_MSG(field.bytes() >= 0, "Provided Atlas field not readable!");
+        auto value = std::make_shared<ParameterValue<atlas::Field::Implementation, IParameterObservable>>(field.get());
+        // the id of an existing parameter would mark it as updated in place of the field
+        if (!table->emplace(field.name(), std::move(value)).second) {
+            throw eckit::UserError("Parameter '" + field.name() + "' of the field set already in Model Data", Here());
+        }
+        ids.emplace_back(field.name());
+    }
+    std::atomic_store(&valueMap_, std::shared_ptr<const ValueMap>(std::move(table)));
+    return ids;
+}
+
+
 // -------- private
 
+std::shared_ptr<const ModelData::IdIndex> ModelData::idIndex() const {
+    auto table = snapshot();
+    auto index = std::atomic_load(&idIndex_);
+    if (index && index->table == table) {
+        return index;
+    }
+    auto rebuilt   = std::make_shared<IdIndex>();
+    rebuilt->table = table;
+    for (const auto& [name, value] : *table) {
+        auto id = ParamId(name).value();
+        if (id >= rebuilt->values.size()) {
+            rebuilt->values.resize(id + 1);
+        }
+        rebuilt->values[id] = value;
+    }
+    index = std::move(rebuilt);
+    std::atomic_store(&idIndex_, index);
+    return index;
+}
+
+
+void ModelData::assertNotFrozen(const std::string& action) const {
+    if (isFrozen()) {
+        throw eckit::UserError("Model data is frozen, cannot " + action, Here());
+    }
+}
+
+
+bool ModelData::publishValue(const std::string& name, std::shared_ptr<IParameterValue> value) {
+    auto current = snapshot();
+    if (current->find(name) != current->end()) {
+        return false;
+    }
+    auto table = std::make_shared<ValueMap>(*current);
+    table->emplace(name, std::move(value));
+    std::atomic_store(&valueMap_, std::shared_ptr<const ValueMap>(std::move(table)));
+    return true;
+}
+
+
+void ModelData::unpublishValue(const std::string& name) {
+    auto table = std::make_shared<ValueMap>(*snapshot());
+    table->erase(name);
+    std::atomic_store(&valueMap_, std::shared_ptr<const ValueMap>(std::move(table)));
+}
+
+
 void ModelData::addDependency(const std::string& observer, const std::string& observable, const std::string& type,
                               const eckit::Configuration& config) {
+    auto table = snapshot();
     // 1. attach observer to observable
-    auto publisher = std::dynamic_pointer_cast<IParameterObservable>(valueMap_.at(observable));
+    auto publisher = std::dynamic_pointer_cast<IParameterObservable>(table->at(observable));
     if (!publisher) {
         throw eckit::BadCast("'" + observable + "' is not an Observable parameter!", Here());
     }
-    auto subscriber = std::dynamic_pointer_cast<IParameterObserver>(valueMap_.at(observer));
+    auto subscriber = std::dynamic_pointer_cast<IParameterObserver>(table->at(observer));
     if (!subscriber) {
         throw eckit::BadCast("'" + observer + "' is an observable, it cannot subscribe to other parameters!", Here());
     }
-    subscriber->setSubject(publisher);
     // 2. parse config and build arg list
-    field_provider::StrategyArgList strategyArgs = strategyHelpers_.at(type)(config, valueMap_, observable, observer);
-    // 3. create update strategy
+    field_provider::StrategyArgList strategyArgs = strategyHelpers_.at(type)(config, *table, observable, observer);
+    // 3. create update strategy (may reject the configuration, before any subscription), in the context of this data
+    StrategyContext::Scope scope(strategyContext_);
     auto strategy = strategyRegistry_.at(type)(strategyArgs);
     // 4. attach strategy to observer (initial value populated on first step run)
     subscriber->setUpdateStrategy(std::move(strategy));
+    subscriber->setSubject(publisher);
+}
+
+
+ArrayView ModelData::getArray(const std::string& name) const {
+    auto value = findValue(name);
+    if (!value) {
+        throw eckit::BadParameter("Parameter '" + name + "' not found in model data!", Here());
+    }
+    if (value->type() == ParameterType::ARRAY) {
+        return getParam<ArrayView>(name);
+    }
+    if (value->type() != ParameterType::ATLAS_FIELD) {
+        throw eckit::BadCast("Parameter '" + name + "' is neither an Atlas field nor an array", Here());
+    }
+    auto field = getParam<atlas::Field>(name);
+    std::vector<long> shape(field.shape().begin(), field.shape().end());
+    std::vector<long> strides(field.strides().begin(), field.strides().end());
+    return ArrayView(field.storage(), field.datatype().str(), shape, strides);
 }
 
 
 // All values available
 std::vector<std::string> ModelData::getAvailableValues() const {
     std::vector<std::string> keys;
-    for (const auto& key : valueMap_) {
+    for (const auto& key : *snapshot()) {
         keys.push_back(key.first);
     }
     return keys;
@@ -172,6 +403,9 @@ void ModelData::dispatchCreateParam(const std::string& strategy, const eckit::Co
             return createParam<std::string>(strategy, config);
         case ParameterType::ATLAS_FIELD:
             return createParam<atlas::Field>(strategy, config);
+        case ParameterType::ARRAY:
+            throw eckit::BadValue("Derived parameters of type ARRAY are not supported, arrays are provided by models",
+                                  Here());
         default:
             throw eckit::BadValue("Parameter Type invalid or not recognised!", Here());
     }
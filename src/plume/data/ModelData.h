@@ -10,9 +10,12 @@
  */
 #pragma once
 
+#include <atomic>
+#include <cstdint>
 #include <functional>
 #include <map>
 #include <memory>
+#include <mutex>
 #include <set>
 #include <string>
 #include <type_traits>
@@ -24,22 +27,44 @@
 #include "eckit/value/Value.h"
 
 #include "atlas/field/Field.h"
+#include "atlas/field/FieldSet.h"
 #include "atlas/field/detail/FieldImpl.h"
 
+#include "plume/ThreadAffinity.h"
+#include "plume/data/AccessProfile.h"
+#include "plume/data/ArrayView.h"
 #include "plume/data/ParameterCatalogue.h"
 #include "plume/data/ParameterType.h"
 #include "plume/data/ParameterValue.h"
+#include "plume/data/StrategyContext.h"
 
 
 namespace plume {
 namespace data {
 
 
-// Container class for Values and pointers
+/**
+ * @brief Container class for Values and pointers
+ *
+ * Concurrency model:
+ * - The parameter table is immutable once published. Readers take a snapshot of the current table (RCU-style) and
+ *   never lock, so any number of threads can query parameters, updated flags and generations concurrently.
+ * - Structural changes (creating/providing parameters, registering strategies) go through a single writer: the table
+ *   is copied, modified and republished under the writer mutex.
+ * - Once `freeze()` has been called (the first `setUpdated*` does it, after all the sessions have been fed), the
+ *   table can no longer change and structural changes throw. Only parameter values and their updated flags change
+ *   during the frozen phase.
+ *
+ * @note Updating parameter values (`updateParam`, `setUpdated`) is the job of the data provider, and should not
+ *       overlap with plugins reading those values.
+ */
 class ModelData {
+public:
+    using ValueMap = std::map<std::string, std::shared_ptr<IParameterValue>>;
+
 private:
-    // Values & Strategies
-    std::map<std::string, std::shared_ptr<IParameterValue>> valueMap_;
+    // Values (immutable table, republished on structural changes) & Strategies
+    std::shared_ptr<const ValueMap> valueMap_;
     std::unordered_map<std::string, std::function<std::unique_ptr<field_provider::UpdateStrategy>(
                                         const field_provider::StrategyArgList&)>>
         strategyRegistry_;
@@ -49,11 +74,60 @@ private:
                            const std::string&, const std::string&)>>
         strategyHelpers_;
 
+    // single writer for structural changes
+    mutable std::mutex writerMutex_;
+    std::atomic<bool> frozen_{false};
+
+    // state of the strategies created by this data (shared by copies and filtered subsets)
+    std::shared_ptr<StrategyContext> strategyContext_;
+
+    // Optional, records parameter reads (shared by copies, not by filtered subsets)
+    std::shared_ptr<AccessProfile> accessProfile_;
+
+    // values of a table indexed by param id (see ParamId::value), built on first use by id
+    struct IdIndex {
+        std::shared_ptr<const ValueMap> table;
+        std::vector<std::shared_ptr<IParameterValue>> values;
+    };
+    mutable std::shared_ptr<const IdIndex> idIndex_;
+
+    /// Index of the current table, rebuilt if the table has been republished since.
+    std::shared_ptr<const IdIndex> idIndex() const;
+
     /**
      * @brief Returns the names of all parameters in the value map.
      */
     std::vector<std::string> getAvailableValues() const;
 
+    /// Current parameter table, safe to use from any thread.
+    std::shared_ptr<const ValueMap> snapshot() const { return std::atomic_load(&valueMap_); }
+
+    /// Returns the parameter value, nullptr if not found.
+    std::shared_ptr<IParameterValue> findValue(const std::string& name) const {
+        auto table = snapshot();
+        auto it    = table->find(name);
+        return it != table->end() ? it->second : nullptr;
+    }
+
+    /// Returns the parameter value, nullptr if not found.
+    std::shared_ptr<IParameterValue> findValue(ParamId id) const {
+        auto index = idIndex();
+        return id.valid() && id.value() < index->values.size() ? index->values[id.value()] : nullptr;
+    }
+
+    /// Name of the history param of a source param holding a lag, or the name itself if it is a history param.
+    std::string historyName(const std::string& name, std::size_t lag) const;
+
+    /// Throws if the table is frozen, to be called with the writer lock held.
+    void assertNotFrozen(const std::string& action) const;
+
+    /// Republishes the table with a new parameter, to be called with the writer lock held. Returns false if the
+    /// parameter already exists.
+    bool publishValue(const std::string& name, std::shared_ptr<IParameterValue> value);
+
+    /// Republishes the table without a parameter, to be called with the writer lock held.
+    void unpublishValue(const std::string& name);
+
     /**
      * @brief Constructs a concrete strategy but does not attach it yet to a parameter.
      *
@@ -78,6 +152,20 @@ public:
 
     ~ModelData() = default;  // Nothing to do here (each parameter destructs its data pointer, as appropriate..)
 
+    /// Copies share the (immutable) parameter table, but not the frozen state.
+    ModelData(const ModelData& other);
+    ModelData& operator=(const ModelData& other);
+
+    /**
+     * @brief Makes the parameter table immutable, structural changes throw from now on.
+     *
+     * Called by the first `setUpdated*`, so that several sessions can create their derived parameters on the same
+     * data.
+     */
+    void freeze() { frozen_.store(true, std::memory_order_release); }
+
+    bool isFrozen() const { return frozen_.load(std::memory_order_acquire); }
+
     /**
      * @brief Creates a new value of type T, and transfer its ownership to a parameter wrapper.
      *
@@ -90,8 +178,9 @@ public:
     void createParam(std::string name, T valInit) {
         static_assert(!std::is_base_of_v<atlas::Field::Implementation, T>,
                       "Atlas field implementations are only for observation");
-        auto res = valueMap_.try_emplace(name, std::make_shared<ParameterValue<T, IParameterObserver>>(valInit));
-        if (!res.second) {
+        std::lock_guard<std::mutex> lock(writerMutex_);
+        assertNotFrozen("create parameter '" + name + "'");
+        if (!publishValue(name, std::make_shared<ParameterValue<T, IParameterObserver>>(valInit))) {
             eckit::Log::warning() << "Parameter '" << name << "' already in Model Data. Not inserted!" << std::endl;
         }
     }
@@ -113,6 +202,7 @@ public:
     void createParam(const std::string& strategy, const eckit::Configuration& config, std::string name = "") {
         static_assert(!std::is_base_of_v<atlas::Field::Implementation, T>,
                       "Atlas field implementations are only for observation");
+        std::lock_guard<std::mutex> lock(writerMutex_);
         // 1. name the param entry using defaults or user instructions
         std::string paramName = name;
         if (paramName.empty()) {
@@ -124,21 +214,30 @@ public:
                                   << std::endl;
             return;
         }
+        assertNotFrozen("create parameter '" + paramName + "'");
         // 2. create the observing value valInit (default constructor or clone source field)
         // 3. create the param value and insert it in the map
         if constexpr (std::is_same_v<T, atlas::Field>) {
-            atlas::Field fieldInit = getParam<atlas::Field>(config.getString("name")).clone();
+            // Plume-owned copy, allocated and first touched close to the Plume cores (if configured)
+            atlas::Field fieldInit;
+            ThreadAffinity::current().firstTouch(
+                [&]() { fieldInit = getParam<atlas::Field>(config.getString("name")).clone(); });
             fieldInit.rename(paramName);
             fieldInit.metadata().set("plume-owned", true);
-            valueMap_.try_emplace(paramName,
-                                  std::make_shared<ParameterValue<atlas::Field, IParameterObserver>>(fieldInit));
+            publishValue(paramName, std::make_shared<ParameterValue<atlas::Field, IParameterObserver>>(fieldInit));
         }
         else {
             T valInit{};
-            valueMap_.try_emplace(paramName, std::make_shared<ParameterValue<T, IParameterObserver>>(valInit));
+            publishValue(paramName, std::make_shared<ParameterValue<T, IParameterObserver>>(valInit));
         }
         // 4. subscribe the newly created param to the source param & compute its initial value
-        addDependency(paramName, config.getString("name"), strategy, config);
+        try {
+            addDependency(paramName, config.getString("name"), strategy, config);
+        }
+        catch (...) {
+            unpublishValue(paramName);  // no param left without its strategy
+            throw;
+        }
     }
 
     /**
@@ -151,8 +250,55 @@ public:
         if constexpr (std::is_same_v<T, atlas::Field> || std::is_same_v<T, atlas::Field::Implementation>) {
             ASSERT_MSG(ptr->bytes() >= 0, "Provided Atlas field not readable!");
         }
-        auto res = valueMap_.try_emplace(name, std::make_shared<ParameterValue<T, IParameterObservable>>(ptr));
-        if (!res.second) {
+        std::lock_guard<std::mutex> lock(writerMutex_);
+        assertNotFrozen("provide parameter '" + name + "'");
+        if (!publishValue(name, std::make_shared<ParameterValue<T, IParameterObservable>>(ptr))) {
+            eckit::Log::warning() << "Parameter '" << name << "' already in Model Data. Not inserted!" << std::endl;
+        }
+    }
+
+    /**
+     * @brief Provides a strided array owned by the model (type ARRAY), described by a view.
+     *
+     * Only the view is kept (the array is neither copied nor allocated by Plume), values written by the model in
+     * place are seen by the plugins at the next `setUpdated`.
+     *
+     * @warning The array should outlive Plume to avoid undefined behaviour.
+     */
+    void provideArray(const std::string& name, const ArrayView& view);
+
+    /**
+     * @brief Provides observation-only pointers to all the fields of a field set, each named as its field.
+     *
+     * The parameter table is republished once for the whole set.
+     *
+     * @return The ids of the fields, in the order of the set (to mark them as updated with `setUpdatedIds`).
+     * @throws eckit::UserError If a field is named as a parameter of the data (or another field of the set), in which
+     *         case none of the fields is provided.
+     * @warning The fields should outlive Plume to avoid undefined behaviour.
+     */
+    std::vector<ParamId> provideFieldSet(atlas::FieldSet fields);
+
+    /**
+     * @brief Provides an observation-only pointer to a value computed on demand by the model.
+     *
+     * The producer fills the pointed value the first time it is accessed (by a plugin or an update strategy) in each
+     * step, i.e. after each `setUpdated`/`clearUpdated`. The model then only pays for values that are consumed.
+     *
+     * @warning Only reads through the model data (`getParam`, `getAtlasFieldShared`, ...) run the producer. A plugin
+     *          that keeps a handle from an earlier read (e.g. the atlas::Field or a pointer to its data) sees the
+     *          values of the last step it was produced in, without any error: lazy parameters must be read again
+     *          from the model data in each step.
+     * @warning The value and the producer should outlive Plume. The producer may run on a Plume thread.
+     */
+    template <typename T>
+    void provideParam(std::string name, T* ptr, std::function<void()> producer) {
+        ASSERT_MSG(producer, "Producer of parameter '" + name + "' is empty");
+        std::lock_guard<std::mutex> lock(writerMutex_);
+        assertNotFrozen("provide parameter '" + name + "'");
+        auto value = std::make_shared<ParameterValue<T, IParameterObservable>>(ptr);
+        value->setProducer(std::move(producer));
+        if (!publishValue(name, value)) {
             eckit::Log::warning() << "Parameter '" << name << "' already in Model Data. Not inserted!" << std::endl;
         }
     }
@@ -164,16 +310,17 @@ public:
      */
     template <typename T>
     void updateParam(std::string name, T newVal) {
-        if (!hasParameter(name)) {
+        auto value = findValue(name);
+        if (!value) {
             throw eckit::BadParameter("Parameter '" + name + "' not found in model data!", Here());
         }
-        if (auto typedPtr = std::dynamic_pointer_cast<IParameterObserver>(valueMap_.at(name))) {
+        if (auto typedPtr = std::dynamic_pointer_cast<IParameterObserver>(value)) {
             if (typedPtr->observes()) {
                 throw eckit::AssertionFailed("Observer parameters actively observing can only be updated by strategies",
                                              Here());
             }
         }
-        if (auto typedPtr = std::dynamic_pointer_cast<ParameterValueTyped<T>>(valueMap_.at(name))) {
+        if (auto typedPtr = std::dynamic_pointer_cast<ParameterValueTyped<T>>(value)) {
             typedPtr->set(newVal);
         }
         else {
@@ -187,22 +334,31 @@ public:
      * @note This interface can be used for source & derived params if the full name is known.
      */
     template <typename T, typename = std::enable_if_t<!std::is_same<T, atlas::Field::Implementation>::value>>
-    T getParam(std::string name) const {
-        if (!hasParameter(name)) {
+    T getParam(const std::string& name) const {
+        if (accessProfile_) {
+            accessProfile_->recordRead(name);
+        }
+        auto value = findValue(name);
+        if (!value) {
             throw eckit::BadParameter("Parameter '" + name + "' not found in model data!", Here());
         }
-        if (auto typedPtr = std::dynamic_pointer_cast<ParameterValueTyped<T>>(valueMap_.at(name))) {
+        if (auto typedPtr = std::dynamic_pointer_cast<ParameterValueTyped<T>>(value)) {
             return typedPtr->get();
         }
         if constexpr (std::is_same_v<T, atlas::Field>) {
-            if (auto typedPtr =
-                    std::dynamic_pointer_cast<ParameterValueTyped<atlas::Field::Implementation>>(valueMap_.at(name))) {
+            if (auto typedPtr = std::dynamic_pointer_cast<ParameterValueTyped<atlas::Field::Implementation>>(value)) {
                 return atlas::Field(&(typedPtr->get()));
             }
         }
         throw eckit::BadCast("Plume parameter view update type mismatch!", Here());
     }
 
+    /// Accesses a value of a parameter from its interned name, as held by catalogues and plugin decisions.
+    template <typename T, typename = std::enable_if_t<!std::is_same<T, atlas::Field::Implementation>::value>>
+    T getParam(ParamId id) const {
+        return getParam<T>(id.name());
+    }
+
     /**
      * @brief Accesses a value of a derived parameter from its source parameter name, levtype and level.
      *
@@ -214,6 +370,31 @@ public:
         return getParam<T>(entryName);
     }
 
+    /**
+     * @brief Describes the memory of an Atlas field or ARRAY parameter as a view (pointer, datatype, shape, strides),
+     *        for plugins reading it in place without Atlas (e.g. through the C API).
+     *
+     * @note The view of a field follows its Atlas shape and strides, level views included.
+     */
+    ArrayView getArray(const std::string& name) const;
+
+    /// As above, for a derived field from its source parameter name, level and levtype (e.g. a level subset)
+    ArrayView getArray(const std::string& name, const std::string& level, const std::string& levtype = "ml") const {
+        return getArray(IParameterObserver::deriveParamName(name, levtype, level));
+    }
+
+    /**
+     * @brief Accesses the snapshot of a field `lag` updates ago (0 is the latest), kept by a `history` derived param.
+     *
+     * @param name The source param name (the shallowest history holding the lag is used), or the full name of a
+     *             history param, e.g. 'u;hist;3/float'.
+     * @note The snapshot is a read-only view of the ring buffer shared by all plugins, it is overwritten K updates
+     *       later.
+     */
+    ArrayView getParamHistory(const std::string& name, std::size_t lag) const {
+        return field_provider::historySnapshot(getParam<atlas::Field>(historyName(name, lag)), lag);
+    }
+
     // Return a subset of the ModelData
     ModelData filter(std::set<std::string> params) const;
 
@@ -224,19 +405,44 @@ public:
     bool hasParameter(const std::string& name) const;
     bool hasParameter(const std::string& name, const std::string& level, const std::string& levtype = "hl") const;
     bool hasParameter(const std::string& name, const ParameterType& type) const;
+    bool hasParameter(ParamId id) const;
 
-    // Manage parameters updated state
+    // Manage parameters updated state (clearing also invalidates lazily produced values). Marking parameters as
+    // updated updates their derived parameters, with the collectives of all the strategies batched per call.
     bool isUpdated(const std::string& name) const;  // for plugins to query
     bool isUpdated(const std::string& name, const std::string& level, const std::string& levtype = "hl") const;
     void setUpdated(const std::vector<std::string>& params);  // for data providers
     void clearUpdated();                                      // for data providers or Plume manager to clear after run
 
+    /// Marks parameters as updated from their ids, as `setUpdated` (no name is looked up).
+    void setUpdatedIds(const std::vector<ParamId>& ids);
+
+    /// Marks parameters as updated from a bitmask of their ids: bit `id % 64` of word `id / 64` (see ParamId::value).
+    void setUpdatedMask(const std::uint64_t* mask, std::size_t words);
+
+    // number of times a parameter has been marked as updated
+    std::uint64_t generation(const std::string& name) const;
+
+    /**
+     * @brief Records the reads (`getParam`) of this data and its copies in a profile, or stops recording if null.
+     *
+     * @note To be set before the data is shared with concurrent readers.
+     */
+    void setAccessProfile(std::shared_ptr<AccessProfile> profile) { accessProfile_ = std::move(profile); }
+
+    const std::shared_ptr<AccessProfile>& accessProfile() const { return accessProfile_; }
+
+    /// State shared by the strategies of this data, its copies and subsets (e.g. caches per function space).
+    const std::shared_ptr<StrategyContext>& strategyContext() const { return strategyContext_; }
+
     // list available parameters of a certain type
     std::vector<std::string> listAvailableParameters(std::string type_string) const;
 
     /// Add a concrete strategy factory to the registries to allow creation of various dependencies between parameters.
     template <typename Strategy>
     void registerStrategy() {
+        std::lock_guard<std::mutex> lock(writerMutex_);
+        assertNotFrozen("register strategy");
         field_provider::AutoRegister<Strategy> entry{strategyRegistry_, strategyHelpers_};
     }
 
@@ -9,6 +9,7 @@
  * does it submit to any jurisdiction.
  */
 #include <algorithm>
+#include <sstream>
 
 #include "eckit/exception/Exceptions.h"
 #include "eckit/log/Log.h"
@@ -28,6 +29,14 @@ ParameterDefinition::ParameterDefinition(const eckit::Configuration& config) :
     dataType_  = typeFromString(config.getString("type").c_str());
     available_ = config.getString("available", "on-request");
     comment_   = config.getString("comment", "");
+    datatype_  = config.getString("datatype", "");
+    bytes_     = config.getUnsigned("bytes", 0);
+    if (config.has("shape")) {
+        shape_ = config.getLongVector("shape");
+    }
+    if (!datatype_.empty() && elementSize(datatype_) == 0) {
+        throw eckit::BadParameter("Unknown datatype '" + datatype_ + "' of param '" + name_ + "'", Here());
+    }
 
     // determine strategy, dependencies & derived param name based on the config, if applicable
     bool hasOptions = false;
@@ -49,7 +58,18 @@ ParameterDefinition::ParameterDefinition(const eckit::Configuration& config) :
         strategy_     = strategy;
         dependencies_ = dependencies;
         levtype_      = levtype;
-        config.get(levelKey, level_);
+        if (levelKey.find('+') == std::string::npos) {
+            config.get(levelKey, level_);
+        }
+        else {
+            std::stringstream keys(levelKey);
+            std::string key;
+            while (std::getline(keys, key, '+')) {
+                std::string value;
+                config.get(key, value);
+                level_ += (level_.empty() ? "" : "+") + value;
+            }
+        }
 
         config_.set("levtype", levtype_);
         config_.set("level", level_);
@@ -57,6 +77,7 @@ ParameterDefinition::ParameterDefinition(const eckit::Configuration& config) :
         // Do not change the name in the underlying config as it is going to be used for creating the strategy
         name_ = IParameterObserver::deriveParamName(sourceParam_, levtype_, level_);
     }
+    id_ = ParamId(name_);
 }
 
 // construct from params
@@ -78,6 +99,16 @@ ParameterDefinition::ParameterDefinition(const std::string& name, const Paramete
         return config;
     }()) {}
 
+ParameterDefinition::ParameterDefinition(const std::string& name, const ParameterType& type,
+                                         const std::string& available, const std::string& comment,
+                                         const std::vector<long>& shape, const std::string& datatype) :
+    ParameterDefinition([this, &name, &type, &available, &comment, &shape, &datatype]() {
+        eckit::LocalConfiguration config = params2config(name, typeToString(type), available, comment);
+        config.set("shape", shape);
+        config.set("datatype", datatype);
+        return config;
+    }()) {}
+
 const std::string& ParameterDefinition::name() const {
     return name_;
 }
@@ -114,6 +145,39 @@ const std::vector<std::string>& ParameterDefinition::dependencies() const {
     return dependencies_;
 }
 
+const std::vector<long>& ParameterDefinition::shape() const {
+    return shape_;
+}
+
+const std::string& ParameterDefinition::datatype() const {
+    return datatype_;
+}
+
+std::size_t ParameterDefinition::bytes() const {
+    if (bytes_ > 0 || shape_.empty() || elementSize() == 0) {
+        return bytes_;
+    }
+    std::size_t bytes = elementSize();
+    for (long extent : shape_) {
+        bytes *= static_cast<std::size_t>(std::max(extent, 0L));
+    }
+    return bytes;
+}
+
+std::size_t ParameterDefinition::levels() const {
+    return shape_.size() > 1 ? static_cast<std::size_t>(std::max(shape_[1], 1L)) : 1;
+}
+
+std::size_t ParameterDefinition::elementSize(const std::string& datatype) {
+    if (datatype == "real32" || datatype == "float" || datatype == "int32") {
+        return 4;
+    }
+    if (datatype == "real64" || datatype == "double" || datatype == "int64" || datatype == "uint64") {
+        return 8;
+    }
+    return 0;
+}
+
 // helper constructing function
 eckit::LocalConfiguration ParameterDefinition::params2config(const std::string& name, const std::string& type,
                                                              const std::string& available, const std::string& comment) {
@@ -135,34 +199,45 @@ ParameterCatalogue::ParameterCatalogue(const eckit::Configuration& config) {
     // fill in parameters
     std::vector<eckit::LocalConfiguration> paramsConfigs = config.getSubConfigurations("params");
     for (const auto& parConf : paramsConfigs) {
-        parameters_.push_back(ParameterDefinition(parConf));
+        insertParam(ParameterDefinition(parConf));
     }
 }
 
 ParameterCatalogue::ParameterCatalogue(const ParameterCatalogue& other) {
     parameters_ = other.parameters_;
+    index_      = other.index_;
 }
 
 ParameterCatalogue& ParameterCatalogue::operator=(const ParameterCatalogue& other) {
     parameters_ = other.parameters_;
+    index_      = other.index_;
     return *this;
 }
 
+const ParameterDefinition* ParameterCatalogue::findParam(ParamId id) const {
+    auto it = index_.find(id);
+    return it != index_.end() ? &parameters_[it->second] : nullptr;
+}
+
 const ParameterDefinition& ParameterCatalogue::getParam(const std::string& name) const {
-    auto it = std::find_if(parameters_.begin(), parameters_.end(),
-                           [&name](const ParameterDefinition& obj) { return obj.name() == name; });
-    if (it == parameters_.end()) {
-        auto err = "Param [" + name + "] not in Catalogue! something went wrong..";
-        eckit::Log::error() << err << std::endl;
-        throw eckit::BadValue(err, Here());
+    if (const auto* param = findParam(ParamId::find(name))) {
+        return *param;
     }
-    else {
-        return *it;
+    auto err = "Param [" + name + "] not in Catalogue! something went wrong..";
+    eckit::Log::error() << err << std::endl;
+    throw eckit::BadValue(err, Here());
+}
+
+const ParameterDefinition& ParameterCatalogue::getParam(ParamId id) const {
+    if (const auto* param = findParam(id)) {
+        return *param;
     }
+    return getParam(id.valid() ? id.name() : std::string("<invalid id>"));
 }
 
-// insert a parameter (just a string, for now..)
+// insert a parameter (lookups find the first one of a name)
 ParameterCatalogue& ParameterCatalogue::insertParam(const ParameterDefinition& param) {
+    index_.emplace(param.id(), parameters_.size());
     parameters_.push_back(param);
     return *this;
 }
@@ -193,14 +268,11 @@ eckit::LocalConfiguration ParameterCatalogue::getConfig() const {
 }
 
 bool ParameterCatalogue::hasParam(const std::string& name) const {
-    auto it = std::find_if(parameters_.begin(), parameters_.end(),
-                           [&name](const ParameterDefinition& obj) { return obj.name() == name; });
-    if (it != parameters_.end()) {
-        return true;
-    }
-    else {
-        return false;
-    }
+    return hasParam(ParamId::find(name));
+}
+
+bool ParameterCatalogue::hasParam(ParamId id) const {
+    return index_.find(id) != index_.end();
 }
 
 ParameterCatalogue ParameterCatalogue::filter(const std::unordered_set<std::string>& params) const {
@@ -209,12 +281,11 @@ ParameterCatalogue ParameterCatalogue::filter(const std::unordered_set<std::stri
 
     // insert only the requested params
     for (const auto& name : params) {
-        if (!hasParam(name)) {
+        const auto* param = findParam(ParamId::find(name));
+        if (!param) {
             throw eckit::BadValue("Param " + name + " not found!", Here());
         }
-        else {
-            filtered.parameters_.push_back(getParam(name));
-        }
+        filtered.insertParam(*param);
     }
 
     return filtered;
@@ -20,6 +20,7 @@
 
 #include "plume/Configurable.h"
 #include "plume/data/FieldProvider.h"
+#include "plume/data/ParameterId.h"
 #include "plume/data/ParameterType.h"
 
 namespace plume {
@@ -42,8 +43,12 @@ private:
     std::string comment_;
     std::string levtype_;
     std::string level_;
+    std::vector<long> shape_;
+    std::string datatype_;
+    std::size_t bytes_ = 0;
     ///@}
 
+    ParamId id_;                             ///< Interned name.
     std::string strategy_;                   ///< Optional, strategy name, deduced from above options.
     std::string sourceParam_;                ///< Optional, original param that this param derives from.
     std::vector<std::string> dependencies_;  ///< Optional, based on the strategy requirements.
@@ -56,7 +61,7 @@ private:
      * All params are allowed a set of options which can be referred to here to avoid hardcoding in the constructors.
      */
     inline static const std::unordered_set<std::string> optionalKeys_ = []() {
-        std::unordered_set<std::string> keys = {"available", "comment", "levtype", "level"};
+        std::unordered_set<std::string> keys = {"available", "comment", "levtype", "level", "shape", "datatype", "bytes"};
         for (const auto& key : field_provider::UpdateStrategyTraits<int>::allConfigArgs) {
             keys.insert(std::string(key));
         }
@@ -77,6 +82,9 @@ public:
                         const std::string& comment = "");
     ParameterDefinition(const std::string& name, const ParameterType& type,
                         const std::unordered_map<std::string, std::string>& options);
+    /// An offered field of a given local shape and datatype (e.g. "real64")
+    ParameterDefinition(const std::string& name, const ParameterType& type, const std::string& available,
+                        const std::string& comment, const std::vector<long>& shape, const std::string& datatype);
 
     ~ParameterDefinition() = default;
 
@@ -84,6 +92,7 @@ public:
     bool operator<(const ParameterDefinition& other) const { return name() < other.name(); }
 
     const std::string& name() const;
+    ParamId id() const { return id_; }
     const ParameterType& type() const;
     const std::string& available() const;
     const std::string& comment() const;
@@ -92,6 +101,20 @@ public:
     const std::string& strategy() const;
     const std::string& sourceParam() const;
     const std::vector<std::string>& dependencies() const;
+
+    /// Local shape of an offered field (empty if not offered).
+    const std::vector<long>& shape() const;
+    /// Datatype of an offered field (empty if not offered).
+    const std::string& datatype() const;
+    /// Local size of an offered field in bytes, as offered or from its shape and datatype (0 if unknown).
+    std::size_t bytes() const;
+    /// Number of levels of an offered field (the second dimension of its shape, 1 if none).
+    std::size_t levels() const;
+    /// Size of an element of an offered field (0 if unknown).
+    std::size_t elementSize() const { return elementSize(datatype_); }
+
+    /// Size of an element of a datatype (e.g. "real64" or "double"), 0 if unknown.
+    static std::size_t elementSize(const std::string& datatype);
 };
 
 
@@ -120,6 +143,11 @@ public:
  *     available: on-request
  *     comment: Param 3
  *     height: 100
+ *   - name: param-4
+ *     type: ATLAS_FIELD
+ *     available: on-request
+ *     comment: Param 4
+ *     levels: 128-137
  *
  * Fields:
  * - name      : Unique parameter identifier.
@@ -127,11 +155,44 @@ public:
  * - available : Availability condition (e.g. `always`, `on-request`).
  * - comment   : Human-readable description of the parameter.
  * - height    : The height in meters (wind field only).
+ * - levels    : A regularly spaced selection of model levels of a 3D field, e.g. "128-137" or "1-137/4", exposed as a
+ *               zero-copy strided view (derived param 'name;ml;levels').
+ * - levels-copy : Any selection of model levels, e.g. "1,5,128-137", copied into a compact field shared by all the
+ *               plugins requesting it (derived param 'name;mlc;levels').
+ * - area      : A lat/lon box "N/W/S/E" in degrees, e.g. "60/-10/35/30", whose local points are gathered into a compact
+ *               field shared by all the plugins requesting it (derived param 'name;area;N/W/S/E').
+ * - precision : "float" or "double", a converted copy of a field shared by all the plugins requesting it (derived param
+ *               'name;rep;float'), can be combined with `layout` (derived param 'name;rep;float+level-major').
+ * - layout    : "level-major" for a (nlev, npoints) copy of a 3D field (derived param 'name;rep;level-major').
+ * - statistic : "sum", "mean", "min", "max" or "zonal-mean", the global statistic of a field per level, computed
+ *               collectively on update (derived param 'name;stat;mean').
+ * - threshold : "[>|<]value[/steps]", the sparse list of points exceeding a threshold (for a number of consecutive
+ *               updates), e.g. ">30/3" (derived param 'name;exc;>30/3'). With `count: global`, the points of all
+ *               partitions are also counted (derived param 'name;exc;>30/3+global').
+ * - stations  : "lon/lat,lon/lat,..." in degrees, the values of a field at the points nearest to the stations, gathered
+ *               collectively on update (derived param 'name;pt;lon/lat,...').
+ * - derivative : "ddx", "ddy" or "laplacian", a horizontal derivative of a field on StructuredColumns, computed with a
+ *               halo exchange on update (derived param 'name;der;laplacian').
+ * - wind-derivative : "vorticity" or "divergence" of the wind, with u as source and v as required param (derived param
+ *               'u;der;vorticity').
+ * - history   : "K" or "K/float", the last K snapshots of a field in a ring buffer shared by all the plugins requesting
+ *               it, read with `ModelData::getParamHistory` (derived param 'name;hist;K').
+ *
+ * Offered fields can also give their size on the local partition, used to project the memory of the derived params
+ * (see MemoryBudget):
+ * - shape     : The local shape of the field, e.g. [35718, 137] for (npoints, nlev).
+ * - datatype  : The datatype of the field, "real32", "real64", "int32" or "int64" (or "float", "double").
+ * - bytes     : The local size of the field in bytes, if neither shape nor datatype are given.
  */
 class ParameterCatalogue {
 private:
     std::vector<ParameterDefinition> parameters_;
 
+    // position of each param (the first one of a name) in the parameters
+    std::unordered_map<ParamId, std::size_t> index_;
+
+    const ParameterDefinition* findParam(ParamId id) const;
+
     // internal keys
     constexpr static const char* paramsKey() { return "params"; }
 
@@ -148,6 +209,8 @@ public:
 
     const ParameterDefinition& getParam(const std::string& key) const;
 
+    const ParameterDefinition& getParam(ParamId id) const;
+
     ParameterCatalogue& insertParam(const ParameterDefinition& param);
 
     const std::vector<ParameterDefinition>& getParams() const;
@@ -158,6 +221,8 @@ public:
 
     bool hasParam(const std::string& name) const;
 
+    bool hasParam(ParamId id) const;
+
     ParameterCatalogue filter(const std::unordered_set<std::string>& params) const;
 };
 
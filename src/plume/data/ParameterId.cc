@@ -0,0 +1,88 @@
+/*
+ * (C) Copyright 2025- ECMWF.
+ *
+ * This software is licensed under the terms of the Apache Licence Version 2.0
+ * which can be obtained at http://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * In applying this licence, ECMWF does not waive the privileges and immunities
+ * granted to it by virtue of its status as an intergovernmental organisation nor
+ * does it submit to any jurisdiction.
+ */
+#include <deque>
+#include <mutex>
+#include <shared_mutex>
+#include <string_view>
+#include <unordered_map>
+
+#include "eckit/exception/Exceptions.h"
+
+#include "plume/data/ParameterId.h"
+
+
+namespace plume {
+namespace data {
+
+namespace {
+
+// names (stable addresses) and their ids
+struct InternTable {
+    std::shared_mutex mutex;
+    std::deque<std::string> names;
+    std::unordered_map<std::string_view, std::uint32_t> ids;
+};
+
+InternTable& table() {
+    static InternTable table;
+    return table;
+}
+
+}  // namespace
+
+
+ParamId::ParamId(const std::string& name) {
+    auto& t = table();
+    {
+        std::shared_lock<std::shared_mutex> lock(t.mutex);
+        auto it = t.ids.find(name);
+        if (it != t.ids.end()) {
+            id_ = it->second;
+            return;
+        }
+    }
+    std::unique_lock<std::shared_mutex> lock(t.mutex);
+    auto it = t.ids.find(name);
+    if (it != t.ids.end()) {
+        id_ = it->second;
+        return;
+    }
+    ASSERT_MSG(t.names.size() < invalid_, "ParamId: too many parameter names");
+    id_ = static_cast<std::uint32_t>(t.names.size());
+    t.names.push_back(name);
+    t.ids.emplace(t.names.back(), id_);
+}
+
+
+ParamId ParamId::find(const std::string& name) {
+    auto& t = table();
+    std::shared_lock<std::shared_mutex> lock(t.mutex);
+    auto it = t.ids.find(name);
+    return it != t.ids.end() ? ParamId{it->second} : ParamId{};
+}
+
+
+ParamId ParamId::fromValue(std::uint32_t value) {
+    auto& t = table();
+    std::shared_lock<std::shared_mutex> lock(t.mutex);
+    return value < t.names.size() ? ParamId{value} : ParamId{};
+}
+
+
+const std::string& ParamId::name() const {
+    ASSERT_MSG(valid(), "ParamId: invalid parameter id");
+    auto& t = table();
+    std::shared_lock<std::shared_mutex> lock(t.mutex);
+    return t.names[id_];
+}
+
+}  // namespace data
+}  // namespace plume
@@ -0,0 +1,71 @@
+/*
+ * (C) Copyright 2025- ECMWF.
+ *
+ * This software is licensed under the terms of the Apache Licence Version 2.0
+ * which can be obtained at http://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * In applying this licence, ECMWF does not waive the privileges and immunities
+ * granted to it by virtue of its status as an intergovernmental organisation nor
+ * does it submit to any jurisdiction.
+ */
+#pragma once
+
+#include <cstdint>
+#include <functional>
+#include <limits>
+#include <ostream>
+#include <string>
+
+
+namespace plume {
+namespace data {
+
+/**
+ * @brief Interned parameter name
+ *
+ * Names are interned once in a process-wide table and shared by catalogues, protocols, decisions and model data. Ids
+ * compare and hash as integers and give back their name without copying. The table only grows (it holds each distinct
+ * parameter name once, a few thousand at most).
+ */
+class ParamId {
+public:
+    /// Invalid id (of no name)
+    ParamId() = default;
+
+    /// Id of a name, interned if new.
+    explicit ParamId(const std::string& name);
+
+    /// Id of a name if already interned, invalid otherwise (a name never interned is in no catalogue).
+    static ParamId find(const std::string& name);
+
+    /// Id of a value (as handed over to the C and Fortran APIs), invalid if no name has this id.
+    static ParamId fromValue(std::uint32_t value);
+
+    bool valid() const { return id_ != invalid_; }
+
+    std::uint32_t value() const { return id_; }
+
+    const std::string& name() const;
+
+    bool operator==(const ParamId& other) const { return id_ == other.id_; }
+    bool operator!=(const ParamId& other) const { return id_ != other.id_; }
+    bool operator<(const ParamId& other) const { return id_ < other.id_; }
+
+    friend std::ostream& operator<<(std::ostream& os, const ParamId& id) { return os << id.name(); }
+
+private:
+    static constexpr std::uint32_t invalid_ = std::numeric_limits<std::uint32_t>::max();
+
+    explicit ParamId(std::uint32_t id) : id_{id} {}
+
+    std::uint32_t id_ = invalid_;
+};
+
+}  // namespace data
+}  // namespace plume
+
+
+template <>
+struct std::hash<plume::data::ParamId> {
+    std::size_t operator()(const plume::data::ParamId& id) const noexcept { return id.value(); }
+};
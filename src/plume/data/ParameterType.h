@@ -19,6 +19,8 @@
 #include "atlas/field/Field.h"
 #include "atlas/field/detail/FieldImpl.h"
 
+#include "plume/data/ArrayView.h"
+
 namespace plume {
 namespace data {
 
@@ -34,6 +36,7 @@ enum class ParameterType
     DOUBLE,
     STRING,
     ATLAS_FIELD,
+    ARRAY,
     INVALID
 };
 
@@ -97,6 +100,12 @@ struct DeduceParameterType<atlas::Field> {
 template <>
 struct DeduceParameterType<atlas::Field::Implementation> : DeduceParameterType<atlas::Field> {};
 
+template <>
+struct DeduceParameterType<ArrayView> {
+    static constexpr ParameterType value = ParameterType::ARRAY;
+    static constexpr const char* name    = "ARRAY";
+};
+
 /**
  * @brief Deduce the ParameterType associated with the given template type parameter.
  *
@@ -128,6 +137,8 @@ inline const char* typeToString(ParameterType t) {
             return DeduceParameterType<std::string>::name;
         case ParameterType::ATLAS_FIELD:
             return DeduceParameterType<atlas::Field>::name;
+        case ParameterType::ARRAY:
+            return DeduceParameterType<ArrayView>::name;
         default:
             throw eckit::BadValue("Parameter Type invalid or not recognised!", Here());
     }
@@ -149,6 +160,8 @@ inline ParameterType typeFromString(const char* s) {
         return DeduceParameterType<std::string>::value;
     if (std::strcmp(s, DeduceParameterType<atlas::Field>::name) == 0)
         return DeduceParameterType<atlas::Field>::value;
+    if (std::strcmp(s, DeduceParameterType<ArrayView>::name) == 0)
+        return DeduceParameterType<ArrayView>::value;
     throw eckit::BadValue(std::string("Parameter Type '") + s + "' invalid or not recognised!", Here());
 }
 
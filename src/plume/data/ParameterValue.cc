@@ -8,6 +8,9 @@
  * granted to it by virtue of its status as an intergovernmental organisation nor
  * does it submit to any jurisdiction.
  */
+#include <set>
+#include <string>
+
 #include "plume/data/ParameterValue.h"
 #include "eckit/config/LocalConfiguration.h"
 
@@ -17,15 +20,20 @@ namespace data {
 const std::string IParameterObserver::SEP_ = ";";
 
 void IParameterObserver::setSubject(std::shared_ptr<IParameterObservable> subject) {
-    auto currentSubject = subject_.lock();
-    if (currentSubject == subject) {
-        return;
+    std::shared_ptr<IParameterObservable> currentSubject;
+    {
+        std::lock_guard<std::mutex> lock(subjectMutex_);
+        currentSubject = subject_.lock();
+        if (currentSubject == subject) {
+            return;
+        }
+        subject_ = subject;
     }
 
+    // (de)registration happens outside of the lock, as the subject may call back into the observer
     if (currentSubject) {  // Detach from old subject if any
         currentSubject->detach(shared_from_this());
     }
-    subject_ = subject;
     if (subject) {  // Attach to new subject if not null
         subject->attach(shared_from_this());
     }
@@ -33,29 +41,46 @@ void IParameterObserver::setSubject(std::shared_ptr<IParameterObservable> subjec
 
 std::string IParameterObserver::deriveParamName(const std::string& source, const std::string& levtype,
                                                 const std::string& level) {
-    if (levtype != "hl" && levtype != "dummy") {  // dummy is allowed for testing
-        throw eckit::BadValue("Plume derived params only supports levtype 'hl'!", Here());
+    static const std::set<std::string> levtypes{"hl",  "ml",  "mlc", "area", "rep",  "stat",
+                                                "exc", "pt",  "der", "hist", "dummy"};  // dummy is for testing
+    if (levtypes.find(levtype) == levtypes.end()) {
+        // the supported levtypes, as accepted above
+        std::string supported;
+        for (const auto& accepted : levtypes) {
+            if (accepted != "dummy") {
+                supported += (supported.empty() ? "'" : ", '") + accepted + "'";
+            }
+        }
+        throw eckit::BadValue("Plume derived params only supports levtypes " + supported + "!", Here());
     }
     return source + SEP_ + levtype + SEP_ + level;  // default is 'name;levtype;level'
 }
 
 void IParameterObservable::notifyObservers() {
-    // clean up expired observers first & then notify alive observers
-    observers_.erase(std::remove_if(observers_.begin(), observers_.end(),
-                                    [](const std::weak_ptr<IParameterObserver>& w) { return w.expired(); }),
-                     observers_.end());
-
-    for (auto& w : observers_) {
-        if (auto obs = w.lock()) {
-            obs->onSubjectChanged();
+    // clean up expired observers first & then notify alive observers (on a copy, observers may (de)register)
+    std::vector<std::shared_ptr<IParameterObserver>> observers;
+    {
+        std::lock_guard<std::mutex> lock(observersMutex_);
+        observers_.erase(std::remove_if(observers_.begin(), observers_.end(),
+                                        [](const std::weak_ptr<IParameterObserver>& w) { return w.expired(); }),
+                         observers_.end());
+        for (auto& w : observers_) {
+            if (auto obs = w.lock()) {
+                observers.push_back(std::move(obs));
+            }
         }
     }
+
+    for (auto& obs : observers) {
+        obs->onSubjectChanged();
+    }
 }
 
 void IParameterObservable::attach(std::shared_ptr<IParameterObserver> observer) {
     // avoid duplicates & nullptrs
     if (!observer)
         return;
+    std::lock_guard<std::mutex> lock(observersMutex_);
     auto it = std::find_if(observers_.begin(), observers_.end(),
                            [&](const std::weak_ptr<IParameterObserver>& w) { return w.lock() == observer; });
 
@@ -65,6 +90,7 @@ void IParameterObservable::attach(std::shared_ptr<IParameterObserver> observer)
 }
 
 void IParameterObservable::detach(std::shared_ptr<IParameterObserver> observer) {
+    std::lock_guard<std::mutex> lock(observersMutex_);
     observers_.erase(std::remove_if(observers_.begin(), observers_.end(),
                                     [&](const std::weak_ptr<IParameterObserver>& w) { return w.lock() == observer; }),
                      observers_.end());
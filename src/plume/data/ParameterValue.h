@@ -10,7 +10,10 @@
  */
 #pragma once
 
+#include <atomic>
+#include <cstdint>
 #include <functional>
+#include <mutex>
 #include <optional>
 #include <string>
 #include <type_traits>
@@ -21,6 +24,9 @@
 #include "atlas/field/Field.h"
 #include "atlas/field/detail/FieldImpl.h"
 
+#include "plume/Metrics.h"
+#include "plume/Probes.h"
+#include "plume/Tracer.h"
 #include "plume/data/FieldProvider.h"
 #include "plume/data/ParameterType.h"
 
@@ -30,18 +36,34 @@ namespace data {
 /**
  * @class IParameterValue
  * @brief Interface for parameter values. Non-typed base class managing value update status.
+ *
+ * The updated flag and the generation (number of times the value has been marked as updated) are atomic, so they can
+ * be queried by concurrent readers while the data provider marks values as updated.
  */
 class IParameterValue {
 private:
-    bool isUpdated_ = false;
+    std::atomic<bool> isUpdated_{false};
+    std::atomic<std::uint64_t> generation_{0};
 
 public:
     virtual ~IParameterValue() = default;
 
     virtual ParameterType type() const { return ParameterType::INVALID; }
 
-    bool isUpdated() const { return isUpdated_; }
-    virtual void setUpdated(bool updated) { isUpdated_ = updated; }
+    bool isUpdated() const { return isUpdated_.load(std::memory_order_acquire); }
+
+    /// Incremented each time the value is marked as updated, readers can compare it with the last generation seen.
+    std::uint64_t generation() const { return generation_.load(std::memory_order_acquire); }
+
+    virtual void setUpdated(bool updated) {
+        if (updated) {
+            generation_.fetch_add(1, std::memory_order_acq_rel);
+        }
+        isUpdated_.store(updated, std::memory_order_release);
+    }
+
+    /// Discards a lazily produced value, its producer runs again on the next access. Nothing to do for other values.
+    virtual void invalidate() {}
 };
 
 /**
@@ -66,6 +88,18 @@ private:
     std::optional<T> ownedValue_;  ///< Only used when the object owns its value.
     T* valuePtr_;                  ///< Non-owning pointer; the pointee must outlive this object if it is not owned.
 
+    std::function<void()> producer_;       ///< Optional, fills the non-owned value on first access (lazy value).
+    mutable std::atomic<bool> produced_{false};
+    mutable std::mutex producerMutex_;     ///< Serialises concurrent first accesses of a lazy value.
+
+    void produce() const {
+        std::lock_guard<std::mutex> lock(producerMutex_);
+        if (!produced_.load(std::memory_order_relaxed)) {
+            producer_();
+            produced_.store(true, std::memory_order_release);
+        }
+    }
+
 public:
     ~ParameterValueTyped() = default;
 
@@ -102,11 +136,34 @@ public:
     bool owns() const { return ownsValue_; }
 
     /**
-     * @brief Returns a read-only reference to the parameter value.
+     * @brief Makes a non-owning parameter lazy: the producer fills the referenced value on first access, and again
+     *        on the first access following `invalidate()`.
+     *
+     * @note The producer runs on the thread accessing the value, at most once between invalidations. Only `get()`
+     *       runs it: references obtained before an invalidation are not refreshed.
+     */
+    void setProducer(std::function<void()> producer) {
+        ASSERT_MSG(!ownsValue_, "Only provided (non-owning) parameters can be produced lazily");
+        producer_ = std::move(producer);
+        produced_.store(false, std::memory_order_release);
+    }
+
+    bool lazy() const { return static_cast<bool>(producer_); }
+
+    /// Discards the produced value, if lazy.
+    void invalidate() { produced_.store(false, std::memory_order_release); }
+
+    /**
+     * @brief Returns a read-only reference to the parameter value, producing it first if lazy.
      *
      * @warning In non-owning mode, the referenced value must still be alive.
      */
-    const T& get() const { return *valuePtr_; }
+    const T& get() const {
+        if (producer_ && !produced_.load(std::memory_order_acquire)) {
+            produce();
+        }
+        return *valuePtr_;
+    }
 
     /**
      * @brief Sets the parameter value.
@@ -129,6 +186,19 @@ public:
         ASSERT(ownsValue_);
         return *valuePtr_;
     }
+
+    /**
+     * @brief Returns the Atlas field provided by the model, producing it first if lazy.
+     *
+     * @pre This instance must not own its value. Only meant for update strategies deriving fields that wrap the
+     *      memory of the model field (e.g. level views), plugins read the values through `get()`.
+     */
+    template <typename U = T, typename = std::enable_if_t<std::is_base_of_v<atlas::Field, U>>>
+    T& getProvidedField() {
+        ASSERT(!ownsValue_);
+        get();
+        return *valuePtr_;
+    }
 };
 
 class IParameterObservable;  // forward declaration
@@ -145,6 +215,7 @@ class IParameterObserver : public std::enable_shared_from_this<IParameterObserve
 private:
     static const std::string SEP_;
     std::weak_ptr<IParameterObservable> subject_;  ///< weak reference to observed parameter to avoid cyclic ownership.
+    mutable std::mutex subjectMutex_;             ///< guards subject_
 
     /// Optional, a parameter actively observing should have a strategy for reacting to changes in the subject.
     std::unique_ptr<field_provider::UpdateStrategy> updateStrategy_;
@@ -153,7 +224,10 @@ public:
     /// The active observer lazily detaches oneself from its subject when it notifies or destroys, nothing to do here.
     virtual ~IParameterObserver() = default;
 
-    virtual bool observes() { return !subject_.expired(); }
+    virtual bool observes() {
+        std::lock_guard<std::mutex> lock(subjectMutex_);
+        return !subject_.expired();
+    }
     virtual void setSubject(std::shared_ptr<IParameterObservable> subject);
     virtual void setUpdateStrategy(std::unique_ptr<field_provider::UpdateStrategy> strategy) {
         updateStrategy_ = std::move(strategy);
@@ -185,6 +259,7 @@ class IParameterObservable {
 private:
     /// Vector of weak references to observers to dispatch notifications to to avoid cyclic ownership.
     std::vector<std::weak_ptr<IParameterObserver>> observers_;
+    std::mutex observersMutex_;  ///< guards observers_, notifications are dispatched outside of the lock
 
 protected:
     /// Calls `onSubjectChanged()` on all non-expired observers.
@@ -198,15 +273,17 @@ public:
      * list of observers.
      */
     virtual ~IParameterObservable() {
-        observers_.erase(std::remove_if(observers_.begin(), observers_.end(), [](auto& w) { return w.expired(); }),
-                         observers_.end());
+        std::vector<std::weak_ptr<IParameterObserver>> observers;
+        {
+            std::lock_guard<std::mutex> lock(observersMutex_);
+            observers.swap(observers_);
+        }
 
-        for (auto& wobs : observers_) {
+        for (auto& wobs : observers) {
             if (auto obs = wobs.lock()) {
                 obs->setSubject(nullptr);
             }
         }
-        observers_.clear();
     }
 
     /// Adds observer to the list of current observers if it is not already listening.
@@ -240,6 +317,8 @@ public:
 
     ParameterType type() const override { return ParameterValueTyped<T>::type(); }
 
+    void invalidate() override { ParameterValueTyped<T>::invalidate(); }
+
     /**
      * @brief Sets the updated flag and triggers notifications if applicable.
      *
@@ -263,7 +342,12 @@ public:
     void onSubjectChanged() {  // reactions are runtime strategy-based
         if constexpr (std::is_same_v<Role, IParameterObserver>) {
             ASSERT_MSG(this->Role::getStrategy() != nullptr, "Plume parameter missing update strategy");
-            this->Role::getStrategy()->update();
+            auto& strategy = *this->Role::getStrategy();
+            Tracer::Scope trace("strategy", typeid(strategy));
+            Metrics::Timer timer(Metrics::strategyUpdateSeconds, typeid(strategy));
+            PLUME_PROBE(strategy__begin, typeid(strategy).name());
+            strategy.update();
+            PLUME_PROBE(strategy__end, typeid(strategy).name());
         }
     }
 };
@@ -0,0 +1,358 @@
+/*
+ * (C) Copyright 2025- ECMWF.
+ *
+ * This software is licensed under the terms of the Apache Licence Version 2.0
+ * which can be obtained at http://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * In applying this licence, ECMWF does not waive the privileges and immunities
+ * granted to it by virtue of its status as an intergovernmental organisation nor
+ * does it submit to any jurisdiction.
+ */
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+#include "eckit/exception/Exceptions.h"
+
+#include "atlas/array.h"
+#include "atlas/functionspace/StructuredColumns.h"
+
+#include "plume/data/FieldProvider.h"
+#include "plume/data/Reductions.h"
+
+
+namespace plume {
+namespace data {
+
+namespace {
+
+atlas::idx_t levelsOf(const atlas::Field& field) {
+    return field.rank() == 2 ? field.shape(1) : 1;
+}
+
+}  // namespace
+
+
+Statistic statisticFromString(const std::string& name) {
+    if (name == "sum") {
+        return Statistic::Sum;
+    }
+    if (name == "mean") {
+        return Statistic::Mean;
+    }
+    if (name == "min") {
+        return Statistic::Min;
+    }
+    if (name == "max") {
+        return Statistic::Max;
+    }
+    throw eckit::BadValue("Invalid statistic '" + name + "' (expected sum, mean, min or max)", Here());
+}
+
+
+Reductions::Reductions(const eckit::mpi::Comm& comm) : comm_{comm} {}
+
+
+Reductions::Handle Reductions::add(const atlas::Field& field, Statistic statistic) {
+    Request request{};
+    request.field     = field;
+    request.kind      = Kind::Statistic;
+    request.statistic = statistic;
+    return addRequest(std::move(request));
+}
+
+
+Reductions::Handle Reductions::addHistogram(const atlas::Field& field, double min, double max, std::size_t bins) {
+    if (!(min < max) || bins == 0) {
+        throw eckit::BadValue("Invalid histogram of field '" + field.name() + "' (expected min < max and bins > 0)",
+                              Here());
+    }
+    Request request{};
+    request.field = field;
+    request.kind  = Kind::Histogram;
+    request.min   = min;
+    request.max   = max;
+    request.bins  = bins;
+    return addRequest(std::move(request));
+}
+
+
+Reductions::Handle Reductions::addZonalMean(const atlas::Field& field) {
+    atlas::functionspace::StructuredColumns fs(field.functionspace());
+    if (!fs.valid()) {
+        throw eckit::BadValue("Zonal means of field '" + field.name() + "' require a field on StructuredColumns",
+                              Here());
+    }
+    Request request{};
+    request.field = field;
+    request.kind  = Kind::ZonalMean;
+    request.rows  = static_cast<std::size_t>(fs.grid().ny());
+    return addRequest(std::move(request));
+}
+
+
+Reductions::Handle Reductions::addSum(std::vector<double> values) {
+    Request request{};
+    request.kind   = Kind::Sum;
+    request.values = std::move(values);
+    return addRequest(std::move(request));
+}
+
+
+Reductions::Handle Reductions::addRequest(Request request) {
+    const auto& field = request.field;
+    if (request.kind != Kind::Sum) {
+        if (!field || field.rank() < 1 || field.rank() > 2) {
+            throw eckit::BadValue("Reductions require (npoints[, nlev]) fields", Here());
+        }
+        if (field.datatype() != atlas::array::DataType::real32() &&
+            field.datatype() != atlas::array::DataType::real64()) {
+            throw eckit::BadValue("Unsupported value type of field '" + field.name() + "' (expected float or double)",
+                                  Here());
+        }
+    }
+
+    // reserve the partial results of the request in the reduction buffers
+    const auto nlev   = request.kind != Kind::Sum ? static_cast<std::size_t>(levelsOf(field)) : 0;
+    request.sumOffset = sums_.size();
+    request.maxOffset = maxs_.size();
+    std::size_t nsums = 0;
+    std::size_t nmaxs = 0;
+    switch (request.kind) {
+        case Kind::Statistic:
+            if (request.statistic == Statistic::Min || request.statistic == Statistic::Max) {
+                nmaxs = nlev;
+            }
+            else {
+                nsums = request.statistic == Statistic::Mean ? nlev + 1 : nlev;  // (with the number of points)
+            }
+            break;
+        case Kind::Histogram:
+            nsums = request.bins * nlev;
+            break;
+        case Kind::ZonalMean:
+            nsums = request.rows * nlev + request.rows;  // (with the number of points per row)
+            break;
+        case Kind::Sum:
+            nsums = request.values.size();
+            break;
+    }
+    sums_.resize(sums_.size() + nsums);
+    maxs_.resize(maxs_.size() + nmaxs);
+
+    requests_.push_back(std::move(request));
+    computed_ = false;
+    return requests_.size() - 1;
+}
+
+
+void Reductions::compute() {
+
+    std::fill(sums_.begin(), sums_.end(), 0.);
+    std::fill(maxs_.begin(), maxs_.end(), -std::numeric_limits<double>::infinity());
+
+    // one pass per field, for all the requests on that field
+    std::vector<bool> done(requests_.size(), false);
+    for (std::size_t r = 0; r < requests_.size(); ++r) {
+        if (done[r]) {
+            continue;
+        }
+        if (requests_[r].kind == Kind::Sum) {
+            std::copy(requests_[r].values.begin(), requests_[r].values.end(), sums_.begin() + requests_[r].sumOffset);
+            done[r] = true;
+            continue;
+        }
+        std::vector<Request*> group;
+        for (std::size_t s = r; s < requests_.size(); ++s) {
+            if (!done[s] && requests_[s].kind != Kind::Sum && requests_[s].field.get() == requests_[r].field.get()) {
+                group.push_back(&requests_[s]);
+                done[s] = true;
+            }
+        }
+        accumulate(group);
+    }
+
+    // all the partial results are combined at once
+    std::vector<eckit::mpi::Request> pending;
+    if (!sums_.empty()) {
+        pending.push_back(comm_.iAllReduceInPlace(sums_.data(), sums_.size(), eckit::mpi::sum()));
+    }
+    if (!maxs_.empty()) {
+        pending.push_back(comm_.iAllReduceInPlace(maxs_.data(), maxs_.size(), eckit::mpi::max()));
+    }
+    comm_.waitAll(pending);
+
+    for (auto& request : requests_) {
+        finalise(request);
+    }
+    computed_ = true;
+}
+
+
+void Reductions::accumulate(const std::vector<Request*>& requests) {
+    if (requests.front()->field.datatype() == atlas::array::DataType::real64()) {
+        accumulate<double>(requests);
+    }
+    else {
+        accumulate<float>(requests);
+    }
+}
+
+
+template <typename T>
+void Reductions::accumulate(const std::vector<Request*>& requests) {
+    const auto& field          = requests.front()->field;
+    const atlas::idx_t npoints = field.shape(0);
+    const atlas::idx_t nlev    = levelsOf(field);
+    const auto owned           = field_provider::ownedPoints(field.functionspace(), npoints);
+
+    std::vector<Request*> histograms;
+    std::vector<Request*> zonalMeans;
+    for (auto* request : requests) {
+        if (request->kind == Kind::Histogram) {
+            histograms.push_back(request);
+        }
+        else if (request->kind == Kind::ZonalMean) {
+            zonalMeans.push_back(request);
+        }
+    }
+
+    // latitude row of each point (atlas indices start at 1)
+    std::vector<atlas::idx_t> rows;
+    if (!zonalMeans.empty()) {
+        atlas::functionspace::StructuredColumns fs(field.functionspace());
+        auto indexJ = atlas::array::make_view<atlas::idx_t, 1>(fs.index_j());
+        rows.resize(npoints);
+        for (atlas::idx_t i = 0; i < npoints; ++i) {
+            rows[i] = indexJ(i) - 1;
+        }
+    }
+
+    std::vector<double> sum(nlev, 0.);
+    std::vector<double> min(nlev, std::numeric_limits<double>::infinity());
+    std::vector<double> max(nlev, -std::numeric_limits<double>::infinity());
+    double count = 0.;
+
+    auto pass = [&](auto&& value) {
+        for (atlas::idx_t i = 0; i < npoints; ++i) {
+            if (!owned[i]) {
+                continue;
+            }
+            count += 1.;
+            for (atlas::idx_t k = 0; k < nlev; ++k) {
+                const double x = value(i, k);
+                sum[k] += x;
+                min[k] = std::min(min[k], x);
+                max[k] = std::max(max[k], x);
+                for (auto* histogram : histograms) {
+                    if (x >= histogram->min && x < histogram->max) {
+                        auto bin = static_cast<std::size_t>((x - histogram->min) / (histogram->max - histogram->min) *
+                                                            histogram->bins);
+                        bin      = std::min(bin, histogram->bins - 1);
+                        sums_[histogram->sumOffset + k * histogram->bins + bin] += 1.;
+                    }
+                }
+                for (auto* zonalMean : zonalMeans) {
+                    sums_[zonalMean->sumOffset + rows[i] * nlev + k] += x;
+                }
+            }
+            for (auto* zonalMean : zonalMeans) {
+                sums_[zonalMean->sumOffset + zonalMean->rows * nlev + rows[i]] += 1.;
+            }
+        }
+    };
+
+    if (field.rank() == 1) {
+        auto view = atlas::array::make_view<T, 1>(field);
+        pass([&view](atlas::idx_t i, atlas::idx_t) { return static_cast<double>(view(i)); });
+    }
+    else {
+        auto view = atlas::array::make_view<T, 2>(field);
+        pass([&view](atlas::idx_t i, atlas::idx_t k) { return static_cast<double>(view(i, k)); });
+    }
+
+    for (auto* request : requests) {
+        if (request->kind != Kind::Statistic) {
+            continue;
+        }
+        for (atlas::idx_t k = 0; k < nlev; ++k) {
+            switch (request->statistic) {
+                case Statistic::Sum:
+                case Statistic::Mean:
+                    sums_[request->sumOffset + k] = sum[k];
+                    break;
+                case Statistic::Min:
+                    maxs_[request->maxOffset + k] = -min[k];
+                    break;
+                case Statistic::Max:
+                    maxs_[request->maxOffset + k] = max[k];
+                    break;
+            }
+        }
+        if (request->statistic == Statistic::Mean) {
+            sums_[request->sumOffset + nlev] = count;
+        }
+    }
+}
+
+
+void Reductions::finalise(Request& request) const {
+    const auto nlev = request.kind != Kind::Sum ? static_cast<std::size_t>(levelsOf(request.field)) : 0;
+    auto& result    = request.result;
+
+    switch (request.kind) {
+        case Kind::Statistic:
+            result.resize(nlev);
+            for (std::size_t k = 0; k < nlev; ++k) {
+                switch (request.statistic) {
+                    case Statistic::Sum:
+                        result[k] = sums_[request.sumOffset + k];
+                        break;
+                    case Statistic::Mean:
+                        result[k] = sums_[request.sumOffset + k] / sums_[request.sumOffset + nlev];
+                        break;
+                    case Statistic::Min:
+                        result[k] = -maxs_[request.maxOffset + k];
+                        break;
+                    case Statistic::Max:
+                        result[k] = maxs_[request.maxOffset + k];
+                        break;
+                }
+            }
+            break;
+        case Kind::Histogram:
+            result.assign(sums_.begin() + request.sumOffset,
+                          sums_.begin() + request.sumOffset + request.bins * nlev);
+            break;
+        case Kind::ZonalMean:
+            result.resize(request.rows * nlev);
+            for (std::size_t row = 0; row < request.rows; ++row) {
+                const double count = sums_[request.sumOffset + request.rows * nlev + row];
+                for (std::size_t k = 0; k < nlev; ++k) {
+                    result[row * nlev + k] = sums_[request.sumOffset + row * nlev + k] / count;
+                }
+            }
+            break;
+        case Kind::Sum:
+            result.assign(sums_.begin() + request.sumOffset, sums_.begin() + request.sumOffset + request.values.size());
+            break;
+    }
+}
+
+
+const std::vector<double>& Reductions::result(Handle handle) const {
+    ASSERT_MSG(handle < requests_.size(), "Reductions: unknown request");
+    ASSERT_MSG(computed_, "Reductions: statistics have not been computed");
+    return requests_[handle].result;
+}
+
+
+void Reductions::clear() {
+    requests_.clear();
+    sums_.clear();
+    maxs_.clear();
+    computed_ = false;
+}
+
+}  // namespace data
+}  // namespace plume
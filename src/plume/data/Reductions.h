@@ -0,0 +1,150 @@
+/*
+ * (C) Copyright 2025- ECMWF.
+ *
+ * This software is licensed under the terms of the Apache Licence Version 2.0
+ * which can be obtained at http://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * In applying this licence, ECMWF does not waive the privileges and immunities
+ * granted to it by virtue of its status as an intergovernmental organisation nor
+ * does it submit to any jurisdiction.
+ */
+#pragma once
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+#include "eckit/memory/NonCopyable.h"
+#include "eckit/mpi/Comm.h"
+
+#include "atlas/field/Field.h"
+
+
+namespace plume {
+namespace data {
+
+enum class Statistic
+{
+    Sum,
+    Mean,
+    Min,
+    Max
+};
+
+/// @throws eckit::BadValue If the name is not one of "sum", "mean", "min" or "max".
+Statistic statisticFromString(const std::string& name);
+
+/**
+ * @brief Batched global statistics of distributed fields.
+ *
+ * Statistics are requested first, then computed together by a collective call to compute(): each field is read in a
+ * single pass computing all of its requested statistics, and the partial results of all the requests are combined by
+ * one sum and one max non-blocking reductions, in flight together (minimums are reduced as maximums of opposites).
+ *
+ * Statistics are per level of (npoints[, nlev]) fields, over the points owned by each partition (ghost points are
+ * excluded when the function space defines them). Means are not area-weighted. Sums of values computed by the caller
+ * share the same reduction.
+ *
+ * @note All the partitions of the communicator must request the same statistics, in the same order.
+ */
+class Reductions : private eckit::NonCopyable {
+
+public:
+
+    using Handle = std::size_t;
+
+    explicit Reductions(const eckit::mpi::Comm& comm = eckit::mpi::comm());
+
+    /// Requests a statistic of a field, the result has one value per level.
+    Handle add(const atlas::Field& field, Statistic statistic);
+
+    /**
+     * @brief Requests a histogram of a field over [min, max) in bins of equal width (values out of range are ignored)
+     *
+     * The result holds the counts of each level in turn, i.e. `result[level * bins + bin]`.
+     */
+    Handle addHistogram(const atlas::Field& field, double min, double max, std::size_t bins);
+
+    /**
+     * @brief Requests the zonal means of a field defined on StructuredColumns, i.e. its mean along each latitude row
+     *
+     * The result holds the levels of each row in turn, i.e. `result[row * nlev + level]` (rows from north to south).
+     *
+     * @throws eckit::BadValue If the field is not defined on StructuredColumns.
+     */
+    Handle addZonalMean(const atlas::Field& field);
+
+    /**
+     * @brief Requests the sums over the partitions of values computed by the caller, e.g. counts, or values known by a
+     *        single partition (zero elsewhere)
+     *
+     * The result has the size of the values.
+     */
+    Handle addSum(std::vector<double> values);
+
+    /// Computes all the requested statistics (collective).
+    void compute();
+
+    /// Result of a request (available after compute).
+    const std::vector<double>& result(Handle handle) const;
+
+    /// Removes all the requests (the communicator is kept).
+    void clear();
+
+    std::size_t size() const { return requests_.size(); }
+
+private:
+
+    enum class Kind
+    {
+        Statistic,
+        Histogram,
+        ZonalMean,
+        Sum
+    };
+
+    struct Request {
+        atlas::Field field;
+        Kind kind;
+        Statistic statistic;
+
+        // histograms
+        double min;
+        double max;
+        std::size_t bins;
+
+        // zonal means (number of latitude rows)
+        std::size_t rows;
+
+        // sums of values of the caller
+        std::vector<double> values;
+
+        // offsets of the partial results in the reduction buffers
+        std::size_t sumOffset;
+        std::size_t maxOffset;
+
+        std::vector<double> result;
+    };
+
+    Handle addRequest(Request request);
+
+    void accumulate(const std::vector<Request*>& requests);
+
+    template <typename T>
+    void accumulate(const std::vector<Request*>& requests);
+
+    void finalise(Request& request) const;
+
+    const eckit::mpi::Comm& comm_;
+
+    std::vector<Request> requests_;
+
+    std::vector<double> sums_;
+
+    std::vector<double> maxs_;
+
+    bool computed_ = false;
+};
+
+}  // namespace data
+}  // namespace plume
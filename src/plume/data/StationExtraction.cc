@@ -0,0 +1,219 @@
+/*
+ * (C) Copyright 2025- ECMWF.
+ *
+ * This software is licensed under the terms of the Apache Licence Version 2.0
+ * which can be obtained at http://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * In applying this licence, ECMWF does not waive the privileges and immunities
+ * granted to it by virtue of its status as an intergovernmental organisation nor
+ * does it submit to any jurisdiction.
+ */
+#include <algorithm>
+#include <cmath>
+#include <sstream>
+
+#include "eckit/exception/Exceptions.h"
+
+#include "atlas/array.h"
+#include "atlas/util/KDTree.h"
+#include "atlas/util/Point.h"
+
+#include "plume/Metrics.h"
+#include "plume/data/FieldProvider.h"
+#include "plume/data/StationExtraction.h"
+#include "plume/data/StrategyContext.h"
+
+
+namespace plume {
+namespace data {
+
+std::vector<Station> parseStations(const std::string& stations) {
+    std::vector<Station> parsed;
+    std::stringstream ss(stations);
+    std::string item;
+    while (std::getline(ss, item, ',')) {
+        auto slash = item.find('/');
+        bool valid = slash != std::string::npos;
+        Station station{};
+        if (valid) {
+            try {
+                std::size_t lonEnd = 0;
+                std::size_t latEnd = 0;
+                station.lon        = std::stod(item.substr(0, slash), &lonEnd);
+                station.lat        = std::stod(item.substr(slash + 1), &latEnd);
+                valid = lonEnd == slash && latEnd == item.size() - slash - 1 && std::abs(station.lat) <= 90.;
+            }
+            catch (const std::exception&) {
+                valid = false;
+            }
+        }
+        if (!valid) {
+            throw eckit::BadValue("Invalid stations '" + stations + "' (expected lon/lat,lon/lat,...)", Here());
+        }
+        parsed.push_back(station);
+    }
+    if (parsed.empty()) {
+        throw eckit::BadValue("Empty list of stations", Here());
+    }
+    return parsed;
+}
+
+
+StationExtraction::StationExtraction(const atlas::FunctionSpace& functionspace, std::vector<Station> stations,
+                                     Method method, const eckit::mpi::Comm& comm) :
+    comm_{comm}, stations_{std::move(stations)}, owners_(stations_.size(), 0), stencils_(stations_.size()) {
+
+    if (!functionspace) {
+        throw eckit::BadValue("Station extraction requires a function space", Here());
+    }
+
+    // index the points owned by this partition
+    auto lonlat = atlas::array::make_view<double, 2>(functionspace.lonlat());
+    npoints_    = lonlat.shape(0);
+    auto owned  = field_provider::ownedPoints(functionspace, npoints_);
+
+    atlas::util::IndexKDTree tree;
+    tree.reserve(npoints_);
+    for (atlas::idx_t i = 0; i < npoints_; ++i) {
+        if (owned[i]) {
+            tree.insert(atlas::PointLonLat(lonlat(i, 0), lonlat(i, 1)), i);
+        }
+    }
+    tree.build();
+
+    // each station belongs to the partition with the nearest point (the lowest rank on ties)
+    const std::size_t k = method == Method::Nearest ? 1 : 4;
+    std::vector<double> distances(stations_.size(), std::numeric_limits<double>::max());
+    std::vector<atlas::util::IndexKDTree::ValueList> neighbours(stations_.size());
+    for (std::size_t s = 0; s < stations_.size(); ++s) {
+        if (tree.size() > 0) {
+            neighbours[s] = tree.closestPoints(atlas::PointLonLat(stations_[s].lon, stations_[s].lat), k);
+            distances[s]  = neighbours[s].front().distance();
+        }
+    }
+
+    std::vector<double> nearest = distances;
+    comm_.allReduceInPlace(nearest.data(), nearest.size(), eckit::mpi::min());
+
+    std::vector<double> ranks(stations_.size());
+    for (std::size_t s = 0; s < stations_.size(); ++s) {
+        ranks[s] = distances[s] == nearest[s] ? comm_.rank() : comm_.size();
+    }
+    comm_.allReduceInPlace(ranks.data(), ranks.size(), eckit::mpi::min());
+
+    for (std::size_t s = 0; s < stations_.size(); ++s) {
+        owners_[s] = static_cast<std::size_t>(ranks[s]);
+        if (owners_[s] != comm_.rank()) {
+            continue;
+        }
+
+        auto& stencil = stencils_[s];
+        for (const auto& neighbour : neighbours[s]) {
+            stencil.points.push_back(neighbour.payload());
+            stencil.weights.push_back(1. / std::max(neighbour.distance(), 1e-6));  // (meters, exact match dominates)
+        }
+        double total = 0.;
+        for (auto weight : stencil.weights) {
+            total += weight;
+        }
+        for (auto& weight : stencil.weights) {
+            weight /= total;
+        }
+    }
+}
+
+
+std::shared_ptr<const StationExtraction> StationExtraction::cached(StrategyContext& context,
+                                                                   const atlas::FunctionSpace& functionspace,
+                                                                   const std::string& stations, Method method) {
+    if (!functionspace) {
+        throw eckit::BadValue("Station extraction requires a function space", Here());
+    }
+
+    const std::string key = stations + (method == Method::Nearest ? ";nearest" : ";inverse-distance");
+    return context.cached<StationExtraction>(functionspace, key, [&]() {
+        return std::make_shared<const StationExtraction>(functionspace, parseStations(stations), method,
+                                                         context.comm());
+    });
+}
+
+
+std::vector<double> StationExtraction::extract(const std::vector<atlas::Field>& fields, std::size_t root) const {
+
+    auto values = localValues(fields);
+
+    // each value comes from a single partition
+    if (root == allRanks) {
+        comm_.allReduceInPlace(values.data(), values.size(), eckit::mpi::sum());
+    }
+    else {
+        comm_.reduceInPlace(values.data(), values.size(), eckit::mpi::sum(), root);
+        if (comm_.rank() != root) {
+            values.clear();
+        }
+    }
+    return values;
+}
+
+
+std::vector<double> StationExtraction::localValues(const std::vector<atlas::Field>& fields) const {
+
+    std::size_t nvalues = 0;
+    for (const auto& field : fields) {
+        if (field.rank() < 1 || field.rank() > 2 || field.shape(0) != npoints_) {
+            throw eckit::BadValue("Station extraction of field '" + field.name() +
+                                      "' requires a (npoints[, nlev]) field on the function space of the stations",
+                                  Here());
+        }
+        nvalues += field.rank() == 2 ? field.shape(1) : 1;
+    }
+
+    // values of the stations owned by this partition, zero elsewhere
+    std::vector<double> values(stations_.size() * nvalues, 0.);
+    std::size_t offset = 0;
+    for (const auto& field : fields) {
+        if (field.datatype() == atlas::array::DataType::real64()) {
+            extract<double>(field, nvalues, offset, values);
+        }
+        else if (field.datatype() == atlas::array::DataType::real32()) {
+            extract<float>(field, nvalues, offset, values);
+        }
+        else {
+            throw eckit::BadValue("Unsupported value type of field '" + field.name() + "' (expected float or double)",
+                                  Here());
+        }
+        offset += field.rank() == 2 ? field.shape(1) : 1;
+    }
+    Metrics::instance().addBytesCopied(values.size() * sizeof(double));
+    return values;
+}
+
+
+template <typename T>
+void StationExtraction::extract(const atlas::Field& field, std::size_t nvalues, std::size_t offset,
+                                std::vector<double>& values) const {
+    const atlas::idx_t nlev = field.rank() == 2 ? field.shape(1) : 1;
+
+    auto pass = [&](auto&& value) {
+        for (std::size_t s = 0; s < stations_.size(); ++s) {
+            const auto& stencil = stencils_[s];
+            for (std::size_t p = 0; p < stencil.points.size(); ++p) {
+                for (atlas::idx_t k = 0; k < nlev; ++k) {
+                    values[s * nvalues + offset + k] += stencil.weights[p] * value(stencil.points[p], k);
+                }
+            }
+        }
+    };
+
+    if (field.rank() == 1) {
+        auto view = atlas::array::make_view<T, 1>(field);
+        pass([&view](atlas::idx_t i, atlas::idx_t) { return static_cast<double>(view(i)); });
+    }
+    else {
+        auto view = atlas::array::make_view<T, 2>(field);
+        pass([&view](atlas::idx_t i, atlas::idx_t k) { return static_cast<double>(view(i, k)); });
+    }
+}
+
+}  // namespace data
+}  // namespace plume
@@ -0,0 +1,130 @@
+/*
+ * (C) Copyright 2025- ECMWF.
+ *
+ * This software is licensed under the terms of the Apache Licence Version 2.0
+ * which can be obtained at http://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * In applying this licence, ECMWF does not waive the privileges and immunities
+ * granted to it by virtue of its status as an intergovernmental organisation nor
+ * does it submit to any jurisdiction.
+ */
+#pragma once
+
+#include <cstddef>
+#include <limits>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "eckit/memory/NonCopyable.h"
+#include "eckit/mpi/Comm.h"
+
+#include "atlas/field/Field.h"
+#include "atlas/functionspace/FunctionSpace.h"
+
+
+namespace plume {
+namespace data {
+
+class StrategyContext;
+
+struct Station {
+    double lon;
+    double lat;
+};
+
+/// Parses a list of stations "lon/lat,lon/lat,..." in degrees, e.g. "-0.12/51.5,2.35/48.86".
+/// @throws eckit::BadValue If the list is malformed or empty.
+std::vector<Station> parseStations(const std::string& stations);
+
+/**
+ * @brief Values of distributed fields at a list of stations.
+ *
+ * At construction (collective), the points of each partition are indexed by a k-d tree, and each station is assigned
+ * to the partition owning its nearest point, with the indices and weights of its stencil on that partition:
+ * - Nearest : the nearest point
+ * - InverseDistance : the 4 nearest points of the owning partition, weighted by their inverse distance
+ *
+ * Extractions then read the stencils of all the fields and levels in one pass, and combine the values of all the
+ * partitions in a single collective.
+ *
+ * @note All the partitions of the communicator must extract the same fields, in the same order.
+ */
+class StationExtraction : private eckit::NonCopyable {
+
+public:
+
+    enum class Method
+    {
+        Nearest,
+        InverseDistance
+    };
+
+    /// Extraction results on all partitions
+    static constexpr std::size_t allRanks = std::numeric_limits<std::size_t>::max();
+
+    StationExtraction(const atlas::FunctionSpace& functionspace, std::vector<Station> stations,
+                      Method method = Method::Nearest, const eckit::mpi::Comm& comm = eckit::mpi::comm());
+
+    /**
+     * @brief Extraction shared by all the users of the same function space, stations and method in a context (built on
+     *        first use, on the communicator of the context)
+     *
+     * @note Collective on first use.
+     */
+    static std::shared_ptr<const StationExtraction> cached(StrategyContext& context,
+                                                           const atlas::FunctionSpace& functionspace,
+                                                           const std::string& stations,
+                                                           Method method = Method::Nearest);
+
+    std::size_t size() const { return stations_.size(); }
+
+    const std::vector<Station>& stations() const { return stations_; }
+
+    /// Partition owning a station.
+    std::size_t owner(std::size_t station) const { return owners_[station]; }
+
+    /**
+     * @brief Values of (npoints[, nlev]) fields at the stations (collective)
+     *
+     * The values of each station are the levels of each field in turn, i.e. `result[station * nvalues + value]` where
+     * nvalues is the total number of levels of the fields.
+     *
+     * @param fields Fields defined on the function space of the extraction.
+     * @param root The partition receiving the values (all partitions by default, the result is empty on others).
+     */
+    std::vector<double> extract(const std::vector<atlas::Field>& fields, std::size_t root = allRanks) const;
+
+    /**
+     * @brief Contribution of this partition to the values of the fields at the stations, laid out as by `extract`
+     *
+     * The values of the stations owned by this partition are set, the others are zero: the sum over the partitions of
+     * the communicator gives the values, e.g. in batched reductions (see Reductions::addSum).
+     */
+    std::vector<double> localValues(const std::vector<atlas::Field>& fields) const;
+
+private:
+
+    struct Stencil {
+        std::vector<atlas::idx_t> points;
+        std::vector<double> weights;
+    };
+
+    template <typename T>
+    void extract(const atlas::Field& field, std::size_t nvalues, std::size_t offset, std::vector<double>& values) const;
+
+    const eckit::mpi::Comm& comm_;
+
+    std::vector<Station> stations_;
+
+    std::vector<std::size_t> owners_;
+
+    // stencils of the stations owned by this partition (empty otherwise)
+    std::vector<Stencil> stencils_;
+
+    // number of points of the function space
+    atlas::idx_t npoints_;
+};
+
+}  // namespace data
+}  // namespace plume
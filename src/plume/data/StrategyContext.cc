@@ -0,0 +1,148 @@
+/*
+ * (C) Copyright 2025- ECMWF.
+ *
+ * This software is licensed under the terms of the Apache Licence Version 2.0
+ * which can be obtained at http://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * In applying this licence, ECMWF does not waive the privileges and immunities
+ * granted to it by virtue of its status as an intergovernmental organisation nor
+ * does it submit to any jurisdiction.
+ */
+#include <algorithm>
+
+#include "eckit/exception/Exceptions.h"
+
+#include "plume/data/HorizontalDerivatives.h"
+#include "plume/data/StrategyContext.h"
+
+
+namespace plume {
+namespace data {
+
+namespace {
+
+thread_local std::shared_ptr<StrategyContext> currentContext_;
+
+}  // namespace
+
+
+std::shared_ptr<StrategyContext> StrategyContext::current() {
+    return currentContext_ ? currentContext_ : std::make_shared<StrategyContext>();
+}
+
+
+StrategyContext::Scope::Scope(std::shared_ptr<StrategyContext> context) : previous_{std::move(currentContext_)} {
+    currentContext_ = std::move(context);
+}
+
+
+StrategyContext::Scope::~Scope() {
+    currentContext_ = std::move(previous_);
+}
+
+
+StrategyContext::Step::Step(StrategyContext& context) :
+    context_{context}, ended_{false}, install_{context.tracer_.get()} {
+    ASSERT_MSG(!context_.inStep_, "Strategy context: steps cannot be nested");
+    context_.inStep_ = true;
+}
+
+
+StrategyContext::Step::~Step() {
+    if (!ended_) {
+        context_.discard();
+    }
+    context_.inStep_ = false;
+}
+
+
+void StrategyContext::Step::end() {
+    ASSERT(!ended_);
+    ended_ = true;
+    context_.inStep_ = false;
+    context_.flush();
+}
+
+
+void StrategyContext::setComm(const eckit::mpi::Comm& comm) {
+    if (&comm == comm_) {
+        commSet_ = true;
+        return;
+    }
+    if (commSet_) {
+        throw eckit::UserError("Strategy context: the model data is already used on another communicator", Here());
+    }
+    if (inStep_) {
+        throw eckit::UserError("Strategy context: the communicator cannot be changed during a step", Here());
+    }
+    comm_       = &comm;
+    commSet_    = true;
+    reductions_ = std::make_unique<Reductions>(comm);
+}
+
+
+void StrategyContext::addHaloExchange(const std::shared_ptr<const HorizontalDerivatives>& derivatives,
+                                      const std::vector<atlas::Field>& copies) {
+    auto it = std::find_if(haloExchanges_.begin(), haloExchanges_.end(),
+                           [&](const auto& exchange) { return exchange.first == derivatives; });
+    if (it == haloExchanges_.end()) {
+        it = haloExchanges_.emplace(haloExchanges_.end(), derivatives, atlas::FieldSet());
+    }
+    for (const auto& copy : copies) {
+        it->second.add(copy);
+    }
+}
+
+
+void StrategyContext::defer(std::function<void()> update) {
+    deferred_.push_back(std::move(update));
+    if (!inStep_) {
+        flush();
+    }
+}
+
+
+void StrategyContext::flush() {
+    std::vector<std::function<void()>> deferred;
+    deferred.swap(deferred_);
+    std::vector<std::pair<std::shared_ptr<const HorizontalDerivatives>, atlas::FieldSet>> haloExchanges;
+    haloExchanges.swap(haloExchanges_);
+    try {
+        for (const auto& [derivatives, copies] : haloExchanges) {
+            derivatives->exchange(copies);
+        }
+        if (reductions_->size() > 0) {
+            reductions_->compute();
+        }
+        for (const auto& update : deferred) {
+            update();
+        }
+    }
+    catch (...) {
+        reductions_->clear();
+        throw;
+    }
+    reductions_->clear();
+}
+
+
+void StrategyContext::discard() {
+    deferred_.clear();
+    haloExchanges_.clear();
+    reductions_->clear();
+}
+
+
+void StrategyContext::clearCaches() {
+    std::lock_guard<std::mutex> lock(cacheMutex_);
+    cache_.clear();
+}
+
+
+std::size_t StrategyContext::cacheSize() const {
+    std::lock_guard<std::mutex> lock(cacheMutex_);
+    return cache_.size();
+}
+
+}  // namespace data
+}  // namespace plume
@@ -0,0 +1,209 @@
+/*
+ * (C) Copyright 2025- ECMWF.
+ *
+ * This software is licensed under the terms of the Apache Licence Version 2.0
+ * which can be obtained at http://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * In applying this licence, ECMWF does not waive the privileges and immunities
+ * granted to it by virtue of its status as an intergovernmental organisation nor
+ * does it submit to any jurisdiction.
+ */
+#pragma once
+
+#include <cstddef>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <tuple>
+#include <typeindex>
+#include <typeinfo>
+#include <utility>
+#include <vector>
+
+#include "eckit/memory/NonCopyable.h"
+#include "eckit/mpi/Comm.h"
+
+#include "atlas/field/FieldSet.h"
+#include "atlas/functionspace/FunctionSpace.h"
+
+#include "plume/Tracer.h"
+#include "plume/data/Reductions.h"
+
+
+namespace plume {
+
+class ThreadPool;
+
+namespace data {
+
+class HorizontalDerivatives;
+
+/**
+ * @brief State shared by the update strategies of a model data (and of its copies and subsets)
+ *
+ * Index data computed from a function space (region indices, station stencils, derivative stencils) is cached per
+ * function space, and shared by all the strategies using it. The cache lives as long as the model data, and the
+ * session feeding it clears it at teardown.
+ *
+ * The collectives of the strategies updated in a step are batched: while the model data marks parameters as updated
+ * (see Step), strategies add their reductions and halo copies to the step and defer the rest of their update, which
+ * runs once all the reductions of the step have been combined in a single collective, and all the halo copies on a
+ * function space have been exchanged together. Outside of a step, deferred updates run at once. A step records its
+ * trace events to the tracer of the session fed with the model data (see setTracer), and strategies may share the
+ * work of an update on the thread pool of that session (see setThreadPool). The collectives of the strategies run on
+ * the communicator of that session (see setComm).
+ *
+ * The model data installs its context in the thread while creating strategies (see Scope), strategies using it after
+ * their construction keep it.
+ */
+class StrategyContext : private eckit::NonCopyable {
+
+public:
+
+    StrategyContext() = default;
+
+    /**
+     * @brief Context of the strategies created in this thread: the one installed by a scope, or a new one (used by the
+     *        caller only) outside of any scope
+     *
+     * @return std::shared_ptr<StrategyContext>
+     */
+    static std::shared_ptr<StrategyContext> current();
+
+    /**
+     * @brief Makes a context current on the calling thread for the lifetime of the scope
+     */
+    class Scope {
+    public:
+        explicit Scope(std::shared_ptr<StrategyContext> context);
+        ~Scope();
+
+        Scope(const Scope&)            = delete;
+        Scope& operator=(const Scope&) = delete;
+
+    private:
+        std::shared_ptr<StrategyContext> previous_;
+    };
+
+    /**
+     * @brief Value of type T for a function space and a key, made on first use (make may be collective)
+     *
+     * The entry holds the function space, which therefore stays alive and identifies it until the cache is cleared.
+     */
+    template <typename T, typename Make>
+    std::shared_ptr<const T> cached(const atlas::FunctionSpace& functionspace, const std::string& key, Make&& make) {
+        std::lock_guard<std::mutex> lock(cacheMutex_);
+        CacheKey entryKey{static_cast<const void*>(functionspace.get()), std::type_index(typeid(T)), key};
+        auto it = cache_.find(entryKey);
+        if (it != cache_.end()) {
+            return std::static_pointer_cast<const T>(it->second.value);
+        }
+        std::shared_ptr<const T> value = make();
+        cache_.emplace(std::move(entryKey), CacheEntry{functionspace, value});
+        return value;
+    }
+
+    /// Tracer installed by the steps (none by default).
+    void setTracer(std::shared_ptr<Tracer> tracer) { tracer_ = std::move(tracer); }
+
+    /**
+     * @brief Communicator of the collectives of the strategies (the default one unless set)
+     *
+     * Set by the session fed with the model data, before it creates derived parameters: strategies created before keep
+     * the index data (e.g. station owners) computed on the previous communicator.
+     *
+     * @throws eckit::UserError If another communicator has already been set (sessions sharing a model data must share
+     *         their communicator), or during a step.
+     */
+    void setComm(const eckit::mpi::Comm& comm);
+
+    const eckit::mpi::Comm& comm() const { return *comm_; }
+
+    /// Thread pool of the strategies (none by default).
+    void setThreadPool(std::shared_ptr<ThreadPool> pool) { threadPool_ = std::move(pool); }
+
+    /// Thread pool of the strategies (nullptr if none, the work then runs on the calling thread).
+    ThreadPool* threadPool() const { return threadPool_.get(); }
+
+    /**
+     * @brief Batches the collectives of the strategies updated in its lifetime, run by `end` (collective)
+     *
+     * The tracer of the context is current on the thread for the lifetime of the step. A step that is not ended (e.g.
+     * on error) discards its pending updates.
+     */
+    class Step {
+    public:
+        explicit Step(StrategyContext& context);
+        ~Step();
+
+        Step(const Step&)            = delete;
+        Step& operator=(const Step&) = delete;
+
+        /// Runs the collectives of the step, then the updates waiting for them.
+        void end();
+
+    private:
+        StrategyContext& context_;
+        bool ended_;
+        Tracer::Install install_;
+    };
+
+    /// Reductions of the current step, computed together before the deferred updates run.
+    Reductions& reductions() { return *reductions_; }
+
+    /// Adds halo copies (see HorizontalDerivatives::haloCopies) to the halo exchange of the current step.
+    void addHaloExchange(const std::shared_ptr<const HorizontalDerivatives>& derivatives,
+                         const std::vector<atlas::Field>& copies);
+
+    /// Runs an update once the collectives of the current step are done (at once outside of a step).
+    void defer(std::function<void()> update);
+
+    /// Drops the cached values and function spaces (strategies keep the values they hold).
+    void clearCaches();
+
+    /// Number of cached values.
+    std::size_t cacheSize() const;
+
+private:
+
+    // (function space, type of value, key)
+    using CacheKey = std::tuple<const void*, std::type_index, std::string>;
+
+    struct CacheEntry {
+        atlas::FunctionSpace functionspace;
+        std::shared_ptr<const void> value;
+    };
+
+    // runs the collectives, then the deferred updates
+    void flush();
+
+    // drops the pending collectives and updates
+    void discard();
+
+    mutable std::mutex cacheMutex_;
+
+    std::map<CacheKey, CacheEntry> cache_;
+
+    // current step
+    bool inStep_ = false;
+
+    const eckit::mpi::Comm* comm_ = &eckit::mpi::comm();
+    bool commSet_                 = false;
+
+    // on the communicator
+    std::unique_ptr<Reductions> reductions_ = std::make_unique<Reductions>(*comm_);
+
+    // halo copies, per function space (in the order of the first request)
+    std::vector<std::pair<std::shared_ptr<const HorizontalDerivatives>, atlas::FieldSet>> haloExchanges_;
+
+    std::vector<std::function<void()>> deferred_;
+
+    std::shared_ptr<Tracer> tracer_;
+
+    std::shared_ptr<ThreadPool> threadPool_;
+};
+
+}  // namespace data
+}  // namespace plume
@@ -27,6 +27,8 @@ All symbols defined here delegate to the native C++ extension exposed via
 
 from __future__ import annotations
 
+from typing import TYPE_CHECKING, Sequence
+
 from pynwp_emulator._internal import (
     DataSourceType,
     FieldOverlaySnapshot,
@@ -35,6 +37,9 @@ from pynwp_emulator._internal import (
     RunResult,
 )
 
+if TYPE_CHECKING:
+    import numpy as np
+
 __all__ = [
     "DataSourceType",
     "FieldOverlaySnapshot",
@@ -97,6 +102,7 @@ class NWPEmulator:
         """
         self._core = NWPEmulatorCore()
         self._options = options
+        self._lonlat: np.ndarray | None = None
 
     # ------------------------------------------------------------------
     # Context manager protocol
@@ -168,6 +174,7 @@ class NWPEmulator:
         bool
             ``True`` on success.
         """
+        self._lonlat = None
         return self._core.setup_data_provider(options)
 
     def setup_plume_provider(self) -> bool:
@@ -197,7 +204,12 @@ class NWPEmulator:
         self._core.finalize_plume()
 
     def finalize_run(self) -> None:
-        """Release all resources held by the emulator."""
+        """Release all resources held by the emulator.
+
+        Arrays returned by :meth:`get_field_values` and :meth:`get_lonlat`
+        remain valid, they keep the values of the last step.
+        """
+        self._lonlat = None
         self._core.finalize_run()
 
     def current_step(self) -> int:
@@ -227,6 +239,68 @@ class NWPEmulator:
         """
         return self._core.get_field_overlay_snapshot(field_key)
 
+    def get_field_values(self, field_key: str, out: np.ndarray | None = None) -> np.ndarray:
+        """Return the rank-local values of *field_key* at the current step, without copy.
+
+        The returned array is a read-only view of the emulator memory: it keeps
+        the precision of the emulator fields (``float32`` in single-precision
+        builds) and its values change with each step. Copy it to keep the
+        values of a step, or pass *out*. The view owns a reference to the
+        memory, so it stays valid after :meth:`finalize_run` or a new
+        :meth:`setup_data_provider` (holding the values of the last step).
+
+        Parameters
+        ----------
+        field_key:
+            A key returned by :meth:`available_field_keys`.
+        out:
+            Optional preallocated array of the same length, filled with the
+            values (converted to its dtype) and returned instead of the view.
+        """
+        view = self._core.get_field_values_view(field_key)
+        if out is None:
+            return view
+        out[...] = view
+        return out
+
+    def get_fields_values(
+        self, field_keys: Sequence[str], out: np.ndarray | None = None
+    ) -> list[np.ndarray] | np.ndarray:
+        """Return the rank-local values of several fields at the current step, without copy.
+
+        Parameters
+        ----------
+        field_keys:
+            Keys returned by :meth:`available_field_keys`.
+        out:
+            Optional preallocated array of shape ``(len(field_keys), n)``, row
+            ``i`` is filled with the values of ``field_keys[i]``.
+
+        Returns
+        -------
+        list[numpy.ndarray] | numpy.ndarray
+            One read-only view per key (see :meth:`get_field_values`), or *out*.
+        """
+        views = self._core.get_field_values_views(list(field_keys))
+        if out is None:
+            return views
+        if len(out) != len(views):
+            raise ValueError(f"out has {len(out)} rows for {len(views)} field keys")
+        for row, view in zip(out, views):
+            row[...] = view
+        return out
+
+    def get_lonlat(self) -> np.ndarray:
+        """Return the rank-local ``(lon, lat)`` coordinates in degrees, one row per point.
+
+        The coordinates are in the order of the values of :meth:`get_field_values`.
+        The read-only array views the emulator memory and is cached, as the
+        coordinates do not change during the run.
+        """
+        if self._lonlat is None:
+            self._lonlat = self._core.get_lonlat_view()
+        return self._lonlat
+
     def execute(self, options: RunOptions) -> RunResult:
         """Run the full emulator lifecycle (setup → steps → teardown).
 
@@ -9,6 +9,10 @@
  * does it submit to any jurisdiction.
  */
 
+#include <algorithm>
+#include <string>
+#include <vector>
+
 #include "eckit/testing/Test.h"
 #include "eckit/runtime/Main.h"
 #include "plume/api/plume.h"
@@ -114,6 +118,148 @@ CASE("test_data_api") {
 }
 
 
+// counts the calls and produces the call number
+struct Producer {
+    int calls = 0;
+    double value = 0.0;
+};
+
+void produce_double(const char* name, void* context) {
+    auto* producer = static_cast<Producer*>(context);
+    producer->value = ++producer->calls;
+}
+
+
+CASE("test_data_api_lazy") {
+
+    plume_data_handle_t* data_handle;
+
+    EXPECT_PLUME_CODE_SUCCESS( plume_initialise(eckit::Main::instance().argc(), eckit::Main::instance().argv()) );
+    EXPECT_PLUME_CODE_SUCCESS( plume_data_create_handle_t(&data_handle) );
+
+    Producer producer;
+    EXPECT_PLUME_CODE_SUCCESS(
+        plume_data_provide_double_lazy(data_handle, "LAZY", &producer.value, produce_double, &producer) );
+    EXPECT_PLUME_CODE_FAILURE( plume_data_provide_double_lazy(data_handle, "NULL", &producer.value, NULL, NULL) );
+
+    // nothing produced until accessed
+    EXPECT_EQUAL(producer.calls, 0);
+
+    // produced once per step
+    double value = 0.0;
+    EXPECT_PLUME_CODE_SUCCESS( plume_data_get_double(data_handle, "LAZY", &value) );
+    EXPECT_PLUME_CODE_SUCCESS( plume_data_get_double(data_handle, "LAZY", &value) );
+    EXPECT_EQUAL(producer.calls, 1);
+    EXPECT_EQUAL(value, 1.0);
+
+    const char* updated_params[] = { "LAZY" };
+    EXPECT_PLUME_CODE_SUCCESS( plume_data_set_updated(data_handle, 1, updated_params));
+    EXPECT_EQUAL(producer.calls, 1);
+    EXPECT_PLUME_CODE_SUCCESS( plume_data_get_double(data_handle, "LAZY", &value) );
+    EXPECT_EQUAL(producer.calls, 2);
+    EXPECT_EQUAL(value, 2.0);
+
+    EXPECT_PLUME_CODE_SUCCESS( plume_data_delete_handle(data_handle) );
+    EXPECT_PLUME_CODE_SUCCESS( plume_finalise() );
+}
+
+
+
+CASE("test_data_api_ids") {
+
+    plume_data_handle_t* data_handle;
+
+    EXPECT_PLUME_CODE_SUCCESS( plume_initialise(eckit::Main::instance().argc(), eckit::Main::instance().argv()) );
+    EXPECT_PLUME_CODE_SUCCESS( plume_data_create_handle_t(&data_handle) );
+
+    int param_i = 1;
+    double param_dd1 = 2.0;
+    EXPECT_PLUME_CODE_SUCCESS( plume_data_provide_int(data_handle, "ID_I", &param_i) );
+    EXPECT_PLUME_CODE_SUCCESS( plume_data_provide_double(data_handle, "ID_DD1", &param_dd1) );
+
+    int id_i = -1;
+    int id_dd1 = -1;
+    EXPECT_PLUME_CODE_SUCCESS( plume_data_param_id(data_handle, "ID_I", &id_i) );
+    EXPECT_PLUME_CODE_SUCCESS( plume_data_param_id(data_handle, "ID_DD1", &id_dd1) );
+    EXPECT(id_i >= 0 && id_dd1 >= 0 && id_i != id_dd1);
+
+    int not_found = -1;
+    EXPECT_PLUME_CODE_FAILURE( plume_data_param_id(data_handle, "param-not-found", &not_found) );
+    EXPECT_EQUAL(not_found, -1);
+
+    // commit a step from ids, then from a bitmask
+    const int updated_ids[] = { id_dd1 };
+    EXPECT_PLUME_CODE_SUCCESS( plume_data_set_updated_ids(data_handle, 1, updated_ids) );
+
+    const int nwords = std::max(id_i, id_dd1) / 64 + 1;
+    std::vector<uint64_t> mask(nwords, 0);
+    mask[id_i / 64] |= uint64_t{1} << (id_i % 64);
+    EXPECT_PLUME_CODE_SUCCESS( plume_data_set_updated_mask(data_handle, nwords, mask.data()) );
+
+    const int unknown_ids[] = { -1 };
+    EXPECT_PLUME_CODE_FAILURE( plume_data_set_updated_ids(data_handle, 1, unknown_ids) );
+
+    EXPECT_PLUME_CODE_SUCCESS( plume_data_delete_handle(data_handle) );
+    EXPECT_PLUME_CODE_SUCCESS( plume_finalise() );
+}
+
+
+
+CASE("test_data_api_array") {
+
+    plume_data_handle_t* data_handle;
+
+    EXPECT_PLUME_CODE_SUCCESS( plume_initialise(eckit::Main::instance().argc(), eckit::Main::instance().argv()) );
+    EXPECT_PLUME_CODE_SUCCESS( plume_data_create_handle_t(&data_handle) );
+
+    // 3 columns of 4 levels, column-major
+    std::vector<double> values(12, 1.0);
+    const int shape[]   = { 3, 4 };
+    const int strides[] = { 1, 3 };
+    EXPECT_PLUME_CODE_SUCCESS( plume_data_provide_array(data_handle, "ARR", values.data(), "real64", 2, shape, strides) );
+    EXPECT_PLUME_CODE_SUCCESS( plume_data_provide_array(data_handle, "ARR_C", values.data(), "real64", 2, shape, nullptr) );
+
+    EXPECT_PLUME_CODE_FAILURE( plume_data_provide_array(data_handle, "ARR_BAD", values.data(), "complex", 2, shape, strides) );
+    EXPECT_PLUME_CODE_FAILURE( plume_data_provide_array(data_handle, "ARR_NULL", nullptr, "real64", 2, shape, strides) );
+    EXPECT_PLUME_CODE_FAILURE( plume_data_provide_array(data_handle, "ARR_R0", values.data(), "real64", 0, shape, strides) );
+    EXPECT_PLUME_CODE_FAILURE( plume_data_provide_array(data_handle, "ARR_R5", values.data(), "real64", 5, shape, nullptr) );
+
+    // offered with the same rank checks
+    plume_protocol_handle_t* protocol_handle;
+    EXPECT_PLUME_CODE_SUCCESS( plume_protocol_create_handle(&protocol_handle) );
+    EXPECT_PLUME_CODE_SUCCESS( plume_protocol_offer_array(protocol_handle, "ARR", "always", "array", "real64", 2, shape) );
+    EXPECT_PLUME_CODE_FAILURE( plume_protocol_offer_array(protocol_handle, "ARR_R0", "always", "array", "real64", 0, shape) );
+    EXPECT_PLUME_CODE_FAILURE( plume_protocol_offer_array(protocol_handle, "ARR_R5", "always", "array", "real64", 5, shape) );
+    EXPECT_PLUME_CODE_SUCCESS( plume_protocol_delete_handle(protocol_handle) );
+
+    const char* updated[] = { "ARR" };
+    EXPECT_PLUME_CODE_SUCCESS( plume_data_set_updated(data_handle, 1, updated) );
+
+    // read back in place
+    plume_array_t array;
+    EXPECT_PLUME_CODE_SUCCESS( plume_data_get_array(data_handle, "ARR", &array) );
+    EXPECT_EQUAL(array.data, static_cast<const void*>(values.data()));
+    EXPECT_EQUAL(std::string(array.datatype), "real64");
+    EXPECT_EQUAL(array.rank, 2);
+    EXPECT_EQUAL(array.shape[1], 4);
+    EXPECT_EQUAL(array.strides[1], 3);
+    EXPECT_EQUAL(array.shape[2], 0);
+    EXPECT_PLUME_CODE_FAILURE( plume_data_get_array(data_handle, "ARR_NULL", &array) );
+
+    bool is_updated = false;
+    uint64_t generation = 0;
+    EXPECT_PLUME_CODE_SUCCESS( plume_data_is_updated(data_handle, "ARR", &is_updated) );
+    EXPECT_PLUME_CODE_SUCCESS( plume_data_generation(data_handle, "ARR", &generation) );
+    EXPECT(is_updated);
+    EXPECT_EQUAL(generation, 1);
+    EXPECT_PLUME_CODE_SUCCESS( plume_data_is_updated(data_handle, "ARR_C", &is_updated) );
+    EXPECT(!is_updated);
+
+    EXPECT_PLUME_CODE_SUCCESS( plume_data_delete_handle(data_handle) );
+    EXPECT_PLUME_CODE_SUCCESS( plume_finalise() );
+}
+
+
 
 }  // namespace plume::test
 
@@ -147,6 +147,66 @@ CASE("test_manager_api") {
     EXPECT_PLUME_CODE_SUCCESS( plume_finalise());
 }
 
+CASE("test_manager_session_api") {
+
+    plume_protocol_handle_t* protocol_handle;
+    plume_manager_handle_t* session_a;
+    plume_manager_handle_t* session_b;
+
+    EXPECT_PLUME_CODE_SUCCESS( plume_initialise(eckit::Main::instance().argc(), eckit::Main::instance().argv()));
+
+    EXPECT_PLUME_CODE_SUCCESS( plume_protocol_create_handle(&protocol_handle));
+    EXPECT_PLUME_CODE_SUCCESS( plume_protocol_offer_int(protocol_handle, "I", "always", "this is param I"));
+    EXPECT_PLUME_CODE_SUCCESS( plume_protocol_offer_int(protocol_handle, "J", "always", "this is param J"));
+    EXPECT_PLUME_CODE_SUCCESS( plume_protocol_offer_float(protocol_handle, "FF1", "always", "this is param FF1"));
+    EXPECT_PLUME_CODE_SUCCESS( plume_protocol_offer_double(protocol_handle, "DD1", "always", "this is param DD1"));
+
+    std::string conf_with_plugin =
+    R"YAML(
+      plugins:
+        - lib: plume_plugin_test_api
+          name: PluginTestAPI
+          parameters:
+            -
+              - name: I
+                type: INT
+              - name: J
+                type: INT
+              - name: FF1
+                type: FLOAT
+              - name: DD1
+                type: DOUBLE
+          core-config: {}
+    )YAML";
+
+    std::string conf_without_plugins = R"YAML({plugins: []})YAML";
+
+    // two independent sessions, configured differently
+    EXPECT_PLUME_CODE_SUCCESS( plume_manager_create_session_handle(&session_a));
+    EXPECT_PLUME_CODE_SUCCESS( plume_manager_create_session_handle(&session_b));
+    EXPECT_PLUME_CODE_SUCCESS( plume_manager_configure_from_string(session_a, conf_with_plugin.c_str()));
+    EXPECT_PLUME_CODE_SUCCESS( plume_manager_configure_from_string(session_b, conf_without_plugins.c_str()));
+    EXPECT_PLUME_CODE_SUCCESS( plume_manager_negotiate(session_a, protocol_handle));
+    EXPECT_PLUME_CODE_SUCCESS( plume_manager_negotiate(session_b, protocol_handle));
+
+    bool plugin_activated = false;
+    EXPECT_PLUME_CODE_SUCCESS( plume_manager_is_plugin_activated(session_a, "PluginTestAPI", &plugin_activated));
+    EXPECT(plugin_activated);
+    EXPECT_PLUME_CODE_SUCCESS( plume_manager_is_plugin_activated(session_b, "PluginTestAPI", &plugin_activated));
+    EXPECT(!plugin_activated);
+
+    bool requested = false;
+    EXPECT_PLUME_CODE_SUCCESS( plume_manager_is_param_requested(session_a, "I", &requested));
+    EXPECT(requested);
+    EXPECT_PLUME_CODE_SUCCESS( plume_manager_is_param_requested(session_b, "I", &requested));
+    EXPECT(!requested);
+
+    EXPECT_PLUME_CODE_SUCCESS( plume_manager_delete_handle(session_a));
+    EXPECT_PLUME_CODE_SUCCESS( plume_manager_delete_handle(session_b));
+    EXPECT_PLUME_CODE_SUCCESS( plume_protocol_delete_handle(protocol_handle));
+    EXPECT_PLUME_CODE_SUCCESS( plume_finalise());
+}
+
 }  // namespace plume::test
 
 int main(int argc, char** argv) {
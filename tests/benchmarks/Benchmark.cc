@@ -0,0 +1,187 @@
+/*
+ * (C) Copyright 2025- ECMWF.
+ *
+ * This software is licensed under the terms of the Apache Licence Version 2.0
+ * which can be obtained at http://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * In applying this licence, ECMWF does not waive the privileges and immunities
+ * granted to it by virtue of its status as an intergovernmental organisation nor
+ * does it submit to any jurisdiction.
+ */
+#include <algorithm>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+
+#include "eckit/config/YAMLConfiguration.h"
+#include "eckit/exception/Exceptions.h"
+#include "eckit/filesystem/PathName.h"
+
+#include "Benchmark.h"
+
+
+namespace plume::benchmark {
+
+namespace {
+
+std::string option(const std::string& arg, const std::string& name) {
+    const std::string prefix = "--" + name + "=";
+    return arg.compare(0, prefix.size(), prefix) == 0 ? arg.substr(prefix.size()) : std::string();
+}
+
+double seconds(Harness::Clock::duration d) {
+    return std::chrono::duration<double>(d).count();
+}
+
+}  // namespace
+
+
+std::string Result::id() const {
+    std::string id = name;
+    for (const auto& [key, value] : params) {
+        id += "/" + key + "=" + value;
+    }
+    return id;
+}
+
+
+Harness::Harness(int argc, char** argv) {
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (arg == "--quick") {
+            quick_ = true;
+        }
+        else if (!option(arg, "filter").empty()) {
+            filter_ = option(arg, "filter");
+        }
+        else if (!option(arg, "output").empty()) {
+            output_ = option(arg, "output");
+        }
+        else if (!option(arg, "baseline").empty()) {
+            baseline_ = option(arg, "baseline");
+        }
+        else if (!option(arg, "tolerance").empty()) {
+            tolerance_ = std::stod(option(arg, "tolerance"));
+        }
+        else {
+            throw eckit::UserError("plume_benchmarks: unknown option " + arg, Here());
+        }
+    }
+    minTime_     = quick_ ? 0.01 : 0.2;
+    repetitions_ = quick_ ? 3 : 7;
+}
+
+
+bool Harness::selected(const Result& result) const {
+    return filter_.empty() || result.id().find(filter_) != std::string::npos;
+}
+
+
+void Harness::run(const std::string& name, const Params& params, double itemsPerOp, const std::function<void()>& op) {
+    Result result{name, params, 1, repetitions_, 0., 0., 0.};
+    if (!selected(result)) {
+        return;
+    }
+
+    // warm up, then as many iterations as fit in the minimum time
+    auto start = Clock::now();
+    op();
+    double once = std::max(seconds(Clock::now() - start), 1e-9);
+    result.iterations = std::max<std::size_t>(1, static_cast<std::size_t>(minTime_ / once));
+
+    std::vector<double> samples;
+    for (std::size_t r = 0; r < repetitions_; ++r) {
+        start = Clock::now();
+        for (std::size_t i = 0; i < result.iterations; ++i) {
+            op();
+        }
+        samples.push_back(1e9 * seconds(Clock::now() - start) / result.iterations);
+    }
+    result.itemsPerSecond = itemsPerOp;
+    record(std::move(result), std::move(samples));
+}
+
+
+void Harness::run(const std::string& name, const Params& params, double itemsPerOp,
+                  const std::function<void()>& setup, const std::function<void()>& op) {
+    Result result{name, params, 1, repetitions_, 0., 0., 0.};
+    if (!selected(result)) {
+        return;
+    }
+
+    std::vector<double> samples;
+    for (std::size_t r = 0; r < repetitions_; ++r) {
+        setup();
+        auto start = Clock::now();
+        op();
+        samples.push_back(1e9 * seconds(Clock::now() - start));
+    }
+    result.itemsPerSecond = itemsPerOp;
+    record(std::move(result), std::move(samples));
+}
+
+
+void Harness::record(Result result, std::vector<double> samples) {
+    std::sort(samples.begin(), samples.end());
+    result.minNs          = samples.front();
+    result.medianNs       = samples[samples.size() / 2];
+    result.itemsPerSecond = result.itemsPerSecond * 1e9 / result.medianNs;
+
+    std::cout << std::left << std::setw(72) << result.id() << std::right << std::setw(14) << std::fixed
+              << std::setprecision(1) << result.medianNs << " ns" << std::setw(14) << std::scientific
+              << std::setprecision(3) << result.itemsPerSecond << " items/s" << std::endl;
+
+    results_.push_back(std::move(result));
+}
+
+
+int Harness::finish() {
+    {
+        std::ofstream out(output_);
+        if (!out) {
+            throw eckit::CantOpenFile(output_, Here());
+        }
+        out << "{\n  \"quick\": " << (quick_ ? "true" : "false") << ",\n  \"benchmarks\": [";
+        const char* separator = "\n";
+        for (const auto& result : results_) {
+            out << separator << "    {\"id\": \"" << result.id() << "\", \"name\": \"" << result.name
+                << "\", \"params\": {";
+            const char* paramSeparator = "";
+            for (const auto& [key, value] : result.params) {
+                out << paramSeparator << '"' << key << "\": \"" << value << '"';
+                paramSeparator = ", ";
+            }
+            out << "}, \"iterations\": " << result.iterations << ", \"repetitions\": " << result.repetitions
+                << std::setprecision(17) << ", \"median_ns\": " << result.medianNs << ", \"min_ns\": " << result.minNs
+                << ", \"items_per_second\": " << result.itemsPerSecond << "}";
+            separator = ",\n";
+        }
+        out << "\n  ]\n}\n";
+    }
+    std::cout << "Results written to " << output_ << std::endl;
+
+    if (baseline_.empty()) {
+        return 0;
+    }
+
+    // regressions of the medians against a previous run (JSON is read as YAML)
+    std::map<std::string, double> reference;
+    eckit::YAMLConfiguration baseline{eckit::PathName(baseline_)};
+    for (const auto& entry : baseline.getSubConfigurations("benchmarks")) {
+        reference[entry.getString("id")] = entry.getDouble("median_ns");
+    }
+
+    int regressions = 0;
+    for (const auto& result : results_) {
+        auto it = reference.find(result.id());
+        if (it != reference.end() && result.medianNs > (1. + tolerance_) * it->second) {
+            std::cout << "REGRESSION " << result.id() << ": " << std::fixed << std::setprecision(1)
+                      << result.medianNs << " ns against " << it->second << " ns" << std::endl;
+            ++regressions;
+        }
+    }
+    std::cout << regressions << " regression(s) against " << baseline_ << std::endl;
+    return regressions > 0 ? 1 : 0;
+}
+
+}  // namespace plume::benchmark
@@ -0,0 +1,94 @@
+/*
+ * (C) Copyright 2025- ECMWF.
+ *
+ * This software is licensed under the terms of the Apache Licence Version 2.0
+ * which can be obtained at http://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * In applying this licence, ECMWF does not waive the privileges and immunities
+ * granted to it by virtue of its status as an intergovernmental organisation nor
+ * does it submit to any jurisdiction.
+ */
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <functional>
+#include <map>
+#include <string>
+#include <vector>
+
+
+namespace plume::benchmark {
+
+/// Keeps a value (and the work producing it) from being optimised away.
+template <typename T>
+inline void doNotOptimize(const T& value) {
+    asm volatile("" : : "r,m"(value) : "memory");
+}
+
+using Params = std::map<std::string, std::string>;
+
+struct Result {
+    std::string name;
+    Params params;
+    std::size_t iterations;   // per repetition
+    std::size_t repetitions;
+    double medianNs;          // per iteration
+    double minNs;
+    double itemsPerSecond;    // from the median
+
+    /// Unique key of the result, name/key=value/...
+    std::string id() const;
+};
+
+/**
+ * @brief Minimal microbenchmark harness
+ *
+ * Each benchmark is repeated, the iterations of a repetition being calibrated to last a minimum time. Results (median
+ * and minimum time per iteration) are printed and written as JSON. Options:
+ *  --quick               smaller sizes and shorter runs (used by ctest)
+ *  --filter=<text>       only the benchmarks whose id contains text
+ *  --output=<file>       JSON results (default plume_benchmarks.json)
+ *  --baseline=<file>     JSON results of a previous run, a slower median fails the run
+ *  --tolerance=<ratio>   slowdown allowed against the baseline (default 0.25)
+ */
+class Harness {
+
+public:
+
+    using Clock = std::chrono::steady_clock;
+
+    Harness(int argc, char** argv);
+
+    bool quick() const { return quick_; }
+
+    /// Times op, called in calibrated batches.
+    void run(const std::string& name, const Params& params, double itemsPerOp, const std::function<void()>& op);
+
+    /// Times op only, after an untimed setup before each call (for ops that consume their input).
+    void run(const std::string& name, const Params& params, double itemsPerOp, const std::function<void()>& setup,
+             const std::function<void()>& op);
+
+    /// Writes the results, compares them with the baseline (if any), returns the exit code.
+    int finish();
+
+    const std::vector<Result>& results() const { return results_; }
+
+private:
+
+    bool selected(const Result& result) const;
+
+    void record(Result result, std::vector<double> samples);
+
+    bool quick_ = false;
+    std::string filter_;
+    std::string output_ = "plume_benchmarks.json";
+    std::string baseline_;
+    double tolerance_ = 0.25;
+    double minTime_;  // seconds per repetition
+    std::size_t repetitions_;
+
+    std::vector<Result> results_;
+};
+
+}  // namespace plume::benchmark
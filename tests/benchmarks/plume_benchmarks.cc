@@ -0,0 +1,274 @@
+/*
+ * (C) Copyright 2025- ECMWF.
+ *
+ * This software is licensed under the terms of the Apache Licence Version 2.0
+ * which can be obtained at http://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * In applying this licence, ECMWF does not waive the privileges and immunities
+ * granted to it by virtue of its status as an intergovernmental organisation nor
+ * does it submit to any jurisdiction.
+ */
+#include <iostream>
+#include <memory>
+#include <set>
+#include <sstream>
+#include <string>
+#include <unordered_set>
+#include <vector>
+
+#include "eckit/config/LocalConfiguration.h"
+#include "eckit/config/YAMLConfiguration.h"
+#include "eckit/exception/Exceptions.h"
+#include "eckit/log/Log.h"
+#include "eckit/runtime/Main.h"
+
+#include "atlas/array.h"
+#include "atlas/field/Field.h"
+
+#include "plume/Negotiator.h"
+#include "plume/Protocol.h"
+#include "plume/Session.h"
+#include "plume/data/FieldProvider.h"
+#include "plume/data/ModelData.h"
+#include "plume/data/ParameterCatalogue.h"
+#include "plume/data/ParameterValue.h"
+
+#include "Benchmark.h"
+
+
+using plume::benchmark::Harness;
+using plume::benchmark::Params;
+using plume::benchmark::doNotOptimize;
+
+namespace {
+
+std::string paramName(std::size_t i) {
+    return "param-" + std::to_string(i);
+}
+
+// YAML list of INT params [first, first + n)
+std::string paramList(const std::string& key, std::size_t first, std::size_t n) {
+    std::ostringstream yaml;
+    yaml << key << ":\n";
+    for (std::size_t i = first; i < first + n; ++i) {
+        yaml << "  - name: " << paramName(i) << "\n    type: INT\n    available: always\n    comment: bench\n";
+    }
+    return yaml.str();
+}
+
+std::vector<std::size_t> paramCounts(const Harness& harness) {
+    if (harness.quick()) {
+        return {10, 1000};
+    }
+    return {10, 100, 1000, 10000};
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+
+void modelData(Harness& harness) {
+    for (std::size_t n : paramCounts(harness)) {
+        Params params{{"params", std::to_string(n)}};
+
+        plume::data::ModelData data;
+        std::vector<std::string> names;
+        for (std::size_t i = 0; i < n; ++i) {
+            names.push_back(paramName(i));
+            data.createParam(names.back(), static_cast<int>(i));
+        }
+
+        std::size_t next = 0;
+        harness.run("ModelData::getParam", params, 1., [&] {
+            doNotOptimize(data.getParam<int>(names[next]));
+            next = (next + 7919) % n;
+        });
+
+        std::set<std::string> half(names.begin(), names.begin() + n / 2);
+        harness.run("ModelData::filter", params, n / 2, [&] { doNotOptimize(data.filter(half)); });
+
+        harness.run("ModelData::setUpdated", params, n, [&] { data.setUpdated(names); });
+
+        harness.run("ModelData::clearUpdated", params, n, [&] { data.clearUpdated(); });
+    }
+}
+
+
+void parameterCatalogue(Harness& harness) {
+    for (std::size_t n : paramCounts(harness)) {
+        Params params{{"params", std::to_string(n)}};
+
+        plume::data::ParameterCatalogue catalogue{eckit::YAMLConfiguration(paramList("params", 0, n))};
+
+        std::size_t next = 0;
+        harness.run("ParameterCatalogue::getParam", params, 1., [&] {
+            doNotOptimize(catalogue.getParam(paramName(next)));
+            next = (next + 7919) % n;
+        });
+
+        harness.run("ParameterCatalogue::hasParam", params, 1., [&] {
+            doNotOptimize(catalogue.hasParam(paramName(next)));
+            next = (next + 7919) % n;
+        });
+
+        std::unordered_set<std::string> half;
+        for (std::size_t i = 0; i < n; i += 2) {
+            half.insert(paramName(i));
+        }
+        harness.run("ParameterCatalogue::filter", params, n, [&] { doNotOptimize(catalogue.filter(half)); });
+    }
+}
+
+
+void negotiator(Harness& harness) {
+    for (std::size_t n : paramCounts(harness)) {
+        const std::size_t groups = 4;
+        Params params{{"offers", std::to_string(n)}, {"groups", std::to_string(groups)}};
+
+        plume::Protocol offers{eckit::YAMLConfiguration(paramList("offered", 0, n))};
+
+        // a tenth of the offers required by the plugin, then groups of a tenth each (the last one not offered)
+        const std::size_t size = std::max<std::size_t>(1, n / 10);
+        plume::Protocol requires{eckit::YAMLConfiguration(paramList("required", 0, size))};
+        std::vector<eckit::LocalConfiguration> configParams;
+        for (std::size_t g = 0; g < groups; ++g) {
+            std::size_t first = (g + 1 == groups) ? n : g * size;
+            eckit::YAMLConfiguration group(paramList("group", first, size));
+            configParams.emplace_back(group, "group");
+        }
+
+        plume::Negotiator negotiator;
+        harness.run("Negotiator::negotiate", params, n, [&] {
+            doNotOptimize(negotiator.negotiate(offers, requires, configParams).accepted());
+        });
+    }
+}
+
+
+void feedPlugins(Harness& harness) {
+    const std::string config = R"YAML(
+    plugins:
+      - lib: simple_plugins
+        name: SimplePlugin
+        core-config: {}
+      - lib: simple_plugins
+        name: SimpleAtlasPlugin
+        core-config: {}
+    )YAML";
+    const std::string offered = R"YAML(
+    offered:
+      - name: I
+        type: INT
+        available: always
+        comment: none
+      - name: J
+        type: INT
+        available: always
+        comment: none
+      - name: K
+        type: INT
+        available: always
+        comment: none
+      - name: u
+        type: ATLAS_FIELD
+        available: always
+        comment: none
+      - name: z
+        type: ATLAS_FIELD
+        available: always
+        comment: none
+    )YAML";
+
+    // O80 fields on 137 levels, from which the atlas plugin derives u at 100 m
+    atlas::Field u("u", atlas::array::make_datatype<double>(), atlas::array::make_shape(35718, 137));
+    atlas::Field z("z", atlas::array::make_datatype<double>(), atlas::array::make_shape(35718, 137));
+    u.set_levels(137);
+
+    // a fresh session and data for each feed (feeding creates the derived params on the data)
+    std::unique_ptr<plume::Session> session;
+    std::unique_ptr<plume::data::ModelData> data;
+    auto setup = [&] {
+        if (session) {
+            session->teardown();
+        }
+        session = std::make_unique<plume::Session>();
+        session->configure(eckit::YAMLConfiguration(config));
+        session->negotiate(plume::Protocol{eckit::YAMLConfiguration(offered)});
+        data = std::make_unique<plume::data::ModelData>();
+        data->createParam("I", 1);
+        data->createParam("J", 2);
+        data->createParam("K", 3);
+        data->provideParam("u", &u);
+        data->provideParam("z", &z);
+    };
+    harness.run("Session::feedPlugins", Params{{"plugins", "2"}}, 2., setup, [&] { session->feedPlugins(*data); });
+    if (session) {
+        session->teardown();
+    }
+}
+
+
+template <typename T>
+void windAtHeight(Harness& harness, const std::string& precision) {
+    using AtlasObservable = plume::data::ParameterValue<atlas::Field, plume::data::IParameterObservable>;
+    using AtlasObserver   = plume::data::ParameterValue<atlas::Field, plume::data::IParameterObserver>;
+
+    // points of the octahedral grids O160 and O320 (O80 if quick), 137 levels
+    std::vector<std::pair<std::string, atlas::idx_t>> grids{{"O160", 138346}, {"O320", 421120}};
+    if (harness.quick()) {
+        grids = {{"O80", 35718}};
+    }
+    const atlas::idx_t nlev = 137;
+
+    for (const auto& [grid, npoints] : grids) {
+        Params params{{"grid", grid}, {"levels", std::to_string(nlev)}, {"precision", precision}};
+
+        atlas::Field z("z", atlas::array::make_datatype<T>(), atlas::array::make_shape(npoints, nlev));
+        atlas::Field u("u", atlas::array::make_datatype<T>(), atlas::array::make_shape(npoints, nlev));
+        u.set_levels(nlev);
+        auto zView = atlas::array::make_view<T, 2>(z);
+        auto uView = atlas::array::make_view<T, 2>(u);
+        for (atlas::idx_t i = 0; i < npoints; ++i) {
+            for (atlas::idx_t k = 0; k < nlev; ++k) {
+                // geopotential from 80 km (top, level 0) down to the surface, wind decreasing downwards
+                zView(i, k) = static_cast<T>(9.80665 * 80000. * (nlev - 1 - k) / (nlev - 1) + 1e-3 * (i % 100));
+                uView(i, k) = static_cast<T>(40. * (nlev - k) / nlev);
+            }
+        }
+        atlas::Field target = u.clone();
+
+        auto zPtr      = std::make_shared<AtlasObservable>(&z);
+        auto uPtr      = std::make_shared<AtlasObservable>(&u);
+        auto targetPtr = std::make_shared<AtlasObserver>(target);
+        plume::field_provider::WindAtHeight strategy(1000, zPtr, uPtr, targetPtr);
+
+        harness.run("WindAtHeight::update", params, npoints, [&] { strategy.update(); });
+    }
+}
+
+}  // namespace
+
+
+int main(int argc, char** argv) {
+    eckit::Main::initialise(argc, argv);
+
+    // the negotiation and the session log each parameter
+    eckit::Log::info().reset();
+    eckit::Log::warning().reset();
+
+    int status = 0;
+    try {
+        Harness harness(argc, argv);
+        modelData(harness);
+        parameterCatalogue(harness);
+        negotiator(harness);
+        feedPlugins(harness);
+        windAtHeight<float>(harness, "float");
+        windAtHeight<double>(harness, "double");
+        status = harness.finish();
+    }
+    catch (const std::exception& e) {
+        std::cerr << "plume_benchmarks: " << e.what() << std::endl;
+        status = 1;
+    }
+
+    return status;
+}
@@ -0,0 +1,167 @@
+/*
+ * (C) Copyright 2025- ECMWF.
+ *
+ * This software is licensed under the terms of the Apache Licence Version 2.0
+ * which can be obtained at http://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * In applying this licence, ECMWF does not waive the privileges and immunities
+ * granted to it by virtue of its status as an intergovernmental organisation nor
+ * does it submit to any jurisdiction.
+ */
+#include <cstdint>
+#include <type_traits>
+#include <vector>
+
+#include "eckit/testing/Test.h"
+
+#include "atlas/field/Field.h"
+
+#include "plume/Protocol.h"
+#include "plume/data/ArrayView.h"
+#include "plume/data/ModelData.h"
+#include "plume/data/ParameterCatalogue.h"
+
+
+using namespace eckit::testing;
+using plume::data::ArrayView;
+
+namespace plume::test {
+
+//----------------------------------------------------------------------------------------------------------------------
+
+CASE("test array view - layouts") {
+    std::vector<double> values(12);
+    for (std::size_t i = 0; i < values.size(); ++i) {
+        values[i] = static_cast<double>(i);
+    }
+
+    // row-major by default
+    ArrayView rowMajor(values.data(), "real64", {3, 4});
+    EXPECT_EQUAL(rowMajor.rank(), 2);
+    EXPECT_EQUAL(rowMajor.stride(0), 4);
+    EXPECT_EQUAL(rowMajor.stride(1), 1);
+    EXPECT_EQUAL(rowMajor.size(), 12);
+    EXPECT_EQUAL(rowMajor.bytes(), 96);
+    EXPECT(rowMajor.contiguous());
+    EXPECT_EQUAL(rowMajor.at<double>(1, 2), 6.);
+
+    // column-major, as passed by Fortran
+    ArrayView columnMajor(values.data(), "real64", {3, 4}, {1, 3});
+    EXPECT(columnMajor.contiguous());
+    EXPECT_EQUAL(columnMajor.at<double>(1, 2), 7.);
+
+    // every other column, not contiguous
+    ArrayView strided(values.data(), "real64", {3, 2}, {4, 2});
+    EXPECT(!strided.contiguous());
+    EXPECT_EQUAL(strided.at<double>(2, 1), 10.);
+
+    // the data type is checked on access
+    EXPECT_EQUAL(rowMajor.data<double>(), values.data());
+    EXPECT_THROWS_AS(rowMajor.data<float>(), eckit::BadCast);
+
+    // read-only, only the owner of the array writes to it
+    static_assert(std::is_same_v<decltype(rowMajor.at<double>(0, 0)), const double&>);
+    static_assert(std::is_same_v<decltype(rowMajor.data<double>()), const double*>);
+
+    EXPECT_THROWS_AS(ArrayView(values.data(), "complex64", {12}), eckit::BadValue);
+    EXPECT_THROWS_AS(ArrayView(values.data(), "real64", {1, 1, 1, 1, 12}), eckit::AssertionFailed);
+    EXPECT_THROWS_AS(ArrayView(nullptr, "real64", {12}), eckit::AssertionFailed);
+}
+
+
+CASE("test array view - provided to the model data") {
+    std::vector<float> temperature(2 * 5, 280.f);
+    std::vector<std::int32_t> mask(5, 1);
+
+    data::ModelData data;
+    data.provideArray("t", ArrayView(temperature.data(), "real32", {2, 5}));
+    data.provideArray("mask", ArrayView(mask.data(), "int32", {5}));
+
+    EXPECT(data.hasParameter("t", data::ParameterType::ARRAY));
+    EXPECT_EQUAL(data.listAvailableParameters("ARRAY").size(), 2);
+
+    // no copy, values written by the model in place are seen
+    temperature[7] = 290.f;
+    auto view      = data.getParam<ArrayView>("t");
+    EXPECT_EQUAL(view.data<float>(), temperature.data());
+    EXPECT_EQUAL(view.at<float>(1, 2), 290.f);
+
+    data.setUpdated({"t"});
+    EXPECT(data.isUpdated("t"));
+    EXPECT(!data.isUpdated("mask"));
+
+    // arrays are not derived by Plume
+    eckit::LocalConfiguration config;
+    config.set("name", "t");
+    config.set("type", "ARRAY");
+    EXPECT_THROWS_AS(data.dispatchCreateParam("levels", config), eckit::BadValue);
+}
+
+
+CASE("test array view - views of fields and level subsets") {
+    // (npoints, nlev) field, value = 100 * point + level
+    const atlas::idx_t npoints = 4;
+    const atlas::idx_t nlev    = 10;
+    std::vector<double> values(npoints * nlev);
+    for (atlas::idx_t i = 0; i < npoints; ++i) {
+        for (atlas::idx_t k = 0; k < nlev; ++k) {
+            values[i * nlev + k] = 100 * i + k + 1;
+        }
+    }
+    atlas::Field u("u", values.data(), atlas::array::make_shape(npoints, nlev));
+    std::vector<std::int64_t> counts(3, 0);
+    int steps = 0;
+
+    data::ModelData data;
+    data.provideParam("u", &u);
+    data.provideParam("steps", &steps);
+    data.provideArray("counts", ArrayView(counts.data(), "int64", {3}));
+
+    auto view = data.getArray("u");
+    EXPECT_EQUAL(view.data(), static_cast<void*>(values.data()));
+    EXPECT_EQUAL(std::string(view.datatype()), "real64");
+    EXPECT_EQUAL(view.rank(), 2);
+    EXPECT_EQUAL(view.shape(1), nlev);
+    EXPECT_EQUAL(view.at<double>(2, 4), 205.);
+
+    EXPECT_EQUAL(data.getArray("counts").data<std::int64_t>(), counts.data());
+    EXPECT_THROWS_AS(data.getArray("steps"), eckit::BadCast);
+    EXPECT_THROWS_AS(data.getArray("v"), eckit::BadParameter);
+
+    // every third level, in place
+    eckit::LocalConfiguration config;
+    config.set("name", "u");
+    config.set("type", "ATLAS_FIELD");
+    config.set("levels", "1-10/3");
+    data::ParameterDefinition param(config);
+    data.dispatchCreateParam(param.strategy(), param.config());
+
+    auto levels = data.getArray("u", "1-10/3");
+    EXPECT_EQUAL(levels.shape(1), 4);
+    EXPECT(!levels.contiguous());
+    EXPECT_EQUAL(levels.at<double>(2, 1), 204.);
+    EXPECT_EQUAL(levels.at<double>(2, 3), 210.);
+}
+
+
+CASE("test array view - offered") {
+    std::vector<double> values(100 * 3);
+
+    Protocol protocol;
+    protocol.offerArray("u", "always", "none", ArrayView(values.data(), "real64", {100, 3}));
+
+    const auto& u = protocol.offers().getParam("u");
+    EXPECT(u.type() == data::ParameterType::ARRAY);
+    EXPECT_EQUAL(u.bytes(), 2400);
+    EXPECT_EQUAL(u.levels(), 3);
+    EXPECT_EQUAL(std::string(data::typeToString(data::ParameterType::ARRAY)), "ARRAY");
+    EXPECT(data::typeFromString("ARRAY") == data::ParameterType::ARRAY);
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+
+}  // namespace plume::test
+
+int main(int argc, char** argv) {
+    return run_tests(argc, argv);
+}
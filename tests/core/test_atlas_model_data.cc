@@ -8,16 +8,26 @@
  * granted to it by virtue of its status as an intergovernmental organisation nor
  * does it submit to any jurisdiction.
  */
+#include <algorithm>
+#include <cmath>
+#include <map>
 #include <string>
+#include <vector>
 
 #include "eckit/config/LocalConfiguration.h"
 #include "eckit/testing/Test.h"
 
+#include "plume/Protocol.h"
+#include "plume/ThreadPool.h"
 #include "plume/data/ModelData.h"
+#include "plume/data/ParameterCatalogue.h"
 
 #include "atlas/array/ArrayShape.h"
 #include "atlas/array/DataType.h"
 #include "atlas/field/Field.h"
+#include "atlas/field/FieldSet.h"
+#include "atlas/functionspace/StructuredColumns.h"
+#include "atlas/grid.h"
 
 
 using namespace eckit::testing;
@@ -133,6 +143,461 @@ CASE("test model data - observing atlas fields") {
     EXPECT_EQUAL(oberserverView(3), 31);
 }
 
+CASE("test model data - level selections") {
+    using plume::field_provider::parseLevels;
+
+    EXPECT(parseLevels("3") == std::vector<std::size_t>({3}));
+    EXPECT(parseLevels("8-10") == std::vector<std::size_t>({8, 9, 10}));
+    EXPECT(parseLevels("5,1-2,2") == std::vector<std::size_t>({1, 2, 5}));
+    EXPECT(parseLevels("1-10/3") == std::vector<std::size_t>({1, 4, 7, 10}));
+    EXPECT_THROWS_AS(parseLevels(""), eckit::BadValue);
+    EXPECT_THROWS_AS(parseLevels("0-3"), eckit::BadValue);
+    EXPECT_THROWS_AS(parseLevels("5-3"), eckit::BadValue);
+    EXPECT_THROWS_AS(parseLevels("1-x"), eckit::BadValue);
+
+    // (npoints, nlev) field, value = 100 * point + level
+    const atlas::idx_t npoints = 4;
+    const atlas::idx_t nlev    = 10;
+    std::vector<double> values(npoints * nlev);
+    for (atlas::idx_t i = 0; i < npoints; ++i) {
+        for (atlas::idx_t k = 0; k < nlev; ++k) {
+            values[i * nlev + k] = 100 * i + k + 1;
+        }
+    }
+    atlas::Field u("u", values.data(), atlas::array::make_shape(npoints, nlev));
+
+    plume::data::ModelData data;
+    data.provideParam("u", &u);
+
+    auto create = [&data](const std::string& key, const std::string& levels) {
+        eckit::LocalConfiguration config;
+        config.set("name", "u");
+        config.set("type", "ATLAS_FIELD");
+        config.set(key, levels);
+        plume::data::ParameterDefinition param(config);
+        data.dispatchCreateParam(param.strategy(), param.config());
+        return param.name();
+    };
+
+    // zero-copy view of the lowest levels
+    EXPECT_EQUAL(create("levels", "8-10"), "u;ml;8-10");
+    auto lowest = data.getParam<atlas::Field>("u", "8-10", "ml");
+    EXPECT_EQUAL(lowest.shape(0), npoints);
+    EXPECT_EQUAL(lowest.shape(1), 3);
+    EXPECT_EQUAL(lowest.levels(), 3);
+    auto lowestView = atlas::array::make_view<double, 2>(lowest);
+    EXPECT_EQUAL(lowestView(0, 0), 8);
+    EXPECT_EQUAL(lowestView(3, 2), 310);
+
+    // strided view
+    create("levels", "1-10/3");
+    auto strided = atlas::array::make_view<double, 2>(data.getParam<atlas::Field>("u;ml;1-10/3"));
+    EXPECT_EQUAL(strided.shape(1), 4);
+    EXPECT_EQUAL(strided(2, 1), 204);
+    EXPECT_EQUAL(strided(2, 3), 210);
+
+    // irregular selections can only be copied
+    EXPECT_THROWS_AS(create("levels", "1,2,5"), eckit::BadValue);
+    EXPECT_THROWS_AS(create("levels", "11"), eckit::BadValue);
+    EXPECT_EQUAL(create("levels-copy", "1,2,5"), "u;mlc;1,2,5");
+
+    // the view follows the source, the copy is refreshed on update
+    values[1 * nlev + 9] = -1;
+    EXPECT_EQUAL(lowestView(1, 2), -1);
+    data.setUpdated({"u"});
+    EXPECT(data.isUpdated("u;ml;8-10"));
+    EXPECT(data.isUpdated("u;mlc;1,2,5"));
+    auto copy = atlas::array::make_view<double, 2>(data.getParam<atlas::Field>("u;mlc;1,2,5"));
+    EXPECT_EQUAL(copy.shape(1), 3);
+    EXPECT_EQUAL(copy(1, 0), 101);
+    EXPECT_EQUAL(copy(1, 2), 105);
+    EXPECT_EQUAL(copy(3, 1), 302);
+}
+
+CASE("test model data - regional subsets") {
+    using plume::field_provider::Area;
+
+    auto box = Area::parse("50/-50/-50/50");
+    EXPECT(box.contains(0., 0.));
+    EXPECT(box.contains(315., 45.));
+    EXPECT_NOT(box.contains(270., 0.));
+    EXPECT_NOT(box.contains(0., 60.));
+    EXPECT(Area::parse("10/170/-10/-170").contains(180., 0.));
+    EXPECT_NOT(Area::parse("10/170/-10/-170").contains(0., 0.));
+    EXPECT(Area::parse("90/0/-90/360").contains(123., -89.));
+    EXPECT_THROWS_AS(Area::parse("50/-50/-50"), eckit::BadValue);
+    EXPECT_THROWS_AS(Area::parse("-50/-50/50/50"), eckit::BadValue);
+    EXPECT_THROWS_AS(Area::parse("50/x/-50/50"), eckit::BadValue);
+
+    // 8 longitudes (every 45 degrees) x 5 latitudes (90, 45, 0, -45, -90), value = point index
+    atlas::functionspace::StructuredColumns fs(atlas::Grid("L8x5"));
+    atlas::Field t = fs.createField<double>(atlas::option::name("t"));
+    auto tView     = atlas::array::make_view<double, 1>(t);
+    for (atlas::idx_t i = 0; i < tView.shape(0); ++i) {
+        tView(i) = i;
+    }
+
+    plume::data::ModelData data;
+    data.provideParam("t", &t);
+
+    auto create = [&data](const std::string& area) {
+        eckit::LocalConfiguration config;
+        config.set("name", "t");
+        config.set("type", "ATLAS_FIELD");
+        config.set("area", area);
+        plume::data::ParameterDefinition param(config);
+        data.dispatchCreateParam(param.strategy(), param.config());
+        return param.name();
+    };
+
+    // 3 longitudes (315, 0, 45) x 3 latitudes
+    EXPECT_EQUAL(create("50/-50/-50/50"), "t;area;50/-50/-50/50");
+    auto region  = data.getParam<atlas::Field>("t;area;50/-50/-50/50");
+    auto& context = *data.strategyContext();
+    auto indices  = plume::field_provider::regionIndices(context, fs, "50/-50/-50/50");
+    EXPECT_EQUAL(indices->size(), 9);
+    EXPECT_EQUAL(region.shape(0), 9);
+    EXPECT_EQUAL(region.metadata().getString("area"), "50/-50/-50/50");
+
+    // index lists are shared in the context of the data, until its caches are cleared
+    EXPECT(indices == plume::field_provider::regionIndices(context, fs, "50/-50/-50/50"));
+    EXPECT(indices == plume::field_provider::regionIndices(*data.filter({"t"}).strategyContext(), fs, "50/-50/-50/50"));
+    EXPECT_EQUAL(context.cacheSize(), 1);
+    plume::data::StrategyContext other;
+    EXPECT(indices != plume::field_provider::regionIndices(other, fs, "50/-50/-50/50"));
+
+    data.setUpdated({"t"});
+    EXPECT(data.isUpdated("t;area;50/-50/-50/50"));
+    auto regionView = atlas::array::make_view<double, 1>(region);
+    for (std::size_t i = 0; i < indices->size(); ++i) {
+        EXPECT_EQUAL(regionView(i), (*indices)[i]);
+    }
+
+    // empty regions are valid
+    create("30/100/10/120");
+    EXPECT_EQUAL(data.getParam<atlas::Field>("t;area;30/100/10/120").shape(0), 0);
+
+    // clearing the caches (as at teardown) keeps the index lists of the strategies
+    EXPECT_EQUAL(context.cacheSize(), 2);
+    context.clearCaches();
+    EXPECT_EQUAL(context.cacheSize(), 0);
+    data.setUpdated({"t"});
+    EXPECT_EQUAL(regionView(8), (*indices)[8]);
+
+    // fields without function space cannot be subset
+    std::vector<double> values(4);
+    atlas::Field plain("plain", values.data(), atlas::array::make_shape(4));
+    data.provideParam("plain", &plain);
+    eckit::LocalConfiguration config;
+    config.set("name", "plain");
+    config.set("type", "ATLAS_FIELD");
+    config.set("area", "50/-50/-50/50");
+    plume::data::ParameterDefinition param(config);
+    EXPECT_THROWS_AS(data.dispatchCreateParam(param.strategy(), param.config()), eckit::BadValue);
+    EXPECT_NOT(data.hasParameter(param.name()));
+}
+
+CASE("test model data - representations") {
+
+    // (npoints, nlev) field, value = 100 * point + level
+    const atlas::idx_t npoints = 50;
+    const atlas::idx_t nlev    = 40;
+    std::vector<double> values(npoints * nlev);
+    for (atlas::idx_t i = 0; i < npoints; ++i) {
+        for (atlas::idx_t k = 0; k < nlev; ++k) {
+            values[i * nlev + k] = 100 * i + k + 1;
+        }
+    }
+    atlas::Field u("u", values.data(), atlas::array::make_shape(npoints, nlev));
+
+    plume::data::ModelData data;
+    data.provideParam("u", &u);
+
+    auto create = [&data](const std::map<std::string, std::string>& options) {
+        eckit::LocalConfiguration config;
+        config.set("name", "u");
+        config.set("type", "ATLAS_FIELD");
+        for (const auto& [key, value] : options) {
+            config.set(key, value);
+        }
+        plume::data::ParameterDefinition param(config);
+        data.dispatchCreateParam(param.strategy(), param.config());
+        return param.name();
+    };
+
+    EXPECT_EQUAL(create({{"precision", "float"}}), "u;rep;float");
+    EXPECT_EQUAL(create({{"layout", "level-major"}}), "u;rep;level-major");
+    EXPECT_EQUAL(create({{"precision", "float"}, {"layout", "level-major"}}), "u;rep;float+level-major");
+    EXPECT_THROWS_AS(create({{"precision", "half"}}), eckit::BadValue);
+    EXPECT_THROWS_AS(create({{"layout", "diagonal"}}), eckit::BadValue);
+
+    auto single = data.getParam<atlas::Field>("u;rep;float");
+    EXPECT(single.datatype() == atlas::array::DataType::real32());
+    EXPECT_EQUAL(single.shape(0), npoints);
+
+    auto transposed = data.getParam<atlas::Field>("u;rep;float+level-major");
+    EXPECT(transposed.datatype() == atlas::array::DataType::real32());
+    EXPECT_EQUAL(transposed.shape(0), nlev);
+    EXPECT_EQUAL(transposed.shape(1), npoints);
+
+    // converted once on update
+    data.setUpdated({"u"});
+    EXPECT(data.isUpdated("u;rep;float"));
+    auto singleView = atlas::array::make_view<float, 2>(single);
+    EXPECT_EQUAL(singleView(3, 4), 305.f);
+
+    auto levelMajor = atlas::array::make_view<double, 2>(data.getParam<atlas::Field>("u;rep;level-major"));
+    auto transposedView = atlas::array::make_view<float, 2>(transposed);
+    for (atlas::idx_t i = 0; i < npoints; ++i) {
+        for (atlas::idx_t k = 0; k < nlev; ++k) {
+            EXPECT_EQUAL(levelMajor(k, i), values[i * nlev + k]);
+            EXPECT_EQUAL(transposedView(k, i), static_cast<float>(values[i * nlev + k]));
+        }
+    }
+}
+
+CASE("test model data - representations on the thread pool") {
+
+    // several blocks of points, converted by the workers of the pool of the model data
+    const atlas::idx_t npoints = 20000;
+    const atlas::idx_t nlev    = 3;
+    std::vector<double> values(npoints * nlev);
+    for (std::size_t i = 0; i < values.size(); ++i) {
+        values[i] = static_cast<double>(i);
+    }
+    atlas::Field u("u", values.data(), atlas::array::make_shape(npoints, nlev));
+
+    plume::data::ModelData data;
+    data.strategyContext()->setThreadPool(std::make_shared<plume::ThreadPool>(3));
+    data.provideParam("u", &u);
+
+    std::vector<std::string> names;
+    for (const char* layout : {"point-major", "level-major"}) {
+        eckit::LocalConfiguration config;
+        config.set("name", "u");
+        config.set("type", "ATLAS_FIELD");
+        config.set("precision", "float");
+        config.set("layout", layout);
+        plume::data::ParameterDefinition param(config);
+        data.dispatchCreateParam(param.strategy(), param.config());
+        names.push_back(param.name());
+    }
+    data.setUpdated({"u"});
+
+    auto pointMajor = atlas::array::make_view<float, 2>(data.getParam<atlas::Field>(names[0]));
+    auto levelMajor = atlas::array::make_view<float, 2>(data.getParam<atlas::Field>(names[1]));
+    std::size_t mismatches = 0;
+    for (atlas::idx_t i = 0; i < npoints; ++i) {
+        for (atlas::idx_t k = 0; k < nlev; ++k) {
+            const float expected = static_cast<float>(values[i * nlev + k]);
+            mismatches += pointMajor(i, k) != expected || levelMajor(k, i) != expected;
+        }
+    }
+    EXPECT_EQUAL(mismatches, 0);
+}
+
+CASE("test model data - threshold exceedance") {
+
+    // (npoints, nlev) field
+    const atlas::idx_t npoints = 6;
+    const atlas::idx_t nlev    = 2;
+    std::vector<float> values(npoints * nlev, 0.f);
+    atlas::Field gust("gust", values.data(), atlas::array::make_shape(npoints, nlev));
+
+    plume::data::ModelData data;
+    data.provideParam("gust", &gust);
+
+    auto create = [&data](const std::string& threshold) {
+        eckit::LocalConfiguration config;
+        config.set("name", "gust");
+        config.set("type", "ATLAS_FIELD");
+        config.set("threshold", threshold);
+        plume::data::ParameterDefinition param(config);
+        data.dispatchCreateParam(param.strategy(), param.config());
+        return param.name();
+    };
+
+    EXPECT_EQUAL(create(">30"), "gust;exc;>30");
+    EXPECT_EQUAL(create("30/2"), "gust;exc;30/2");
+    EXPECT_EQUAL(create("<-5"), "gust;exc;<-5");
+    EXPECT_THROWS_AS(create(">abc"), eckit::BadValue);
+    EXPECT_THROWS_AS(create(">30/0"), eckit::BadValue);
+    EXPECT_EQUAL(data.getParam<atlas::Field>("gust;exc;>30").metadata().getInt("count"), 0);
+
+    // allocated once, with a row per point and level
+    auto above = data.getParam<atlas::Field>("gust;exc;>30");
+    EXPECT_EQUAL(above.shape(0), npoints * nlev);
+    const void* storage = above.storage();
+
+    using Column = plume::field_provider::ThresholdExceedance::Column;
+
+    values[2 * nlev + 1] = 35.f;
+    values[4 * nlev + 0] = 31.f;
+    values[5 * nlev + 1] = -10.f;
+    data.setUpdated({"gust"});
+    EXPECT(data.isUpdated("gust;exc;>30"));
+
+    above = data.getParam<atlas::Field>("gust;exc;>30");
+    EXPECT(above.storage() == storage);
+    EXPECT_EQUAL(above.shape(0), npoints * nlev);
+    EXPECT_EQUAL(above.shape(1), Column::Columns);
+    EXPECT_EQUAL(above.metadata().getInt("count"), 2);
+    auto rows = atlas::array::make_view<double, 2>(above);
+    EXPECT_EQUAL(rows(0, Column::Index), 2);
+    EXPECT_EQUAL(rows(0, Column::Level), 1);
+    EXPECT_EQUAL(rows(0, Column::Value), 35.);
+    EXPECT_EQUAL(rows(1, Column::Index), 4);
+    EXPECT(std::isnan(rows(1, Column::Lon)));  // no function space
+    EXPECT(std::isnan(rows(2, Column::Index)));
+
+    EXPECT_EQUAL(data.getParam<atlas::Field>("gust;exc;<-5").metadata().getInt("count"), 1);
+
+    // persistent exceedance needs 2 consecutive updates
+    EXPECT_EQUAL(data.getParam<atlas::Field>("gust;exc;30/2").metadata().getInt("count"), 0);
+    values[4 * nlev + 0] = 0.f;
+    data.clearUpdated();
+    data.setUpdated({"gust"});
+    EXPECT_EQUAL(data.getParam<atlas::Field>("gust;exc;30/2").metadata().getInt("count"), 1);
+    auto persistent = atlas::array::make_view<double, 2>(data.getParam<atlas::Field>("gust;exc;30/2"));
+    EXPECT_EQUAL(persistent(0, Column::Index), 2);
+
+    // updated in place, the row of the point no longer exceeding the threshold is reset
+    EXPECT_EQUAL(data.getParam<atlas::Field>("gust;exc;>30").metadata().getInt("count"), 1);
+    EXPECT(data.getParam<atlas::Field>("gust;exc;>30").storage() == storage);
+    EXPECT_EQUAL(rows(0, Column::Index), 2);
+    EXPECT(std::isnan(rows(1, Column::Index)));
+
+    // global counts are reduced with the other reductions of the step
+    eckit::LocalConfiguration config;
+    config.set("name", "gust");
+    config.set("type", "ATLAS_FIELD");
+    config.set("threshold", ">30");
+    config.set("count", "global");
+    plume::data::ParameterDefinition global(config);
+    data.dispatchCreateParam(global.strategy(), global.config());
+    data.clearUpdated();
+    data.setUpdated({"gust"});
+    EXPECT(data.isUpdated(global.name()));
+    EXPECT_EQUAL(data.getParam<atlas::Field>(global.name()).metadata().getInt("global-count"), 1);
+    EXPECT_EQUAL(data.strategyContext()->reductions().size(), 0);
+}
+
+CASE("test model data - field histories") {
+
+    // (npoints, nlev) field, value = step
+    const atlas::idx_t npoints = 4;
+    const atlas::idx_t nlev    = 3;
+    std::vector<double> values(npoints * nlev, 0.);
+    atlas::Field t("t", values.data(), atlas::array::make_shape(npoints, nlev));
+
+    plume::data::ModelData data;
+    data.provideParam("t", &t);
+
+    auto create = [&data](const std::string& history) {
+        eckit::LocalConfiguration config;
+        config.set("name", "t");
+        config.set("type", "ATLAS_FIELD");
+        config.set("history", history);
+        plume::data::ParameterDefinition param(config);
+        data.dispatchCreateParam(param.strategy(), param.config());
+        return param.name();
+    };
+
+    EXPECT_EQUAL(create("2"), "t;hist;2");
+    EXPECT_EQUAL(create("3/float"), "t;hist;3/float");
+    EXPECT_THROWS_AS(create("0"), eckit::BadValue);
+    EXPECT_THROWS_AS(create("2/half"), eckit::BadValue);
+
+    auto ring = data.getParam<atlas::Field>("t;hist;3/float");
+    EXPECT(ring.datatype() == atlas::array::DataType::real32());
+    EXPECT_EQUAL(ring.shape(0), 3);
+    EXPECT_EQUAL(ring.shape(1), npoints);
+    EXPECT_THROWS_AS(data.getParamHistory("t", 0), eckit::BadValue);  // no snapshot yet
+
+    for (int step = 1; step <= 4; ++step) {
+        std::fill(values.begin(), values.end(), step);
+        data.clearUpdated();
+        data.setUpdated({"t"});
+    }
+    EXPECT(data.isUpdated("t;hist;2"));
+
+    // the shallowest history holding the lag
+    auto latest = data.getParamHistory("t", 0);
+    EXPECT_EQUAL(std::string(latest.datatype()), "real64");
+    EXPECT_EQUAL(latest.shape(0), npoints);
+    EXPECT_EQUAL(latest.shape(1), nlev);
+    EXPECT_EQUAL(latest.at<double>(1, 2), 4.);
+    EXPECT_EQUAL(data.getParamHistory("t", 1).at<double>(0, 0), 3.);
+
+    auto oldest = data.getParamHistory("t", 2);
+    EXPECT_EQUAL(std::string(oldest.datatype()), "real32");
+    EXPECT_EQUAL(oldest.at<float>(3, 1), 2.f);
+    EXPECT_EQUAL(data.getParamHistory("t;hist;3/float", 0).at<float>(0, 0), 4.f);
+
+    EXPECT_THROWS_AS(data.getParamHistory("t", 3), eckit::BadParameter);
+    EXPECT_THROWS_AS(data.getParamHistory("t;hist;2", 2), eckit::BadValue);
+}
+
+CASE("test model data - field sets and updates by id") {
+    atlas::FieldSet fields;
+    fields.add(atlas::Field("u", atlas::array::make_datatype<double>(), atlas::array::make_shape(10, 4)));
+    fields.add(atlas::Field("v", atlas::array::make_datatype<double>(), atlas::array::make_shape(10, 4)));
+    fields.add(atlas::Field("t", atlas::array::make_datatype<float>(), atlas::array::make_shape(10)));
+
+    // offered with their sizes
+    plume::Protocol offers;
+    offers.offerFieldSet(fields, "always", "none");
+    EXPECT(offers.isParamOffered("v"));
+    EXPECT_EQUAL(offers.offers().getParam("u").bytes(), 320);
+    EXPECT_EQUAL(offers.offers().getParam("t").bytes(), 40);
+
+    // provided in one call
+    plume::data::ModelData data;
+    data.createParam("step", 0);
+    auto ids = data.provideFieldSet(fields);
+    EXPECT_EQUAL(ids.size(), 3);
+    EXPECT_EQUAL(ids[0], plume::data::ParamId("u"));
+    EXPECT_EQUAL(ids[2], plume::data::ParamId("t"));
+    EXPECT(data.hasParameter(ids[1]));
+    EXPECT_EQUAL(data.getParam<atlas::Field>(ids[1]).name(), "v");
+
+    // names collide with the parameters of the data: nothing is provided
+    atlas::FieldSet colliding;
+    colliding.add(atlas::Field("w", atlas::array::make_datatype<float>(), atlas::array::make_shape(10)));
+    colliding.add(atlas::Field("step", atlas::array::make_datatype<float>(), atlas::array::make_shape(10)));
+    EXPECT_THROWS_AS(data.provideFieldSet(colliding), eckit::UserError);
+    EXPECT_NOT(data.hasParameter("w"));
+    EXPECT_EQUAL(data.getParam<int>("step"), 0);
+
+    // committed by ids
+    data.setUpdatedIds({ids[0], ids[2]});
+    EXPECT(data.isUpdated("u"));
+    EXPECT(!data.isUpdated("v"));
+    EXPECT(data.isUpdated("t"));
+    EXPECT(!data.isUpdated("step"));
+
+    // committed by bitmask (a step clears the previous one)
+    std::vector<std::uint64_t> mask;
+    for (auto id : {ids[1], plume::data::ParamId("step")}) {
+        mask.resize(std::max<std::size_t>(mask.size(), id.value() / 64 + 1), 0);
+        mask[id.value() / 64] |= std::uint64_t{1} << (id.value() % 64);
+    }
+    data.setUpdatedMask(mask.data(), mask.size());
+    EXPECT(!data.isUpdated("u"));
+    EXPECT(data.isUpdated("v"));
+    EXPECT(!data.isUpdated("t"));
+    EXPECT(data.isUpdated("step"));
+    EXPECT_EQUAL(data.generation("v"), 1);
+
+    // unknown ids
+    EXPECT_THROWS(data.setUpdatedIds({plume::data::ParamId("not-in-data")}));
+    std::vector<std::uint64_t> unknown(mask.size());
+    auto id = plume::data::ParamId("not-in-data").value();
+    unknown.resize(std::max<std::size_t>(unknown.size(), id / 64 + 1), 0);
+    unknown[id / 64] |= std::uint64_t{1} << (id % 64);
+    EXPECT_THROWS(data.setUpdatedMask(unknown.data(), unknown.size()));
+}
+
 }  // namespace plume::test
 
 int main(int argc, char** argv) {
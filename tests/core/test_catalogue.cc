@@ -117,6 +117,45 @@ CASE("test empty catalogue + insert") {
     EXPECT_EQUAL(catalogue3.hasParam("param-33"), true);    
     EXPECT_EQUAL(catalogue3.hasParam("not-a-param"), false);
 }
+
+CASE("test catalogue - interned parameter ids") {
+
+    // names are interned once, ids compare as integers
+    plume::data::ParamId id{"param-interned"};
+    EXPECT(id.valid());
+    EXPECT_EQUAL(id.name(), std::string("param-interned"));
+    EXPECT(plume::data::ParamId("param-interned") == id);
+    EXPECT(plume::data::ParamId::find("param-interned") == id);
+    // finding a name does not intern it
+    EXPECT_NOT(plume::data::ParamId::find("param-never-interned").valid());
+    EXPECT_NOT(plume::data::ParamId::find("param-never-interned").valid());
+
+    plume::data::ParameterCatalogue catalogue;
+    catalogue.insertParam(plume::data::ParameterDefinition{"param-interned", "INT", "always", "first"});
+    catalogue.insertParam(plume::data::ParameterDefinition{"param-interned", "INT", "always", "second"});
+    catalogue.insertParam(plume::data::ParameterDefinition{"u", "ATLAS_FIELD", "always", "wind"});
+
+    // definitions hold the id of their name, the first definition of a name is found
+    EXPECT(catalogue.hasParam(id));
+    EXPECT_EQUAL(catalogue.getParam(id).comment(), std::string("first"));
+    EXPECT(catalogue.getParam("u").id() == plume::data::ParamId("u"));
+    EXPECT_NOT(catalogue.hasParam(plume::data::ParamId{}));
+    EXPECT_THROWS_AS(catalogue.getParam(plume::data::ParamId("param-absent")), eckit::BadValue);
+
+    // derived params are interned under their derived name
+    plume::data::ParameterDefinition derived{"u", plume::data::ParameterType::ATLAS_FIELD, {{"height", "100"}}};
+    EXPECT_EQUAL(derived.id().name(), derived.name());
+
+    auto filtered = catalogue.filter({"u"});
+    EXPECT(filtered.hasParam(plume::data::ParamId("u")));
+    EXPECT_NOT(filtered.hasParam(id));
+    EXPECT_THROWS_AS(catalogue.filter({"param-never-interned-either"}), eckit::BadValue);
+
+    // copies keep the index
+    plume::data::ParameterCatalogue copy = catalogue;
+    EXPECT(copy.hasParam(id));
+    EXPECT_EQUAL(copy.getParams().size(), 3);
+}
 //----------------------------------------------------------------------------------------------------------------------
 
 }  // namespace plume::test
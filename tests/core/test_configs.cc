@@ -52,6 +52,11 @@ CASE("test_manager_configuration") {
     EXPECT_EQUAL(pluginConfig.lib(), "libsimple_plugin");
     EXPECT_EQUAL(pluginConfig.parameters().size(), 1);
 
+    // default communicator unless configured
+    EXPECT_EQUAL(managerConfig.commName(), "");
+    eckit::YAMLConfiguration withComm(std::string(R"YAML({"plugins": [], "comm": "atmosphere"})YAML"));
+    EXPECT_EQUAL(plume::ManagerConfig(withComm).commName(), "atmosphere");
+
 }
 
 CASE("test_manager_configuration_invalid") {
@@ -0,0 +1,190 @@
+/*
+ * (C) Copyright 2025- ECMWF.
+ *
+ * This software is licensed under the terms of the Apache Licence Version 2.0
+ * which can be obtained at http://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * In applying this licence, ECMWF does not waive the privileges and immunities
+ * granted to it by virtue of its status as an intergovernmental organisation nor
+ * does it submit to any jurisdiction.
+ */
+#include <cmath>
+#include <functional>
+#include <string>
+#include <vector>
+
+#include "eckit/config/LocalConfiguration.h"
+#include "eckit/testing/Test.h"
+
+#include "atlas/array.h"
+#include "atlas/field/Field.h"
+#include "atlas/functionspace/StructuredColumns.h"
+#include "atlas/grid.h"
+#include "atlas/util/Earth.h"
+
+#include "plume/data/HorizontalDerivatives.h"
+#include "plume/data/ModelData.h"
+#include "plume/data/StrategyContext.h"
+
+
+using namespace eckit::testing;
+
+namespace plume::test {
+
+namespace {
+
+const double radius  = atlas::util::Earth::radius();
+const double degrees = M_PI / 180.;
+
+// 36 longitudes x 19 latitudes (every 10 degrees, poles included), without halo
+struct SphereFields {
+    atlas::functionspace::StructuredColumns fs{atlas::Grid("L36x19")};
+
+    atlas::Field field(const std::string& name, const std::function<double(double, double)>& value) const {
+        atlas::Field f = fs.createField<double>(atlas::option::name(name));
+        auto lonlat    = atlas::array::make_view<double, 2>(fs.lonlat());
+        auto view      = atlas::array::make_view<double, 1>(f);
+        for (atlas::idx_t i = 0; i < view.shape(0); ++i) {
+            view(i) = value(lonlat(i, 0) * degrees, lonlat(i, 1) * degrees);
+        }
+        return f;
+    }
+
+    atlas::Field result() const { return fs.createField<double>(atlas::option::name("result")); }
+
+    // largest relative error against the expected values, away from the poles
+    double error(const atlas::Field& f, const std::function<double(double, double)>& expected) const {
+        auto lonlat = atlas::array::make_view<double, 2>(fs.lonlat());
+        auto view   = atlas::array::make_view<double, 1>(f);
+        double scale = 0.;
+        double error = 0.;
+        for (atlas::idx_t i = 0; i < view.shape(0); ++i) {
+            if (std::abs(lonlat(i, 1)) <= 60.) {
+                double value = expected(lonlat(i, 0) * degrees, lonlat(i, 1) * degrees);
+                scale        = std::max(scale, std::abs(value));
+                error        = std::max(error, std::abs(view(i) - value));
+            }
+        }
+        return scale > 0. ? error / scale : error;
+    }
+};
+
+}  // namespace
+
+
+CASE("test horizontal derivatives - gradients and laplacian") {
+    SphereFields sphere;
+    plume::data::HorizontalDerivatives derivatives(sphere.fs);
+
+    auto wave     = sphere.field("wave", [](double lon, double) { return std::sin(lon); });
+    auto latitude = sphere.field("latitude", [](double, double lat) { return std::sin(lat); });
+
+    // one exchange for both fields, into halo copies
+    auto halo = derivatives.exchange({wave, latitude});
+    EXPECT_EQUAL(halo.size(), 2);
+    EXPECT_EQUAL(halo[0].rank(), 2);
+
+    auto dx = sphere.result();
+    derivatives.ddx(halo[0], dx);
+    EXPECT(sphere.error(dx, [](double lon, double lat) { return std::cos(lon) / (radius * std::cos(lat)); }) < 0.01);
+
+    auto dy = sphere.result();
+    derivatives.ddy(halo[1], dy);
+    EXPECT(sphere.error(dy, [](double, double lat) { return std::cos(lat) / radius; }) < 0.01);
+
+    // the laplacian of sin(lat) is -2 sin(lat) / R^2
+    auto lap = sphere.result();
+    derivatives.laplacian(halo[1], lap);
+    EXPECT(sphere.error(lap, [](double, double lat) { return -2. * std::sin(lat) / (radius * radius); }) < 0.01);
+
+    // derivatives are of halo copies, into double precision fields
+    EXPECT_THROWS_AS(derivatives.ddx(wave, dx), eckit::BadValue);
+    atlas::Field single = sphere.fs.createField<float>(atlas::option::name("single"));
+    EXPECT_THROWS_AS(derivatives.ddx(halo[0], single), eckit::BadValue);
+
+    // halo copies allocated once, refilled and exchanged together in each step
+    auto copies = derivatives.haloCopies({wave, latitude});
+    atlas::FieldSet exchanged;
+    for (std::size_t f = 0; f < copies.size(); ++f) {
+        derivatives.copyOwned(f == 0 ? wave : latitude, copies[f]);
+        exchanged.add(copies[f]);
+    }
+    derivatives.exchange(exchanged);
+    auto again = sphere.result();
+    derivatives.ddx(copies[0], again);
+    EXPECT(sphere.error(again, [](double lon, double lat) { return std::cos(lon) / (radius * std::cos(lat)); }) < 0.01);
+    EXPECT_THROWS_AS(derivatives.copyOwned(wave, single), eckit::BadValue);
+
+    // derivatives are shared in a context, until its caches are cleared
+    plume::data::StrategyContext context;
+    auto cached = plume::data::HorizontalDerivatives::cached(context, sphere.fs);
+    EXPECT(cached == plume::data::HorizontalDerivatives::cached(context, sphere.fs));
+    context.clearCaches();
+    EXPECT_EQUAL(context.cacheSize(), 0);
+}
+
+
+CASE("test horizontal derivatives - vorticity and divergence") {
+    SphereFields sphere;
+    plume::data::HorizontalDerivatives derivatives(sphere.fs);
+
+    // solid body rotation, of vorticity 2 omega sin(lat) and no divergence
+    const double omega = 1e-5;
+    auto u = sphere.field("u", [omega](double, double lat) { return omega * radius * std::cos(lat); });
+    auto v = sphere.field("v", [](double, double) { return 0.; });
+
+    auto halo = derivatives.exchange({u, v});
+    auto vort = sphere.result();
+    derivatives.vorticity(halo[0], halo[1], vort);
+    EXPECT(sphere.error(vort, [omega](double, double lat) { return 2. * omega * std::sin(lat); }) < 0.01);
+
+    auto div = sphere.result();
+    derivatives.divergence(halo[0], halo[1], div);
+    EXPECT(sphere.error(div, [](double, double) { return 0.; }) < 1e-12);
+
+    // derived params
+    plume::data::ModelData data;
+    data.provideParam("u", &u);
+    data.provideParam("v", &v);
+
+    auto create = [&data](const std::string& name, const std::string& key, const std::string& derivative) {
+        eckit::LocalConfiguration config;
+        config.set("name", name);
+        config.set("type", "ATLAS_FIELD");
+        config.set(key, derivative);
+        plume::data::ParameterDefinition param(config);
+        data.dispatchCreateParam(param.strategy(), param.config());
+        return param.name();
+    };
+    EXPECT_EQUAL(create("u", "wind-derivative", "vorticity"), "u;der;vorticity");
+    EXPECT_EQUAL(create("u", "derivative", "ddy"), "u;der;ddy");
+    EXPECT_THROWS_AS(create("v", "wind-derivative", "vorticity"), eckit::BadValue);
+    EXPECT_THROWS_AS(create("u", "wind-derivative", "curl"), eckit::BadValue);
+    EXPECT_THROWS_AS(create("u", "derivative", "ddz"), eckit::BadValue);
+
+    // the halo copies of both derivatives are exchanged together
+    data.setUpdated({"u", "v"});
+    EXPECT(data.isUpdated("u;der;vorticity"));
+    EXPECT(data.isUpdated("u;der;ddy"));
+    auto derived = data.getParam<atlas::Field>("u;der;vorticity");
+    EXPECT(sphere.error(derived, [omega](double, double lat) { return 2. * omega * std::sin(lat); }) < 0.01);
+    EXPECT(sphere.error(data.getParam<atlas::Field>("u;der;ddy"),
+                        [omega](double, double lat) { return -omega * std::sin(lat); }) < 0.01);
+
+    // and refilled in the next step
+    auto uView = atlas::array::make_view<double, 1>(u);
+    for (atlas::idx_t i = 0; i < uView.shape(0); ++i) {
+        uView(i) *= 2.;
+    }
+    data.setUpdated({"u", "v"});
+    EXPECT(sphere.error(data.getParam<atlas::Field>("u;der;vorticity"),
+                        [omega](double, double lat) { return 4. * omega * std::sin(lat); }) < 0.01);
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+
+}  // namespace plume::test
+
+int main(int argc, char** argv) {
+    return run_tests(argc, argv);
+}
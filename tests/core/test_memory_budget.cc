@@ -0,0 +1,221 @@
+/*
+ * (C) Copyright 2025- ECMWF.
+ *
+ * This software is licensed under the terms of the Apache Licence Version 2.0
+ * which can be obtained at http://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * In applying this licence, ECMWF does not waive the privileges and immunities
+ * granted to it by virtue of its status as an intergovernmental organisation nor
+ * does it submit to any jurisdiction.
+ */
+#include <sstream>
+#include <string>
+
+#include "eckit/config/YAMLConfiguration.h"
+#include "eckit/mpi/Comm.h"
+#include "eckit/testing/Test.h"
+
+#include "atlas/field/Field.h"
+
+#include "plume/MemoryBudget.h"
+#include "plume/Negotiator.h"
+#include "plume/Protocol.h"
+#include "plume/data/ParameterCatalogue.h"
+
+
+using namespace eckit::testing;
+
+namespace plume::test {
+
+namespace {
+
+// u: 1000 points and 10 levels in double precision (80000 bytes), v: 8000 bytes, z: no size
+const std::string offered = R"YAML(
+offered:
+  - name: u
+    type: ATLAS_FIELD
+    available: always
+    comment: none
+    shape: [1000, 10]
+    datatype: real64
+  - name: v
+    type: ATLAS_FIELD
+    available: always
+    comment: none
+    bytes: 8000
+  - name: z
+    type: ATLAS_FIELD
+    available: always
+    comment: none
+)YAML";
+
+std::string required(const std::string& option, const std::string& value, const std::string& name = "u") {
+    return "required:\n  - name: " + name + "\n    type: ATLAS_FIELD\n    " + option + ": \"" + value + "\"\n";
+}
+
+PluginDecision negotiate(const Protocol& offers, const std::string& requires) {
+    Negotiator negotiator;
+    PluginDecision decision = negotiator.negotiate(offers, Protocol{eckit::YAMLConfiguration(requires)});
+    EXPECT(decision.accepted());
+    return decision;
+}
+
+}  // namespace
+
+//----------------------------------------------------------------------------------------------------------------------
+
+CASE("test memory budget - offered sizes") {
+    Protocol offers{eckit::YAMLConfiguration(offered)};
+    const auto& u = offers.offers().getParam("u");
+    EXPECT_EQUAL(u.bytes(), 80000);
+    EXPECT_EQUAL(u.levels(), 10);
+    EXPECT_EQUAL(u.elementSize(), 8);
+    EXPECT_EQUAL(offers.offers().getParam("v").bytes(), 8000);
+    EXPECT_EQUAL(offers.offers().getParam("z").bytes(), 0);
+
+    // offered from the model code
+    Protocol protocol;
+    protocol.offer<atlas::Field>("t", "always", "none", {500, 4}, "real32");
+    EXPECT_EQUAL(protocol.offers().getParam("t").bytes(), 8000);
+    EXPECT_EQUAL(protocol.offers().getParam("t").levels(), 4);
+
+    EXPECT_THROWS_AS(data::ParameterDefinition(eckit::YAMLConfiguration(
+                         std::string("{name: t, type: ATLAS_FIELD, shape: [10], datatype: complex}"))),
+                     eckit::BadParameter);
+}
+
+
+CASE("test memory budget - derived sizes") {
+    Protocol offers{eckit::YAMLConfiguration(offered)};
+    const auto& u = offers.offers().getParam("u");
+
+    auto derived = [&](const std::string& option, const std::string& value) {
+        data::ParameterDefinition param("u", data::ParameterType::ATLAS_FIELD, {{option, value}});
+        return MemoryBudget::derivedBytes(param, u);
+    };
+
+    EXPECT_EQUAL(derived("height", "100"), 8000);
+    EXPECT_EQUAL(derived("levels", "1-5"), 0);
+    EXPECT_EQUAL(derived("levels-copy", "1-5"), 40000);
+    EXPECT_EQUAL(derived("precision", "float"), 40000);
+    EXPECT_EQUAL(derived("layout", "level-major"), 80000);
+    EXPECT_EQUAL(derived("history", "3"), 240000);
+    EXPECT_EQUAL(derived("history", "3/float"), 120000);
+
+    // in double precision: a value per level, per station and level, or per point and level with the halo copy
+    EXPECT_EQUAL(derived("statistic", "mean"), 80);
+    EXPECT_EQUAL(derived("statistic", "zonal-mean"), 0);
+    EXPECT_EQUAL(derived("stations", "0/0,10/45"), 160);
+    EXPECT_EQUAL(derived("derivative", "ddx"), 160000);
+
+    Protocol protocol;
+    protocol.offer<atlas::Field>("t", "always", "none", {500, 4}, "real32");
+    data::ParameterDefinition ddx("t", data::ParameterType::ATLAS_FIELD, {{"derivative", "ddx"}});
+    EXPECT_EQUAL(MemoryBudget::derivedBytes(ddx, protocol.offers().getParam("t")), 32000);
+
+    // zonal means are reported as unknown
+    MemoryBudget budget;
+    auto zonal = budget.estimate("zonal", offers, negotiate(offers, required("statistic", "zonal-mean")), 0);
+    EXPECT_EQUAL(zonal.total(), 0);
+    EXPECT_EQUAL(zonal.unknown.size(), 1);
+}
+
+
+CASE("test memory budget - parse bytes") {
+    EXPECT_EQUAL(MemoryBudget::parseBytes("1024"), 1024);
+    EXPECT_EQUAL(MemoryBudget::parseBytes("512K"), 512 * 1024);
+    EXPECT_EQUAL(MemoryBudget::parseBytes("2M"), 2 * 1024 * 1024);
+    EXPECT_EQUAL(MemoryBudget::parseBytes("1.5GiB"), 3 * 512 * 1024 * 1024UL);
+    EXPECT_THROWS_AS(MemoryBudget::parseBytes("2X"), eckit::BadValue);
+    EXPECT_THROWS_AS(MemoryBudget::parseBytes("lots"), eckit::BadValue);
+
+    EXPECT(MemoryBudget::isValid(eckit::YAMLConfiguration(std::string("{budget: 2G, policy: reject}"))));
+    EXPECT(!MemoryBudget::isValid(eckit::YAMLConfiguration(std::string("{budget: 2G, policy: ignore}"))));
+    EXPECT(!MemoryBudget::isValid(eckit::YAMLConfiguration(std::string("{limit: 2G}"))));
+}
+
+
+CASE("test memory budget - admit plugins") {
+    Protocol offers{eckit::YAMLConfiguration(offered)};
+
+    MemoryBudget budget{eckit::YAMLConfiguration(std::string("{budget: 300000, policy: reject}"))};
+    EXPECT_EQUAL(budget.budget(), 300000);
+    EXPECT(budget.rejects());
+
+    // 240000 bytes of snapshots and a working set
+    auto historyDecision = negotiate(offers, required("history", "3"));
+    auto history         = budget.estimate("history", offers, historyDecision, 1000);
+    EXPECT_EQUAL(history.snapshots, 240000);
+    EXPECT_EQUAL(history.derived, 0);
+    EXPECT_EQUAL(history.total(), 241000);
+    EXPECT(budget.admit(history, historyDecision));
+
+    // the same history is shared, nothing added
+    auto shared = budget.estimate("shared", offers, historyDecision, 0);
+    EXPECT_EQUAL(shared.total(), 0);
+    EXPECT(budget.admit(shared, historyDecision));
+
+    // 80000 more bytes exceed the budget
+    auto copyDecision = negotiate(offers, required("layout", "level-major"));
+    auto copy         = budget.estimate("copy", offers, copyDecision, 0);
+    EXPECT_EQUAL(copy.derived, 80000);
+    EXPECT(!budget.admit(copy, copyDecision));
+    EXPECT_EQUAL(budget.total(), 241000);
+
+    // unknown sizes are reported, not counted
+    auto unknownDecision = negotiate(offers, required("levels-copy", "1-2", "z"));
+    auto unknown         = budget.estimate("unknown", offers, unknownDecision, 0);
+    EXPECT_EQUAL(unknown.total(), 0);
+    EXPECT_EQUAL(unknown.unknown.size(), 1);
+    EXPECT(budget.admit(unknown, unknownDecision));
+
+    EXPECT_EQUAL(budget.estimates().size(), 4);
+    std::ostringstream report;
+    budget.report(report);
+    EXPECT(report.str().find("copy [REJECTED]") != std::string::npos);
+    EXPECT(report.str().find("total: 235.4 KiB") != std::string::npos);
+
+    // without budget, plugins are always admitted
+    MemoryBudget unlimited;
+    EXPECT(unlimited.admit(copy, copyDecision));
+    EXPECT_EQUAL(unlimited.total(), 80000);
+}
+
+
+CASE("test memory budget - collective admission") {
+    const auto& comm         = eckit::mpi::comm();
+    const std::size_t nranks = comm.size();
+
+    // different local sizes: a level-major copy of u needs 80000 bytes per rank index
+    Protocol offers;
+    offers.offer<atlas::Field>("u", "always", "none", {static_cast<long>(1000 * (comm.rank() + 1)), 10}, "real64");
+    auto decision = negotiate(offers, required("layout", "level-major"));
+
+    auto budget = [](std::size_t bytes) {
+        return MemoryBudget{eckit::YAMLConfiguration("{budget: " + std::to_string(bytes) + ", policy: reject}")};
+    };
+
+    // the largest estimate of the ranks is the one of the last rank
+    MemoryBudget tight = budget(80000 * nranks - 1);
+    auto local         = tight.estimate("copy", offers, decision, 100 * (nranks - comm.rank()));
+    EXPECT_EQUAL(local.derived, 80000 * (comm.rank() + 1));
+    auto largest = MemoryBudget::largest(local, comm);
+    EXPECT_EQUAL(largest.derived, 80000 * nranks);
+    EXPECT_EQUAL(largest.workingSet, 100 * nranks);
+
+    // so all the ranks take the same decision, even those where the plugin would fit
+    EXPECT(!tight.admit(largest, decision));
+
+    MemoryBudget enough = budget(80100 * nranks);
+    auto estimate       = enough.estimate("copy", offers, decision, 100 * (nranks - comm.rank()));
+    EXPECT(enough.admit(MemoryBudget::largest(estimate, comm), decision));
+    EXPECT_EQUAL(enough.total(), 80100 * nranks);
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+
+}  // namespace plume::test
+
+int main(int argc, char** argv) {
+    return run_tests(argc, argv);
+}
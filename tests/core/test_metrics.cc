@@ -0,0 +1,176 @@
+/*
+ * (C) Copyright 2025- ECMWF.
+ *
+ * This software is licensed under the terms of the Apache Licence Version 2.0
+ * which can be obtained at http://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * In applying this licence, ECMWF does not waive the privileges and immunities
+ * granted to it by virtue of its status as an intergovernmental organisation nor
+ * does it submit to any jurisdiction.
+ */
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <thread>
+
+#include "eckit/config/LocalConfiguration.h"
+#include "eckit/testing/Test.h"
+
+#include "plume/Metrics.h"
+#include "plume/data/FieldProvider.h"
+
+
+using namespace eckit::testing;
+
+namespace plume::test {
+
+namespace {
+
+// metrics are a singleton, each case starts from zeroed disabled metrics
+struct CleanMetrics {
+    CleanMetrics() { reset(); }
+    ~CleanMetrics() { reset(); }
+    void reset() {
+        while (Metrics::instance().enabled()) {
+            Metrics::instance().disable();
+        }
+        Metrics::instance().reset();
+    }
+    Metrics& metrics = Metrics::instance();
+};
+
+std::string contents(const std::string& path) {
+    std::ifstream in(path);
+    std::stringstream out;
+    out << in.rdbuf();
+    return out.str();
+}
+
+}  // namespace
+
+
+CASE("test metrics - counters and histograms") {
+    CleanMetrics clean;
+
+    // nothing is timed while disabled
+    {
+        Metrics::Timer timer(Metrics::pluginRunSeconds, "idle");
+    }
+    EXPECT_EQUAL(clean.metrics.histogram(Metrics::pluginRunSeconds, "idle").count(), 0);
+
+    clean.metrics.enable();
+    {
+        Metrics::Timer timer(Metrics::pluginRunSeconds, "simple_plugin");
+    }
+    auto& run = clean.metrics.histogram(Metrics::pluginRunSeconds, "simple_plugin");
+    EXPECT_EQUAL(run.count(), 1);
+    run.observe(0.5);
+    run.observe(50.);
+    EXPECT_EQUAL(run.count(), 3);
+    EXPECT_EQUAL(run.cumulative(Metrics::buckets.size() - 1), 2);
+    EXPECT(run.sum() >= 50.5);
+
+    clean.metrics.counter(Metrics::bytesCopied).add(1000);
+    clean.metrics.addBytesCopied(24);
+    clean.metrics.counter(Metrics::stepsSkipped, "regional").add();
+    EXPECT_EQUAL(clean.metrics.counter(Metrics::bytesCopied).value(), 1024);
+
+    // enabled until all the users disable
+    clean.metrics.enable();
+    clean.metrics.disable();
+    EXPECT(clean.metrics.enabled());
+
+    // families are fixed, with their kind
+    EXPECT_THROWS_AS(clean.metrics.counter("plume_unknown_total"), eckit::BadParameter);
+    EXPECT_THROWS(clean.metrics.counter(Metrics::pluginRunSeconds));
+
+    {
+        Metrics::Timer timer(Metrics::strategyUpdateSeconds, typeid(field_provider::AreaSubset));
+    }
+
+    std::string text = Metrics::prometheus(clean.metrics.samples(), "rank", "0");
+    EXPECT(text.find("# TYPE plume_plugin_run_seconds histogram") != std::string::npos);
+    EXPECT(text.find(R"(plume_plugin_run_seconds_bucket{rank="0",plugin="simple_plugin",le="+Inf"} 3)") !=
+           std::string::npos);
+    EXPECT(text.find(R"(plume_plugin_run_seconds_count{rank="0",plugin="simple_plugin"} 3)") != std::string::npos);
+    EXPECT(text.find(R"(plume_bytes_copied_total{rank="0"} 1024)") != std::string::npos);
+    EXPECT(text.find(R"(plume_steps_skipped_total{rank="0",plugin="regional"} 1)") != std::string::npos);
+    EXPECT(text.find(R"(strategy="plume::field_provider::AreaSubset")") != std::string::npos);
+
+    std::string line = Metrics::jsonLine(clean.metrics.samples(), "0");
+    EXPECT(line.find(R"("rank":"0","samples":[)") != std::string::npos);
+    EXPECT(line.find(R"({"name":"plume_bytes_copied_total","labels":{},"value":1024})") != std::string::npos);
+    EXPECT(line.back() == '\n');
+
+    // a single rank aggregates to its own values
+    auto sums = Metrics::aggregate(clean.metrics.samples(), eckit::mpi::comm());
+    EXPECT_EQUAL(Metrics::prometheus(sums), Metrics::prometheus(clean.metrics.samples()));
+
+    clean.metrics.reset();
+    EXPECT_EQUAL(run.count(), 0);
+    EXPECT_EQUAL(clean.metrics.counter(Metrics::bytesCopied).value(), 0);
+
+    clean.metrics.disable();
+    clean.metrics.disable();
+    EXPECT(!clean.metrics.enabled());
+    clean.metrics.addBytesCopied(24);
+    EXPECT_EQUAL(clean.metrics.counter(Metrics::bytesCopied).value(), 0);
+}
+
+
+CASE("test metrics - writer") {
+    CleanMetrics clean;
+
+    eckit::LocalConfiguration config;
+    EXPECT_THROWS_AS(MetricsWriter(config, 0), eckit::BadValue);
+    config.set("directory", "plume_test_metrics");
+    config.set("formats", std::vector<std::string>{"prometheus", "xml"});
+    EXPECT_THROWS_AS(MetricsWriter(config, 0), eckit::BadValue);
+
+    config.set("formats", std::vector<std::string>{"prometheus", "json"});
+    config.set("period", 0.01);
+    config.set("aggregate", true);
+    {
+        MetricsWriter writer(config, 0);
+        EXPECT(clean.metrics.enabled());
+        clean.metrics.counter(Metrics::bytesCopied).add(64);
+
+        // the writer of another session has its own files, and keeps the metrics enabled
+        {
+            MetricsWriter other(config, 0, 1);
+            std::this_thread::sleep_for(std::chrono::milliseconds(100));
+            other.finish();
+        }
+        EXPECT(clean.metrics.enabled());
+        EXPECT(contents("plume_test_metrics/plume_1_0.prom").find("plume_bytes_copied_total") != std::string::npos);
+
+        // written periodically by the thread
+        std::this_thread::sleep_for(std::chrono::milliseconds(100));
+        EXPECT(contents("plume_test_metrics/plume_0_0.prom").find("plume_bytes_copied_total") != std::string::npos);
+
+        writer.finish();
+        EXPECT(!clean.metrics.enabled());
+    }
+
+    EXPECT(contents("plume_test_metrics/plume_0_all.prom").find(R"(plume_bytes_copied_total{rank="all"} 64)") !=
+           std::string::npos);
+    std::string lines = contents("plume_test_metrics/plume_0_0.jsonl");
+    EXPECT(lines.find(R"("value":64)") != std::string::npos);
+
+    for (const char* session : {"plume_0_", "plume_1_"}) {
+        for (const char* file : {"0.prom", "0.jsonl", "all.prom", "all.jsonl"}) {
+            std::remove((std::string("plume_test_metrics/") + session + file).c_str());
+        }
+    }
+    std::remove("plume_test_metrics");
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+
+}  // namespace plume::test
+
+int main(int argc, char** argv) {
+    return run_tests(argc, argv);
+}
@@ -240,6 +240,83 @@ CASE("test model data - observing params") {
     EXPECT_THROWS(data.updateParam("observable;dummy;00", 3));
 }
 
+CASE("test model data - lazily provided params") {
+    plume::data::ModelData data;
+
+    data.registerStrategy<plume::field_provider::DummyStrategy>();
+
+    // the model computes the value only when asked for it
+    int lazyParam = 0;
+    int calls     = 0;
+    data.provideParam("lazy", &lazyParam, [&]() { lazyParam = 10 * (++calls); });
+    int eagerParam = 1;
+    data.provideParam("eager", &eagerParam);
+    EXPECT_THROWS(data.provideParam("no-producer", &eagerParam, std::function<void()>{}));
+
+    data.setUpdated({"eager"});
+    EXPECT_EQUAL(calls, 0);
+
+    // produced on first access of each step only
+    EXPECT_EQUAL(data.getParam<int>("lazy"), 10);
+    EXPECT_EQUAL(data.getParam<int>("lazy"), 10);
+    EXPECT_EQUAL(calls, 1);
+
+    data.setUpdated({"eager"});
+    EXPECT_EQUAL(calls, 1);
+    EXPECT_EQUAL(data.getParam<int>("lazy"), 20);
+    EXPECT_EQUAL(calls, 2);
+
+    // strategies observing a lazy param trigger its production
+    eckit::LocalConfiguration paramConfig;
+    paramConfig.set("name", "lazy");
+    paramConfig.set("type", "int");
+    paramConfig.set("levtype", "dummy");
+    paramConfig.set("level", "00");
+    data.createParam<int>("dummy", paramConfig);
+
+    data.setUpdated({"lazy"});
+    EXPECT_EQUAL(calls, 3);
+    EXPECT_EQUAL(data.getParam<int>("lazy;dummy;00"), 31);
+    EXPECT_EQUAL(data.getParam<int>("lazy"), 30);
+    EXPECT_EQUAL(calls, 3);
+}
+
+CASE("test model data - access profile") {
+    plume::data::ModelData data;
+    data.createParam("read", 1);
+    data.createParam("unread", 2);
+
+    auto profile = std::make_shared<plume::data::AccessProfile>(std::vector<std::string>{"read", "unread"});
+    data.setAccessProfile(profile);
+
+    // copies record in the same profile
+    plume::data::ModelData copy = data;
+    copy.getParam<int>("read");
+    EXPECT_EQUAL(profile->reads("read"), 1);
+    EXPECT_EQUAL(profile->stepsRead("read"), 1);
+
+    profile->newStep();
+    data.getParam<int>("read");
+    data.getParam<int>("read");
+    profile->newStep();
+    profile->newStep();
+    data.getParam<int>("read");
+    EXPECT_EQUAL(profile->steps(), 3);
+    EXPECT_EQUAL(profile->reads("read"), 4);
+    EXPECT_EQUAL(profile->stepsRead("read"), 3);
+    EXPECT_EQUAL(profile->reads("unread"), 0);
+    EXPECT(profile->unusedParams() == std::vector<std::string>{"unread"});
+    EXPECT_THROWS_AS(profile->reads("not-profiled"), eckit::BadParameter);
+
+    // filtered subsets are not profiled
+    data.filter(std::set<std::string>{"unread"}).getParam<int>("unread");
+    EXPECT_EQUAL(profile->reads("unread"), 0);
+
+    data.setAccessProfile(nullptr);
+    data.getParam<int>("read");
+    EXPECT_EQUAL(profile->reads("read"), 4);
+}
+
 //----------------------------------------------------------------------------------------------------------------------
 
 }  // namespace plume::test
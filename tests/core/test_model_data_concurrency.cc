@@ -0,0 +1,183 @@
+/*
+ * (C) Copyright 2025- ECMWF.
+ *
+ * This software is licensed under the terms of the Apache Licence Version 2.0
+ * which can be obtained at http://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * In applying this licence, ECMWF does not waive the privileges and immunities
+ * granted to it by virtue of its status as an intergovernmental organisation nor
+ * does it submit to any jurisdiction.
+ */
+#include <atomic>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "eckit/config/LocalConfiguration.h"
+#include "eckit/testing/Test.h"
+
+#include "plume/PluginCore.h"
+#include "plume/data/ModelData.h"
+
+
+using namespace eckit::testing;
+
+namespace plume::test {
+
+namespace {
+
+/// Reads its share of the data, as a plugincore would do during run
+class ReaderCore : public plume::PluginCore {
+public:
+    ReaderCore() : PluginCore(eckit::LocalConfiguration()) {}
+
+    void run() override {
+        const auto& data = modelData();
+        for (int i = 0; i < 1000; ++i) {
+            if (!data.hasParameter("I") || data.getParam<int>("I") != 1 || data.getParam<double>("D") != 2.0) {
+                ++errors_;
+            }
+            data.isUpdated("D");
+            data.generation("D");
+        }
+    }
+
+    // failures are counted, test expectations are checked from the main thread
+    int errors() const { return errors_; }
+
+private:
+    int errors_ = 0;
+};
+
+}  // namespace
+
+
+CASE("test concurrent reads by plugincores") {
+
+    plume::data::ModelData data;
+    int i = 1;
+    data.provideParam("I", &i);
+    data.createParam("D", 2.0);
+    data.freeze();
+
+    std::vector<std::unique_ptr<ReaderCore>> cores;
+    for (int n = 0; n < 4; ++n) {
+        cores.push_back(std::make_unique<ReaderCore>());
+        cores.back()->grabData(data);
+    }
+
+    // the data provider toggles the updated flags while plugincores read
+    std::atomic<bool> done{false};
+    std::thread writer([&]() {
+        while (!done) {
+            data.setUpdated({"D"});
+            data.clearUpdated();
+        }
+    });
+
+    std::vector<std::thread> readers;
+    for (auto& core : cores) {
+        readers.emplace_back([&core]() { core->run(); });
+    }
+    for (auto& reader : readers) {
+        reader.join();
+    }
+    done = true;
+    writer.join();
+
+    for (const auto& core : cores) {
+        EXPECT_EQUAL(core->errors(), 0);
+    }
+    EXPECT(data.generation("D") > 0);
+    EXPECT_EQUAL(data.generation("I"), 0);
+}
+
+
+CASE("test concurrent reads after structural changes") {
+
+    // structural changes happen before the first update, from a single thread
+    plume::data::ModelData data;
+    std::vector<std::string> names;
+    for (int n = 0; n < 200; ++n) {
+        names.push_back("P" + std::to_string(n));
+        data.createParam(names.back(), n);
+    }
+
+    // the first update freezes the table, then updates and reads overlap
+    data.setUpdated({"P0"});
+    EXPECT(data.isFrozen());
+
+    std::atomic<bool> done{false};
+    std::atomic<int> errors{0};
+    std::vector<std::thread> readers;
+    for (int r = 0; r < 4; ++r) {
+        readers.emplace_back([&]() {
+            while (!done) {
+                for (int n : {0, 100, 199}) {
+                    if (!data.hasParameter(names[n]) || data.getParam<int>(names[n]) != n) {
+                        ++errors;
+                    }
+                    data.isUpdated(names[n]);
+                }
+            }
+        });
+    }
+
+    for (int step = 0; step < 200; ++step) {
+        data.setUpdated({names[step % 200], names[(step + 100) % 200]});
+    }
+    done = true;
+    for (auto& reader : readers) {
+        reader.join();
+    }
+
+    EXPECT_EQUAL(errors.load(), 0);
+    EXPECT_EQUAL(data.listAvailableParameters("INT").size(), 200);
+    EXPECT_THROWS_AS(data.createParam("P200", 200), eckit::UserError);
+}
+
+
+CASE("test frozen model data") {
+
+    plume::data::ModelData data;
+    data.createParam("I", 1);
+    EXPECT_NOT(data.isFrozen());
+
+    // copies share the table, not the frozen state
+    plume::data::ModelData copy = data;
+    data.freeze();
+    EXPECT(data.isFrozen());
+    EXPECT_NOT(copy.isFrozen());
+
+    // no structural changes once frozen
+    int j = 2;
+    EXPECT_THROWS_AS(data.createParam("J", 2), eckit::UserError);
+    EXPECT_THROWS_AS(data.provideParam("J", &j), eckit::UserError);
+    EXPECT_THROWS_AS(data = copy, eckit::UserError);
+    EXPECT_NO_THROW(copy.createParam("J", 2));
+    EXPECT_NOT(data.hasParameter("J"));
+    EXPECT(copy.hasParameter("J"));
+
+    // values and updated flags can still change
+    EXPECT_EQUAL(data.generation("I"), 0);
+    data.updateParam("I", 10);
+    data.setUpdated({"I"});
+    EXPECT(data.isUpdated("I"));
+    EXPECT_EQUAL(data.generation("I"), 1);
+    data.clearUpdated();
+    data.setUpdated({"I"});
+    EXPECT_EQUAL(data.generation("I"), 2);
+
+    // the table is shared with the copy
+    EXPECT_EQUAL(copy.getParam<int>("I"), 10);
+    EXPECT(copy.isUpdated("I"));
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+
+}  // namespace plume::test
+
+int main(int argc, char** argv) {
+    return run_tests(argc, argv);
+}
@@ -10,7 +10,9 @@
  */
 #include "eckit/testing/Test.h"
 #include "eckit/config/YAMLConfiguration.h"
+#include "plume/Protocol.h"
 #include "plume/data/ParameterCatalogue.h"
+#include "plume/data/ParameterValue.h"
 
 
 using namespace eckit::testing;
@@ -69,6 +71,56 @@ CASE("test parameter") {
     EXPECT_NO_THROW( plume::data::ParameterDefinition param(config_missing_comment) );
 }
 
+CASE("test parameter - threshold exceedance counts") {
+
+    std::string global_count = R"YAML(
+    name: u
+    type: ATLAS_FIELD
+    threshold: ">30/3"
+    count: global
+    )YAML";
+
+    std::string local_count = R"YAML(
+    name: u
+    type: ATLAS_FIELD
+    threshold: ">30"
+    )YAML";
+
+    plume::data::ParameterDefinition global(eckit::YAMLConfiguration{global_count});
+    EXPECT_EQUAL(global.strategy(), "threshold_exceedance");
+    EXPECT_EQUAL(global.name(), "u;exc;>30/3+global");
+    EXPECT_EQUAL(global.sourceParam(), "u");
+
+    plume::data::ParameterDefinition local(eckit::YAMLConfiguration{local_count});
+    EXPECT_EQUAL(local.strategy(), "local_threshold_exceedance");
+    EXPECT_EQUAL(local.name(), "u;exc;>30");
+
+    // also requested by plugins
+    Protocol protocol;
+    protocol.require<atlas::Field>("u", {{"threshold", ">30/3"}, {"count", "global"}});
+    EXPECT(protocol.isParamRequired("u;exc;>30/3+global"));
+    EXPECT_EQUAL(protocol.requires().getParam("u;exc;>30/3+global").strategy(), "threshold_exceedance");
+}
+
+CASE("test parameter - derived levtypes") {
+
+    EXPECT_EQUAL(plume::data::IParameterObserver::deriveParamName("u", "der", "dx"), "u;der;dx");
+    EXPECT_EQUAL(plume::data::IParameterObserver::deriveParamName("t", "hist", "2"), "t;hist;2");
+
+    // the error lists all the accepted levtypes
+    try {
+        plume::data::IParameterObserver::deriveParamName("u", "sfc", "0");
+        EXPECT(false);
+    }
+    catch (const eckit::BadValue& e) {
+        std::string what = e.what();
+        for (const auto& levtype : {"'hl'", "'exc'", "'pt'", "'der'", "'hist'"}) {
+            EXPECT(what.find(levtype) != std::string::npos);
+        }
+        EXPECT(what.find("dummy") == std::string::npos);
+    }
+}
+
 //----------------------------------------------------------------------------------------------------------------------
 
 }  // namespace plume::test
@@ -8,9 +8,13 @@
  * granted to it by virtue of its status as an intergovernmental organisation nor
  * does it submit to any jurisdiction.
  */
+#include <cmath>
+#include <vector>
+
 #include "eckit/testing/Test.h"
 #include "eckit/config/LocalConfiguration.h"
 #include "plume/PluginCore.h"
+#include "plume/data/ModelData.h"
 
 
 using namespace eckit::testing;
@@ -40,6 +44,148 @@ CASE("test plugin 1") {
 
 }
 
+
+// A PluginCore reacting to parameter updates
+class CallbackPluginCore : public plume::PluginCore {
+public:
+    CallbackPluginCore(const eckit::Configuration& config): plume::PluginCore(config) {};
+    constexpr static const char* type() { return "callback_plugincore"; }
+    virtual void setup() override {
+        onUpdate({"u", "v"}, [this]() { ++windUpdates; });
+        onUpdate({"step"}, [this]() { ++stepUpdates; });
+    };
+    virtual void run() override {};
+
+    int windUpdates = 0;
+    int stepUpdates = 0;
+};
+
+
+CASE("test plugincore update callbacks") {
+
+    plume::data::ModelData data;
+    data.createParam("u", 1.0);
+    data.createParam("v", 2.0);
+    data.createParam("step", 0);
+
+    CallbackPluginCore plugincore{eckit::LocalConfiguration()};
+    plugincore.grabData(data);
+    EXPECT_NOT(plugincore.hasUpdateCallbacks());
+
+    // updates before the subscription are not reported
+    data.setUpdated({"u"});
+    plugincore.setup();
+    EXPECT(plugincore.hasUpdateCallbacks());
+    EXPECT_EQUAL(plugincore.dispatchUpdates(), 0);
+
+    // a single callback is invoked when several of its parameters changed
+    data.setUpdated({"u", "v"});
+    EXPECT_EQUAL(plugincore.dispatchUpdates(), 1);
+    EXPECT_EQUAL(plugincore.windUpdates, 1);
+    EXPECT_EQUAL(plugincore.stepUpdates, 0);
+
+    // nothing changed since the last dispatch
+    EXPECT_EQUAL(plugincore.dispatchUpdates(), 0);
+
+    data.setUpdated({"step"});
+    EXPECT_EQUAL(plugincore.dispatchUpdates(), 1);
+    data.setUpdated({"v", "step"});
+    EXPECT_EQUAL(plugincore.dispatchUpdates(), 2);
+    EXPECT_EQUAL(plugincore.windUpdates, 2);
+    EXPECT_EQUAL(plugincore.stepUpdates, 2);
+}
+
+
+CASE("test plugincore update callbacks on missing parameters") {
+
+    // A PluginCore subscribing to a parameter it does not have
+    class MissingPluginCore : public plume::PluginCore {
+    public:
+        MissingPluginCore(): plume::PluginCore(eckit::LocalConfiguration()) {};
+        virtual void setup() override { onUpdate({"missing"}, []() {}); };
+        virtual void run() override {};
+    };
+
+    MissingPluginCore plugincore;
+    plugincore.grabData(plume::data::ModelData{});
+    EXPECT_THROWS_AS(plugincore.setup(), eckit::BadParameter);
+}
+
+
+// An IncrementalPluginCore writing a product of 10 bands every 4 steps
+class BandsPluginCore : public plume::IncrementalPluginCore {
+public:
+    BandsPluginCore(bool useBudget):
+        plume::IncrementalPluginCore(eckit::LocalConfiguration(), 4), useBudget_{useBudget} {};
+    virtual void setup() override {};
+
+    std::vector<std::size_t> bandsPerRun;
+    std::size_t cycles = 0;
+
+protected:
+    std::size_t startCycle() override {
+        ++cycles;
+        next_ = 0;
+        return 10;
+    };
+    std::size_t runIncremental(Budget budget) override {
+        std::size_t before = next_;
+        do {
+            ++next_;
+        } while (next_ < 10 && (budget == Budget::max() || (useBudget_ && withinBudget())));
+        bandsPerRun.push_back(next_ - before);
+        return next_;
+    };
+
+private:
+    bool useBudget_;
+    std::size_t next_ = 0;
+};
+
+
+CASE("test incremental plugincore") {
+
+    // one band per step, the last step of the period completes the cycle
+    BandsPluginCore plugincore{false};
+    for (int step = 0; step < 3; ++step) {
+        plugincore.run();
+    }
+    EXPECT_EQUAL(plugincore.cycles, 1);
+    EXPECT(std::abs(plugincore.progress() - 0.3) < 1e-12);
+    plugincore.run();
+    EXPECT_EQUAL(plugincore.progress(), 1.);
+    EXPECT(plugincore.bandsPerRun == std::vector<std::size_t>({1, 1, 1, 7}));
+
+    // next due step
+    plugincore.run();
+    EXPECT_EQUAL(plugincore.cycles, 2);
+    EXPECT(std::abs(plugincore.progress() - 0.1) < 1e-12);
+
+    // within the time slices, all the bands are processed by the end of the period
+    BandsPluginCore budgeted{true};
+    for (int step = 0; step < 4; ++step) {
+        budgeted.run();
+        EXPECT(budgeted.bandsPerRun.back() >= 1);
+    }
+    EXPECT_EQUAL(budgeted.progress(), 1.);
+    EXPECT_EQUAL(budgeted.cycles, 1);
+}
+
+
+CASE("test incremental plugincore without progress") {
+
+    class StuckPluginCore : public plume::IncrementalPluginCore {
+    public:
+        StuckPluginCore(): plume::IncrementalPluginCore(eckit::LocalConfiguration(), 2) {};
+    protected:
+        std::size_t startCycle() override { return 3; };
+        std::size_t runIncremental(Budget) override { return 0; };
+    };
+
+    StuckPluginCore plugincore;
+    EXPECT_THROWS_AS(plugincore.run(), eckit::SeriousBug);
+}
+
 //----------------------------------------------------------------------------------------------------------------------
 
 }  // namespace plume::test
@@ -0,0 +1,153 @@
+/*
+ * (C) Copyright 2025- ECMWF.
+ *
+ * This software is licensed under the terms of the Apache Licence Version 2.0
+ * which can be obtained at http://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * In applying this licence, ECMWF does not waive the privileges and immunities
+ * granted to it by virtue of its status as an intergovernmental organisation nor
+ * does it submit to any jurisdiction.
+ */
+#include <cmath>
+#include <string>
+#include <vector>
+
+#include "eckit/config/LocalConfiguration.h"
+#include "eckit/testing/Test.h"
+
+#include "atlas/array.h"
+#include "atlas/field/Field.h"
+#include "atlas/functionspace/StructuredColumns.h"
+#include "atlas/grid.h"
+
+#include "plume/data/ModelData.h"
+#include "plume/data/Reductions.h"
+
+
+using namespace eckit::testing;
+
+namespace plume::test {
+
+CASE("test reductions - statistics and histograms") {
+
+    // (npoints, nlev) field, value = 10 * point + level
+    const atlas::idx_t npoints = 5;
+    const atlas::idx_t nlev    = 3;
+    std::vector<double> values(npoints * nlev);
+    for (atlas::idx_t i = 0; i < npoints; ++i) {
+        for (atlas::idx_t k = 0; k < nlev; ++k) {
+            values[i * nlev + k] = 10 * i + k;
+        }
+    }
+    atlas::Field u("u", values.data(), atlas::array::make_shape(npoints, nlev));
+
+    std::vector<float> surface{3.f, -1.f, 4.f, 1.f};
+    atlas::Field t("t", surface.data(), atlas::array::make_shape(4));
+
+    plume::data::Reductions reductions;
+    auto sum       = reductions.add(u, plume::data::Statistic::Sum);
+    auto mean      = reductions.add(u, plume::data::Statistic::Mean);
+    auto min       = reductions.add(u, plume::data::Statistic::Min);
+    auto max       = reductions.add(u, plume::data::Statistic::Max);
+    auto tMean     = reductions.add(t, plume::data::Statistic::Mean);
+    auto histogram = reductions.addHistogram(u, 0., 50., 5);
+    EXPECT_EQUAL(reductions.size(), 6);
+
+    EXPECT_THROWS_AS(reductions.result(sum), eckit::AssertionFailed);
+    reductions.compute();
+
+    EXPECT(reductions.result(sum) == std::vector<double>({100., 105., 110.}));
+    EXPECT(reductions.result(mean) == std::vector<double>({20., 21., 22.}));
+    EXPECT(reductions.result(min) == std::vector<double>({0., 1., 2.}));
+    EXPECT(reductions.result(max) == std::vector<double>({40., 41., 42.}));
+    EXPECT(reductions.result(tMean) == std::vector<double>({1.75}));
+
+    // one point per bin, for each level
+    const auto& counts = reductions.result(histogram);
+    EXPECT_EQUAL(counts.size(), 15);
+    for (auto count : counts) {
+        EXPECT_EQUAL(count, 1.);
+    }
+
+    // statistics follow the values
+    values[0] = -5.;
+    reductions.compute();
+    EXPECT_EQUAL(reductions.result(min)[0], -5.);
+    EXPECT_EQUAL(reductions.result(histogram)[0], 0.);
+
+    // sums of values of the caller share the reductions
+    auto sums = reductions.addSum({2., 3.});
+    reductions.compute();
+    EXPECT(reductions.result(sums) == std::vector<double>({2., 3.}));
+    EXPECT_EQUAL(reductions.result(sum)[0], 95.);
+
+    EXPECT_THROWS_AS(reductions.addHistogram(u, 1., 1., 5), eckit::BadValue);
+    EXPECT_THROWS_AS(reductions.addZonalMean(u), eckit::BadValue);
+    EXPECT_THROWS_AS(plume::data::statisticFromString("median"), eckit::BadValue);
+
+    reductions.clear();
+    EXPECT_EQUAL(reductions.size(), 0);
+}
+
+
+CASE("test reductions - zonal means and derived statistics") {
+
+    // 8 longitudes x 5 latitudes, value = latitude row + longitude column / 10
+    atlas::functionspace::StructuredColumns fs(atlas::Grid("L8x5"));
+    atlas::Field t = fs.createField<double>(atlas::option::name("t"));
+    auto tView     = atlas::array::make_view<double, 1>(t);
+    auto indexI    = atlas::array::make_view<atlas::idx_t, 1>(fs.index_i());
+    auto indexJ    = atlas::array::make_view<atlas::idx_t, 1>(fs.index_j());
+    for (atlas::idx_t i = 0; i < tView.shape(0); ++i) {
+        tView(i) = (indexJ(i) - 1) + (indexI(i) - 1) / 10.;
+    }
+
+    plume::data::Reductions reductions;
+    auto zonal = reductions.addZonalMean(t);
+    reductions.compute();
+
+    // mean of the columns 0..7 is 0.35
+    const auto& rows = reductions.result(zonal);
+    EXPECT_EQUAL(rows.size(), 5);
+    for (std::size_t row = 0; row < rows.size(); ++row) {
+        EXPECT(std::abs(rows[row] - (row + 0.35)) < 1e-12);
+    }
+
+    // derived params
+    plume::data::ModelData data;
+    data.provideParam("t", &t);
+
+    auto create = [&data](const std::string& statistic) {
+        eckit::LocalConfiguration config;
+        config.set("name", "t");
+        config.set("type", "ATLAS_FIELD");
+        config.set("statistic", statistic);
+        plume::data::ParameterDefinition param(config);
+        data.dispatchCreateParam(param.strategy(), param.config());
+        return param.name();
+    };
+    EXPECT_EQUAL(create("max"), "t;stat;max");
+    EXPECT_EQUAL(create("zonal-mean"), "t;stat;zonal-mean");
+    EXPECT_THROWS_AS(create("median"), eckit::BadValue);
+
+    // both statistics are computed in the reductions of the step, cleared once done
+    data.setUpdated({"t"});
+    EXPECT_EQUAL(data.strategyContext()->reductions().size(), 0);
+    EXPECT(data.isUpdated("t;stat;max"));
+    auto max = atlas::array::make_view<double, 1>(data.getParam<atlas::Field>("t;stat;max"));
+    EXPECT_EQUAL(max.shape(0), 1);
+    EXPECT(std::abs(max(0) - 4.7) < 1e-12);
+
+    auto zonalField = data.getParam<atlas::Field>("t;stat;zonal-mean");
+    EXPECT_EQUAL(zonalField.shape(0), 5);
+    auto zonalView = atlas::array::make_view<double, 2>(zonalField);
+    EXPECT(std::abs(zonalView(2, 0) - 2.35) < 1e-12);
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+
+}  // namespace plume::test
+
+int main(int argc, char** argv) {
+    return run_tests(argc, argv);
+}
@@ -0,0 +1,351 @@
+/*
+ * (C) Copyright 2025- ECMWF.
+ *
+ * This software is licensed under the terms of the Apache Licence Version 2.0
+ * which can be obtained at http://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * In applying this licence, ECMWF does not waive the privileges and immunities
+ * granted to it by virtue of its status as an intergovernmental organisation nor
+ * does it submit to any jurisdiction.
+ */
+#include <atomic>
+#include <vector>
+
+#include "eckit/config/LocalConfiguration.h"
+#include "eckit/config/YAMLConfiguration.h"
+#include "eckit/mpi/Comm.h"
+#include "eckit/testing/Test.h"
+
+#include "atlas/array.h"
+#include "atlas/field/Field.h"
+
+#include "ManagerTestAccess.h"
+#include "plume/Manager.h"
+#include "plume/Session.h"
+#include "plume/data/ParameterCatalogue.h"
+
+
+using namespace eckit::testing;
+
+namespace plume::test {
+
+namespace {
+
+const std::string offered_ijk = R"YAML(
+    offered:
+      - name: I
+        type: INT
+        available: always
+        comment: none-1
+      - name: J
+        type: INT
+        available: always
+        comment: none-2
+      - name: K
+        type: INT
+        available: always
+        comment: none-3
+    )YAML";
+
+}  // namespace
+
+
+CASE("test_independent_sessions") {
+
+    std::string with_plugin = R"YAML(
+    plugins:
+      - lib: simple_plugins
+        name: SimplePlugin
+        core-config: {}
+    threads:
+      count: 2
+    )YAML";
+
+    std::string without_plugins = R"YAML(
+    plugins: []
+    )YAML";
+
+    plume::Session atmosphere;
+    plume::Session waves;
+    EXPECT_NOT(atmosphere.isConfigured());
+    EXPECT_NOT(waves.isConfigured());
+
+    atmosphere.configure(eckit::YAMLConfiguration(with_plugin));
+    EXPECT(atmosphere.isConfigured());
+    EXPECT_NOT(waves.isConfigured());
+
+    waves.configure(eckit::YAMLConfiguration(without_plugins));
+    EXPECT(waves.isConfigured());
+
+    // the default session (static Manager API) is not affected
+    EXPECT_NOT(plume::Manager::isConfigured());
+
+    plume::Protocol offers{eckit::YAMLConfiguration(offered_ijk)};
+    atmosphere.negotiate(offers);
+    waves.negotiate(offers);
+
+    EXPECT(atmosphere.isPluginActivated("SimplePlugin"));
+    EXPECT_NOT(waves.isPluginActivated("SimplePlugin"));
+    EXPECT_EQUAL(atmosphere.getActiveParams().size(), 3);
+    EXPECT_EQUAL(waves.getActiveParams().size(), 0);
+    EXPECT(atmosphere.isParamRequested("I"));
+    EXPECT_NOT(waves.isParamRequested("I"));
+
+    // each session runs its own plugins on its own data
+    plume::data::ModelData data;
+    data.createParam("I", 1);
+    data.createParam("J", 2);
+    data.createParam("K", 3);
+    EXPECT_NO_THROW(atmosphere.feedPlugins(data));
+    EXPECT_NO_THROW(atmosphere.run());
+    EXPECT_NO_THROW(atmosphere.teardown());
+
+    plume::data::ModelData noData;
+    EXPECT_NO_THROW(waves.feedPlugins(noData));
+    EXPECT_NO_THROW(waves.run());
+    EXPECT_NO_THROW(waves.teardown());
+
+    // thread pools are per session
+    EXPECT_EQUAL(atmosphere.threadPool().size(), 2);
+    EXPECT_EQUAL(waves.threadPool().size(), 0);
+}
+
+
+CASE("test_manager_facade") {
+    ManagerTestAccess::reset();
+
+    EXPECT(&plume::Manager::session() == &plume::Session::defaultSession());
+
+    std::string with_plugin = R"YAML(
+    plugins:
+      - lib: simple_plugins
+        name: SimplePlugin
+        core-config: {}
+    )YAML";
+
+    plume::Manager::configure(eckit::YAMLConfiguration(with_plugin));
+    EXPECT(plume::Session::defaultSession().isConfigured());
+
+    plume::Manager::negotiate(plume::Protocol{eckit::YAMLConfiguration(offered_ijk)});
+    EXPECT(plume::Session::defaultSession().isPluginActivated("SimplePlugin"));
+
+    // a new session starts from scratch
+    plume::Session other;
+    EXPECT_NOT(other.isConfigured());
+    EXPECT_NOT(other.isPluginActivated("SimplePlugin"));
+
+    ManagerTestAccess::reset();
+    EXPECT_NOT(plume::Manager::isConfigured());
+}
+
+
+CASE("test_access_profile") {
+
+    std::string with_profiling = R"YAML(
+    plugins:
+      - lib: simple_plugins
+        name: SimplePlugin
+        core-config: {}
+    profiling:
+      access: true
+    )YAML";
+
+    plume::Session session;
+    session.configure(eckit::YAMLConfiguration(with_profiling));
+    session.negotiate(plume::Protocol{eckit::YAMLConfiguration(offered_ijk)});
+
+    plume::data::ModelData data;
+    data.createParam("I", 1);
+    data.createParam("J", 2);
+    data.createParam("K", 3);
+    session.feedPlugins(data);
+    EXPECT(!session.accessProfile("unknown-plugin"));
+
+    session.run();
+    session.run();
+    session.teardown();
+
+    // SimplePlugin reads I, J, K once per run
+    auto profile = session.accessProfile("SimplePlugin");
+    EXPECT(profile);
+    EXPECT_EQUAL(profile->steps(), 2);
+    for (const auto& param : {"I", "J", "K"}) {
+        EXPECT_EQUAL(profile->reads(param), 2);
+        EXPECT_EQUAL(profile->stepsRead(param), 2);
+    }
+    EXPECT(profile->unusedParams().empty());
+
+    // invalid profiling configuration
+    plume::Session invalid;
+    EXPECT_THROWS_AS(invalid.configure(eckit::YAMLConfiguration(std::string("{plugins: [], profiling: {fields: true}}"))),
+                     eckit::BadValue);
+}
+
+
+CASE("test_sessions_on_split_communicators") {
+
+    // two components (e.g. atmosphere and waves) on halves of the ranks, and a session on all of them
+    const auto& world     = eckit::mpi::comm();
+    const int color       = static_cast<int>(world.rank() % 2);
+    const auto& component = world.split(color, "plume-test-component");
+
+    plume::Session split;
+    split.configure(eckit::YAMLConfiguration(std::string(R"({"plugins": [], "comm": "plume-test-component"})")));
+    EXPECT(&split.comm() == &component);
+    plume::Session whole;
+    whole.configure(eckit::YAMLConfiguration(std::string(R"({"plugins": []})")));
+    EXPECT(&whole.comm() == &world);
+    plume::Session unknown;
+    EXPECT_THROWS_AS(unknown.configure(eckit::YAMLConfiguration(std::string(R"({"plugins": [], "comm": "none"})"))),
+                     eckit::BadValue);
+
+    // the sum of the world ranks, over the communicator of the session fed with the data
+    auto sumOfRanks = [&](plume::Session& session) {
+        std::vector<double> rank{static_cast<double>(world.rank())};
+        atlas::Field field("r", rank.data(), atlas::array::make_shape(1));
+        plume::data::ModelData data;
+        data.provideParam("r", &field);
+
+        eckit::LocalConfiguration config;
+        config.set("name", "r");
+        config.set("type", "ATLAS_FIELD");
+        config.set("statistic", "sum");
+        plume::data::ParameterDefinition param(config);
+        data.dispatchCreateParam(param.strategy(), param.config());
+
+        session.negotiate(plume::Protocol{});
+        session.feedPlugins(data);
+        EXPECT(&data.strategyContext()->comm() == &session.comm());
+        data.setUpdated({"r"});
+
+        // the data cannot be shared with a session on another communicator
+        if (&session.comm() != &world) {
+            plume::Session other;
+            other.configure(eckit::YAMLConfiguration(std::string(R"({"plugins": []})")));
+            other.negotiate(plume::Protocol{});
+            EXPECT_THROWS_AS(other.feedPlugins(data), eckit::UserError);
+        }
+        return atlas::array::make_view<double, 1>(data.getParam<atlas::Field>(param.name()))(0);
+    };
+
+    double componentSum = 0.;
+    double worldSum     = 0.;
+    for (std::size_t r = 0; r < world.size(); ++r) {
+        componentSum += static_cast<int>(r % 2) == color ? r : 0.;
+        worldSum += r;
+    }
+    EXPECT_EQUAL(sumOfRanks(split), componentSum);
+    EXPECT_EQUAL(sumOfRanks(whole), worldSum);
+
+    eckit::mpi::deleteComm("plume-test-component");
+}
+
+CASE("test_sessions_sharing_data") {
+
+    // the same plugin, asking for the wind at a different height in each session
+    auto withHeight = [](const std::string& height) {
+        return eckit::YAMLConfiguration(std::string(R"YAML(
+        plugins:
+          - lib: simple_plugins
+            name: SimplePlugin
+            parameters:
+              -
+                - name: u
+                  type: ATLAS_FIELD
+                  height: )YAML") + height);
+    };
+
+    std::string offered = R"YAML(
+    offered:
+      - {name: u, type: ATLAS_FIELD, available: always, comment: wind}
+      - {name: z, type: ATLAS_FIELD, available: always, comment: geopotential}
+      - {name: I, type: INT, available: always, comment: none-1}
+      - {name: J, type: INT, available: always, comment: none-2}
+      - {name: K, type: INT, available: always, comment: none-3}
+    )YAML";
+    plume::Protocol offers{eckit::YAMLConfiguration(offered)};
+
+    plume::Session low;
+    plume::Session high;
+    low.configure(withHeight("50"));
+    high.configure(withHeight("100"));
+    low.negotiate(offers);
+    high.negotiate(offers);
+
+    // two levels, 1000 and 300 m2/s2 of geopotential, around both heights
+    atlas::Field u("u", atlas::array::make_datatype<float>(), atlas::array::make_shape(2, 2));
+    atlas::Field z("z", atlas::array::make_datatype<float>(), atlas::array::make_shape(2, 2));
+    auto uView = atlas::array::make_view<float, 2>(u);
+    auto zView = atlas::array::make_view<float, 2>(z);
+    for (size_t i = 0; i < 2; ++i) {
+        uView(i, 0) = 5.0f;
+        uView(i, 1) = 10.0f;
+        zView(i, 0) = 1000.0f;
+        zView(i, 1) = 300.0f;
+    }
+
+    plume::data::ModelData data;
+    data.createParam("I", 1);
+    data.createParam("J", 2);
+    data.createParam("K", 3);
+    data.provideParam("u", &u);
+    data.provideParam("z", &z);
+
+    // each session creates its own derived parameter on the shared data, which is frozen by its first update only
+    EXPECT_NO_THROW(low.feedPlugins(data));
+    EXPECT(data.hasParameter("u;hl;50"));
+    EXPECT_NOT(data.isFrozen());
+    EXPECT_NO_THROW(high.feedPlugins(data));
+    EXPECT(data.hasParameter("u;hl;100"));
+    EXPECT_NOT(data.isFrozen());
+
+    data.setUpdated({"u", "z"});
+    EXPECT(data.isFrozen());
+    EXPECT_NO_THROW(low.run());
+    EXPECT_NO_THROW(high.run());
+
+    // too late for another session to create its parameters
+    plume::Session late;
+    late.configure(withHeight("200"));
+    late.negotiate(offers);
+    EXPECT_THROWS_AS(late.feedPlugins(data), eckit::UserError);
+    EXPECT_NOT(data.hasParameter("u;hl;200"));
+
+    low.teardown();
+    high.teardown();
+}
+
+CASE("test_thread_pool") {
+
+    for (size_t nthreads : {0, 1, 4}) {
+        plume::ThreadPool pool(nthreads);
+        EXPECT_EQUAL(pool.size(), nthreads);
+
+        std::vector<int> values(1000, 0);
+        pool.parallelFor(values.size(), [&](size_t i) { values[i] = static_cast<int>(i); });
+        for (size_t i = 0; i < values.size(); ++i) {
+            EXPECT_EQUAL(values[i], static_cast<int>(i));
+        }
+
+        // nested loops run serially on workers
+        std::atomic<int> count{0};
+        pool.parallelFor(10, [&](size_t) { pool.parallelFor(10, [&](size_t) { ++count; }); });
+        EXPECT_EQUAL(count.load(), 100);
+
+        // errors are propagated to the caller
+        EXPECT_THROWS(pool.submit([]() { throw eckit::BadValue("task failed"); }).get());
+        EXPECT_THROWS(pool.parallelFor(100, [](size_t i) {
+            if (i == 57) {
+                throw eckit::BadValue("iteration failed");
+            }
+        }));
+    }
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+
+}  // namespace plume::test
+
+int main(int argc, char** argv) {
+    return run_tests(argc, argv);
+}
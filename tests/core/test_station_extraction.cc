@@ -0,0 +1,152 @@
+/*
+ * (C) Copyright 2025- ECMWF.
+ *
+ * This software is licensed under the terms of the Apache Licence Version 2.0
+ * which can be obtained at http://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * In applying this licence, ECMWF does not waive the privileges and immunities
+ * granted to it by virtue of its status as an intergovernmental organisation nor
+ * does it submit to any jurisdiction.
+ */
+#include <cmath>
+#include <string>
+#include <vector>
+
+#include "eckit/config/LocalConfiguration.h"
+#include "eckit/testing/Test.h"
+
+#include "atlas/array.h"
+#include "atlas/field/Field.h"
+#include "atlas/functionspace/StructuredColumns.h"
+#include "atlas/grid.h"
+
+#include "plume/data/ModelData.h"
+#include "plume/data/StationExtraction.h"
+#include "plume/data/StrategyContext.h"
+
+
+using namespace eckit::testing;
+
+namespace plume::test {
+
+namespace {
+
+// 8 longitudes (every 45 degrees) x 5 latitudes (90, 45, 0, -45, -90), value = lon + lat / 1000
+struct LonLatFields {
+    atlas::functionspace::StructuredColumns fs{atlas::Grid("L8x5")};
+    atlas::Field t = fs.createField<double>(atlas::option::name("t"));
+    atlas::Field u = fs.createField<float>(atlas::option::name("u") | atlas::option::levels(2));
+
+    LonLatFields() {
+        auto lonlat = atlas::array::make_view<double, 2>(fs.lonlat());
+        auto tView  = atlas::array::make_view<double, 1>(t);
+        auto uView  = atlas::array::make_view<float, 2>(u);
+        for (atlas::idx_t i = 0; i < tView.shape(0); ++i) {
+            tView(i)    = lonlat(i, 0) + lonlat(i, 1) / 1000.;
+            uView(i, 0) = 1.f;
+            uView(i, 1) = 2.f;
+        }
+    }
+};
+
+}  // namespace
+
+
+CASE("test station extraction - stations") {
+    using plume::data::parseStations;
+
+    auto stations = parseStations("-0.12/51.5,2.35/48.86");
+    EXPECT_EQUAL(stations.size(), 2);
+    EXPECT_EQUAL(stations[0].lon, -0.12);
+    EXPECT_EQUAL(stations[1].lat, 48.86);
+    EXPECT_THROWS_AS(parseStations(""), eckit::BadValue);
+    EXPECT_THROWS_AS(parseStations("1/2,3"), eckit::BadValue);
+    EXPECT_THROWS_AS(parseStations("1/95"), eckit::BadValue);
+    EXPECT_THROWS_AS(parseStations("1/x"), eckit::BadValue);
+}
+
+
+CASE("test station extraction - nearest points") {
+    LonLatFields fields;
+
+    plume::data::StationExtraction extraction(fields.fs, {{45., 45.}, {10., 1.}, {-44., -44.}});
+    EXPECT_EQUAL(extraction.size(), 3);
+    EXPECT_EQUAL(extraction.owner(0), 0);
+
+    // t, then the 2 levels of u, for each station
+    auto values = extraction.extract({fields.t, fields.u});
+    EXPECT_EQUAL(values.size(), 9);
+    EXPECT(std::abs(values[0] - 45.045) < 1e-12);
+    EXPECT_EQUAL(values[1], 1.);
+    EXPECT_EQUAL(values[2], 2.);
+    EXPECT(std::abs(values[3] - 0.) < 1e-12);
+    EXPECT(std::abs(values[6] - (315. - 0.045)) < 1e-12);
+
+    // the contribution of the single partition holds all the values
+    EXPECT(extraction.localValues({fields.t, fields.u}) == values);
+
+    // the extraction is shared in a context, until its caches are cleared
+    plume::data::StrategyContext context;
+    auto cached = plume::data::StationExtraction::cached(context, fields.fs, "45/45");
+    EXPECT(cached == plume::data::StationExtraction::cached(context, fields.fs, "45/45"));
+    EXPECT(cached != plume::data::StationExtraction::cached(context, fields.fs, "45/45",
+                                                            plume::data::StationExtraction::Method::InverseDistance));
+    EXPECT_EQUAL(context.cacheSize(), 2);
+    context.clearCaches();
+    EXPECT(cached != plume::data::StationExtraction::cached(context, fields.fs, "45/45"));
+
+    // an exact match dominates the interpolation
+    plume::data::StationExtraction interpolated(fields.fs, {{45., 45.}, {22.5, 0.}},
+                                                plume::data::StationExtraction::Method::InverseDistance);
+    auto weighted = interpolated.extract({fields.t});
+    EXPECT(std::abs(weighted[0] - 45.045) < 1e-6);
+    EXPECT(weighted[1] > 0. && weighted[1] < 45.045);
+
+    std::vector<double> other(3);
+    atlas::Field wrong("wrong", other.data(), atlas::array::make_shape(3));
+    EXPECT_THROWS_AS(extraction.extract({wrong}), eckit::BadValue);
+}
+
+
+CASE("test station extraction - derived params") {
+    LonLatFields fields;
+
+    plume::data::ModelData data;
+    data.provideParam("u", &fields.u);
+
+    eckit::LocalConfiguration config;
+    config.set("name", "u");
+    config.set("type", "ATLAS_FIELD");
+    config.set("stations", "45/45,90/0");
+    plume::data::ParameterDefinition param(config);
+    EXPECT_EQUAL(param.name(), "u;pt;45/45,90/0");
+    data.dispatchCreateParam(param.strategy(), param.config());
+
+    // a second field and station list, extracted in the same reduction
+    data.provideParam("t", &fields.t);
+    config.set("name", "t");
+    config.set("type", "ATLAS_FIELD");
+    config.set("stations", "45/45");
+    plume::data::ParameterDefinition other(config);
+    data.dispatchCreateParam(other.strategy(), other.config());
+
+    data.setUpdated({"u", "t"});
+    EXPECT(data.isUpdated("u;pt;45/45,90/0"));
+    EXPECT(data.isUpdated("t;pt;45/45"));
+    EXPECT_EQUAL(data.strategyContext()->reductions().size(), 0);
+    auto values = atlas::array::make_view<double, 2>(data.getParam<atlas::Field>("u;pt;45/45,90/0"));
+    EXPECT_EQUAL(values.shape(0), 2);
+    EXPECT_EQUAL(values.shape(1), 2);
+    EXPECT_EQUAL(values(1, 0), 1.);
+    EXPECT_EQUAL(values(1, 1), 2.);
+    auto t = atlas::array::make_view<double, 1>(data.getParam<atlas::Field>("t;pt;45/45"));
+    EXPECT(std::abs(t(0) - 45.045) < 1e-12);
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+
+}  // namespace plume::test
+
+int main(int argc, char** argv) {
+    return run_tests(argc, argv);
+}
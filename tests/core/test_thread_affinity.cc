@@ -0,0 +1,161 @@
+/*
+ * (C) Copyright 2025- ECMWF.
+ *
+ * This software is licensed under the terms of the Apache Licence Version 2.0
+ * which can be obtained at http://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * In applying this licence, ECMWF does not waive the privileges and immunities
+ * granted to it by virtue of its status as an intergovernmental organisation nor
+ * does it submit to any jurisdiction.
+ */
+#include <algorithm>
+#include <iterator>
+#include <thread>
+
+#include "eckit/config/YAMLConfiguration.h"
+#include "eckit/testing/Test.h"
+
+#include "plume/ManagerConfig.h"
+#include "plume/ThreadAffinity.h"
+
+
+using namespace eckit::testing;
+
+namespace plume::test {
+
+CASE("test_cpu_list_parsing") {
+
+    EXPECT(ThreadAffinity::parseCpuList("0-3,8") == std::vector<int>({0, 1, 2, 3, 8}));
+    EXPECT(ThreadAffinity::parseCpuList("8, 2,2-3") == std::vector<int>({2, 3, 8}));
+    EXPECT_EQUAL(ThreadAffinity::formatCpuList({0, 1, 2, 3, 8, 10, 11}), "0-3,8,10-11");
+    EXPECT_EQUAL(ThreadAffinity::formatCpuList(ThreadAffinity::parseCpuList("5")), "5");
+
+    EXPECT_THROWS(ThreadAffinity::parseCpuList(""));
+    EXPECT_THROWS(ThreadAffinity::parseCpuList("3-1"));
+    EXPECT_THROWS(ThreadAffinity::parseCpuList("a-b"));
+    EXPECT_THROWS(ThreadAffinity::parseCpuList("1-2-3"));
+}
+
+CASE("test_thread_affinity_modes") {
+
+    // default is to inherit
+    ThreadAffinity inherit;
+    EXPECT(inherit.mode() == ThreadAffinity::Mode::Inherit);
+    EXPECT(inherit.cpus().empty());
+    EXPECT(!inherit.pinCurrentThread());
+
+    // explicit cpuset (the first process core is always online)
+    int cpu = ThreadAffinity::processCpus().front();
+    eckit::YAMLConfiguration cpusetCfg("{affinity: cpuset, cpuset: \"" + std::to_string(cpu) + "\"}");
+    ThreadAffinity cpuset(cpusetCfg);
+    EXPECT(cpuset.mode() == ThreadAffinity::Mode::CpuSet);
+    EXPECT(cpuset.cpus() == std::vector<int>({cpu}));
+
+    // spare cores never overlap with the process mask, unless there are no spare cores at all
+    ThreadAffinity spare(eckit::YAMLConfiguration(std::string("{affinity: spare}")));
+    EXPECT(spare.mode() == ThreadAffinity::Mode::Spare);
+    EXPECT(!spare.cpus().empty());
+
+    auto process = ThreadAffinity::processCpus();
+    std::vector<int> overlap;
+    std::set_intersection(spare.cpus().begin(), spare.cpus().end(), process.begin(), process.end(),
+                          std::back_inserter(overlap));
+    EXPECT(overlap.empty() || spare.cpus() == process);
+
+    // resolved from the saved process mask, not from the (already pinned) calling thread
+    std::vector<int> spareFromPinned;
+    std::thread pinned([&]() {
+        spare.pinCurrentThread();
+        spareFromPinned = ThreadAffinity(eckit::YAMLConfiguration(std::string("{affinity: spare}"))).cpus();
+    });
+    pinned.join();
+    EXPECT(spareFromPinned == spare.cpus());
+
+    // only the placement keys are checked, the pool keys of the section are checked by the manager configuration
+    EXPECT(ThreadAffinity::isValid(eckit::YAMLConfiguration(std::string("{affinity: spare, count: 2}"))));
+
+    // invalid configurations
+    EXPECT(!ThreadAffinity::isValid(eckit::YAMLConfiguration(std::string("{affinity: everywhere}"))));
+    EXPECT(!ThreadAffinity::isValid(eckit::YAMLConfiguration(std::string("{affinity: cpuset}"))));
+    EXPECT(!ThreadAffinity::isValid(eckit::YAMLConfiguration(std::string("{affinity: spare, cpuset: \"0\"}"))));
+}
+
+CASE("test_first_touch") {
+
+    int cpu = ThreadAffinity::processCpus().front();
+    eckit::YAMLConfiguration cfg("{affinity: cpuset, cpuset: \"" + std::to_string(cpu) +
+                                 "\", numa-first-touch: true}");
+    ThreadAffinity affinity(cfg);
+    EXPECT(affinity.numaFirstTouch());
+
+    // initialisation runs on a different (pinned) thread and completes before returning
+    std::vector<double> buffer;
+    std::thread::id initThread;
+    affinity.firstTouch([&]() {
+        buffer.assign(1024, 1.0);
+        initThread = std::this_thread::get_id();
+    });
+    EXPECT_EQUAL(buffer.size(), 1024);
+    EXPECT(initThread != std::this_thread::get_id());
+
+    // the pinned thread is reused, also by copies of the placement
+    std::thread::id nextThread;
+    affinity.firstTouch([&]() { nextThread = std::this_thread::get_id(); });
+    EXPECT(nextThread == initThread);
+    ThreadAffinity copy = affinity;
+    copy.firstTouch([&]() { nextThread = std::this_thread::get_id(); });
+    EXPECT(nextThread == initThread);
+
+    // errors are propagated to the caller
+    EXPECT_THROWS(affinity.firstTouch([]() { throw eckit::BadValue("init failed"); }));
+
+    // without first-touch, initialisation runs inline
+    ThreadAffinity().firstTouch([&]() { initThread = std::this_thread::get_id(); });
+    EXPECT(initThread == std::this_thread::get_id());
+}
+
+CASE("test_manager_threads_configuration") {
+
+    std::string valid = R"YAML(
+    plugins: []
+    threads:
+      affinity: spare
+      numa-first-touch: true
+    )YAML";
+
+    ManagerConfig managerConfig{eckit::YAMLConfiguration(valid)};
+    EXPECT(managerConfig.threadAffinity().mode() == ThreadAffinity::Mode::Spare);
+    EXPECT(managerConfig.threadAffinity().numaFirstTouch());
+
+    // not configured => inherit
+    EXPECT(ManagerConfig().threadAffinity().mode() == ThreadAffinity::Mode::Inherit);
+
+    std::string invalid = R"YAML(
+    plugins: []
+    threads:
+      affinity: cpuset
+    )YAML";
+
+    EXPECT_THROWS(ManagerConfig{eckit::YAMLConfiguration(invalid)});
+
+    // keys of the whole section
+    std::string pool = R"YAML(
+    plugins: []
+    threads:
+      count: 2
+      parallel-callbacks: true
+    )YAML";
+    EXPECT_NO_THROW(ManagerConfig{eckit::YAMLConfiguration(pool)});
+    EXPECT_THROWS_AS(ManagerConfig{eckit::YAMLConfiguration(std::string("{plugins: [], threads: {cores: 4}}"))},
+                     eckit::BadValue);
+    EXPECT_THROWS_AS(ManagerConfig{eckit::YAMLConfiguration(std::string("{plugins: [], threads: {count: -1}}"))},
+                     eckit::BadValue);
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+
+}  // namespace plume::test
+
+int main(int argc, char** argv) {
+    return run_tests(argc, argv);
+}
@@ -0,0 +1,196 @@
+/*
+ * (C) Copyright 2025- ECMWF.
+ *
+ * This software is licensed under the terms of the Apache Licence Version 2.0
+ * which can be obtained at http://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * In applying this licence, ECMWF does not waive the privileges and immunities
+ * granted to it by virtue of its status as an intergovernmental organisation nor
+ * does it submit to any jurisdiction.
+ */
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <thread>
+
+#include "eckit/testing/Test.h"
+
+#include "plume/ThreadPool.h"
+#include "plume/Tracer.h"
+#include "plume/data/FieldProvider.h"
+
+
+using namespace eckit::testing;
+
+namespace plume::test {
+
+namespace {
+
+// a tracer current on the calling thread for the lifetime of the case
+struct CurrentTracer {
+    Tracer tracer;
+    Tracer::Install install{&tracer};
+};
+
+}  // namespace
+
+
+CASE("test tracer - disabled by default") {
+    CurrentTracer clean;
+    EXPECT(!clean.tracer.enabled());
+    {
+        Tracer::Scope scope("plugin", "run", "nothing");
+    }
+    EXPECT_EQUAL(clean.tracer.size(), 0);
+
+    // nor without a current tracer
+    {
+        Tracer::Install none(nullptr);
+        EXPECT(Tracer::current() == nullptr);
+        EXPECT_EQUAL(Tracer::currentStep(), 0);
+        Tracer::Scope scope("plugin", "run", "nothing");
+    }
+    EXPECT(Tracer::current() == &clean.tracer);
+}
+
+
+CASE("test tracer - events") {
+    CurrentTracer clean;
+    clean.tracer.enable("trace.json");
+    EXPECT(clean.tracer.enabled());
+    EXPECT_EQUAL(clean.tracer.path(), std::string("trace.json"));
+
+    clean.tracer.setStep(3);
+    {
+        Tracer::Scope scope("plugin", "run", "simple_plugin");
+    }
+    {
+        Tracer::Scope scope("strategy", typeid(field_provider::AreaSubset));
+    }
+    std::thread([tracer = &clean.tracer] {
+        Tracer::Install install(tracer);
+        Tracer::Scope scope("session", "worker");
+    }).join();
+    EXPECT_EQUAL(clean.tracer.size(), 3);
+
+    std::string events = clean.tracer.events(1);
+    EXPECT(events.find(R"("name":"run simple_plugin","cat":"plugin","ph":"X")") != std::string::npos);
+    EXPECT(events.find(R"("args":{"step":3})") != std::string::npos);
+    EXPECT(events.find(R"("pid":1)") != std::string::npos);
+    EXPECT(events.find("plume::field_provider::AreaSubset") != std::string::npos);
+    EXPECT(events.find(R"("name":"worker")") != std::string::npos);
+
+    // scopes opened while disabled are not recorded
+    clean.tracer.disable();
+    {
+        Tracer::Scope scope("plugin", "run", "simple_plugin");
+    }
+    EXPECT_EQUAL(clean.tracer.size(), 3);
+
+    clean.tracer.clear();
+    EXPECT_EQUAL(clean.tracer.size(), 0);
+}
+
+
+CASE("test tracer - tracers are independent") {
+    Tracer first;
+    Tracer second;
+    first.enable("first.json");
+    second.enable("second.json");
+    first.setStep(1);
+    second.setStep(2);
+    {
+        Tracer::Install install(&first);
+        EXPECT_EQUAL(Tracer::currentStep(), 1);
+        Tracer::Scope scope("session", "run");
+        {
+            Tracer::Install nested(&second);
+            EXPECT_EQUAL(Tracer::currentStep(), 2);
+            Tracer::Scope inner("session", "run");
+            Tracer::Scope other("session", "feed");
+        }
+        EXPECT(Tracer::current() == &first);
+    }
+    EXPECT_EQUAL(first.size(), 1);
+    EXPECT_EQUAL(second.size(), 2);
+    EXPECT(first.events().find(R"("step":1})") != std::string::npos);
+    EXPECT(first.events().find(R"("step":2})") == std::string::npos);
+    EXPECT(second.events().find(R"("step":1})") == std::string::npos);
+
+    // clearing a tracer keeps the events of the others
+    second.clear();
+    EXPECT_EQUAL(first.size(), 1);
+}
+
+
+CASE("test tracer - pool tasks") {
+    CurrentTracer clean;
+    clean.tracer.enable("trace.json");
+
+    // tasks record to the tracer of the submitting thread
+    ThreadPool pool(2);
+    pool.parallelFor(8, [](std::size_t) { Tracer::Scope scope("plugin", "updates"); });
+    EXPECT_EQUAL(clean.tracer.size(), 8);
+    pool.submit([] { Tracer::Scope scope("plugin", "updates"); }).get();
+    EXPECT_EQUAL(clean.tracer.size(), 9);
+
+    Tracer other;
+    {
+        Tracer::Install install(&other);
+        pool.submit([&other] { EXPECT(Tracer::current() == &other); }).get();
+    }
+    EXPECT_EQUAL(clean.tracer.size(), 9);
+}
+
+
+CASE("test tracer - ring buffer") {
+    CurrentTracer clean;
+    clean.tracer.enable("trace.json");
+
+    // the oldest events are overwritten, long names are truncated
+    const std::string detail(2 * Tracer::nameLength, 'x');
+    for (std::size_t i = 0; i < Tracer::capacity + 10; ++i) {
+        clean.tracer.setStep(i);
+        Tracer::Scope scope("plugin", "run", detail);
+    }
+    EXPECT_EQUAL(clean.tracer.size(), Tracer::capacity);
+
+    std::string events = clean.tracer.events();
+    EXPECT(events.find(R"("step":9})") == std::string::npos);
+    EXPECT(events.find(R"("step":10})") != std::string::npos);
+    EXPECT(events.find("run " + std::string(Tracer::nameLength - 4, 'x') + "\"") != std::string::npos);
+}
+
+
+CASE("test tracer - write") {
+    CurrentTracer clean;
+    const std::string path = "plume_test_tracer.json";
+    clean.tracer.enable(path);
+    {
+        Tracer::Scope scope("session", "negotiate");
+    }
+    clean.tracer.write();
+    EXPECT_EQUAL(clean.tracer.size(), 0);
+
+    std::ifstream in(path);
+    EXPECT(in.good());
+    std::stringstream contents;
+    contents << in.rdbuf();
+    EXPECT(contents.str().find(R"({"traceEvents":[)") == 0);
+    EXPECT(contents.str().find(R"("name":"negotiate")") != std::string::npos);
+    EXPECT(contents.str().find(R"("displayTimeUnit":"ms"})") != std::string::npos);
+    std::remove(path.c_str());
+
+    // the root fails on a path that cannot be opened
+    clean.tracer.enable("/nonexistent/directory/trace.json");
+    EXPECT_THROWS_AS(clean.tracer.write(), eckit::CantOpenFile);
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+
+}  // namespace plume::test
+
+int main(int argc, char** argv) {
+    return run_tests(argc, argv);
+}
@@ -256,6 +256,92 @@ def test_get_field_overlay_snapshot_step_matches_current(snapshot_after_step):
     assert snapshot.step == emulator.current_step()
 
 
+# ---------------------------------------------------------------------------
+# get_field_values / get_fields_values / get_lonlat (zero-copy views)
+# ---------------------------------------------------------------------------
+
+
+@needs_data
+def test_get_field_values_matches_snapshot(snapshot_after_step):
+    """The values view must hold the snapshot values and be read-only."""
+    np = pytest.importorskip("numpy")
+    emulator, key, snapshot = snapshot_after_step
+    values = emulator.get_field_values(key)
+
+    assert isinstance(values, np.ndarray)
+    assert not values.flags.writeable
+    np.testing.assert_allclose(values, snapshot.values, rtol=1e-6)
+
+
+@needs_data
+def test_get_field_values_out(snapshot_after_step):
+    """get_field_values must fill and return a preallocated *out* array."""
+    np = pytest.importorskip("numpy")
+    emulator, key, snapshot = snapshot_after_step
+    out = np.empty(len(snapshot.values), dtype=np.float64)
+
+    assert emulator.get_field_values(key, out=out) is out
+    np.testing.assert_allclose(out, snapshot.values, rtol=1e-6)
+
+
+@needs_data
+def test_get_fields_values_batch(snapshot_after_step):
+    """get_fields_values must return one view per key, or fill the rows of *out*."""
+    np = pytest.importorskip("numpy")
+    emulator, _, snapshot = snapshot_after_step
+    keys = emulator.available_field_keys()[:2]
+
+    views = emulator.get_fields_values(keys)
+    assert len(views) == len(keys)
+    for key, view in zip(keys, views):
+        np.testing.assert_array_equal(view, emulator.get_field_values(key))
+
+    out = np.empty((len(keys), len(snapshot.values)))
+    assert emulator.get_fields_values(keys, out=out) is out
+    with pytest.raises(ValueError):
+        emulator.get_fields_values(keys, out=out[:1])
+
+
+@needs_data
+def test_get_lonlat_matches_snapshot(snapshot_after_step):
+    """get_lonlat must hold the snapshot coordinates and be cached."""
+    np = pytest.importorskip("numpy")
+    emulator, _, snapshot = snapshot_after_step
+    lonlat = emulator.get_lonlat()
+
+    assert lonlat.shape == (len(snapshot.lon), 2)
+    assert not lonlat.flags.writeable
+    np.testing.assert_allclose(lonlat[:, 0], snapshot.lon)
+    np.testing.assert_allclose(lonlat[:, 1], snapshot.lat)
+    assert emulator.get_lonlat() is lonlat
+
+
+@needs_data
+def test_get_field_values_outlive_run():
+    """The views must own the memory they share, and stay valid after finalize_run."""
+    np = pytest.importorskip("numpy")
+    e = emu.NWPEmulator()
+    e.setup_data_provider(_config_opts())
+    e.run_step()
+    key = e.available_field_keys()[0]
+    values = e.get_field_values(key)
+    lonlat = e.get_lonlat()
+    expected = e.get_field_overlay_snapshot(key)
+
+    e.finalize_run()
+    del e
+    np.testing.assert_allclose(values, expected.values, rtol=1e-6)
+    np.testing.assert_allclose(lonlat[:, 0], expected.lon)
+
+
+@needs_data
+def test_get_field_values_unknown_key(snapshot_after_step):
+    """An unknown field key must raise like get_field_overlay_snapshot."""
+    emulator, _, _ = snapshot_after_step
+    with pytest.raises(RuntimeError):
+        emulator.get_field_values("unknown,ml,1")
+
+
 # ---------------------------------------------------------------------------
 # Context manager + iterator full lifecycle
 # ---------------------------------------------------------------------------
@@ -285,7 +371,7 @@ def test_context_manager_teardown_on_exception():
 
 # ---------------------------------------------------------------------------
 # Plume-enabled run (requires plugin libs on LD_LIBRARY_PATH)
-# Each test runs in a fresh subprocess so the Plume Manager singleton is
+# Each test runs in a fresh subprocess so Plume and its plugin libraries are
 # initialised independently, allowing both execute() and context-manager paths
 # to be tested with a real Plume configuration.
 # ---------------------------------------------------------------------------